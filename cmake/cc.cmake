@@ -18,6 +18,8 @@ if (WITH_CC_SERVER)
             src/cc/CCCServerConfig.cpp
             src/cc/CCServer.cpp
             src/cc/Summary.cpp
+            src/cc/AssetCache.cpp
+            src/cc/ConfigStore.cpp
             src/cc/Service.cpp
             src/cc/Httpd.cpp
             src/cc/XMRigCC.cpp
@@ -35,6 +37,16 @@ if (WITH_CC_SERVER)
                 )
     endif()
 
+    set(SOURCES_CC_BENCH
+            src/3rdparty/fmt/format.cc
+            src/base/io/log/backends/ConsoleLog.cpp
+            src/base/io/log/Log.cpp
+            src/base/io/log/Tags.cpp
+            src/base/tools/String.cpp
+            src/cc/CCBench.cpp
+            src/cc/XMRigCCBench.cpp
+            )
+
     add_definitions("/DXMRIG_FEATURE_CC_SERVER")
     add_definitions("/DCXXOPTS_NO_RTTI")
 
@@ -60,6 +72,15 @@ if (WITH_CC_CLIENT)
         add_definitions("/DXMRIG_FEATURE_CC_CLIENT_SHELL_EXECUTE")
     endif()
 
+    if (WITH_CC_HANDOFF AND CMAKE_SYSTEM_NAME STREQUAL Linux)
+        set(SOURCES_CC_CLIENT
+                "${SOURCES_CC_CLIENT}"
+                src/core/Handoff.cpp)
+        add_definitions("/DXMRIG_FEATURE_HANDOFF")
+    else()
+        remove_definitions(/DXMRIG_FEATURE_HANDOFF)
+    endif()
+
     if (WITH_TLS)
         add_definitions(/DCPPHTTPLIB_OPENSSL_SUPPORT)
     endif()
@@ -71,7 +92,8 @@ if (WITH_CC_SERVER OR WITH_CC_CLIENT)
     set(SOURCES_CC_COMMON
             src/cc/ControlCommand.cpp
             src/cc/ClientStatus.cpp
-            src/cc/GPUInfo.cpp)
+            src/cc/GPUInfo.cpp
+            src/cc/ThermalInfo.cpp)
 
     if (WITH_HTTPLIB_POLL)
         if (WIN32)
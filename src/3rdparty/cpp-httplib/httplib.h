@@ -2803,6 +2803,9 @@ inline bool can_compress_content_type(const std::string &content_type) {
 }
 
 inline EncodingType encoding_type(const Request &req, const Response &res) {
+    // already encoded by the handler (precompressed assets)
+    if (res.has_header("Content-Encoding")) { return EncodingType::None; }
+
     auto ret =
         detail::can_compress_content_type(res.get_header_value("Content-Type"));
     if (!ret) { return EncodingType::None; }
@@ -44,6 +44,10 @@
 #include "Summary.h"
 #include "version.h"
 
+#ifdef XMRIG_FEATURE_HANDOFF
+#include "core/Handoff.h"
+#endif
+
 #ifdef _WIN32
 #define popen _popen
 #define pclose _pclose
@@ -155,7 +159,7 @@ void xmrig::App::onCommandReceived(ControlCommand& command)
             break;
         case ControlCommand::UPDATE:
         case ControlCommand::RESTART:
-            close(RC_RESTART);
+            restart();
             break;
         case ControlCommand::SHUTDOWN:
             close(RC_OK);
@@ -204,6 +208,27 @@ void xmrig::App::reboot()
 #   endif
 }
 
+void xmrig::App::restart()
+{
+#   ifdef XMRIG_FEATURE_HANDOFF
+    if (m_handoff && m_handoff->isActive()) {
+        return;
+    }
+
+    // let the new binary take over the pool connection and dataset instead of a cold restart
+    if (Handoff::isAvailable()) {
+        m_handoff = std::make_shared<Handoff>(m_controller.get(), [this](int rc) { close(rc); });
+        if (m_handoff->start()) {
+            return;
+        }
+
+        m_handoff.reset();
+    }
+#   endif
+
+    close(RC_RESTART);
+}
+
 void xmrig::App::execute(const std::string& command)
 {
 #   ifdef XMRIG_FEATURE_CC_CLIENT_SHELL_EXECUTE
@@ -46,6 +46,7 @@ namespace xmrig {
 
 class Console;
 class Controller;
+class Handoff;
 class Network;
 class Process;
 class Signals;
@@ -72,6 +73,7 @@ private:
 
 #   ifdef XMRIG_FEATURE_CC_CLIENT
     void reboot();
+    void restart();
     void execute(const std::string& command);
 #   endif
 
@@ -80,6 +82,10 @@ private:
     std::shared_ptr<Console> m_console;
     std::shared_ptr<Controller> m_controller;
     std::shared_ptr<Signals> m_signals;
+
+#   ifdef XMRIG_FEATURE_HANDOFF
+    std::shared_ptr<Handoff> m_handoff;
+#   endif
 };
 
 
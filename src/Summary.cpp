@@ -23,6 +23,7 @@
 
 #include "backend/cpu/Cpu.h"
 #include "base/io/log/Log.h"
+#include "base/kernel/ResourceLimits.h"
 #include "base/net/stratum/Pool.h"
 #include "core/config/Config.h"
 #include "core/Controller.h"
@@ -58,7 +59,8 @@ static const char *coloredAsmNames[] = {
     "auto",
     GREEN_BOLD("intel"),
     GREEN_BOLD("ryzen"),
-    GREEN_BOLD("bulldozer")
+    GREEN_BOLD("bulldozer"),
+    "tune"
 };
 
 
@@ -98,13 +100,19 @@ static void print_cpu(const Config *)
                info->isVM()           ? RED_BOLD_S " VM" : ""
                );
 #   if defined(XMRIG_FEATURE_HWLOC)
+    char eCores[48] = { 0 };
+    if (info->eCores() > 0) {
+        snprintf(eCores, sizeof(eCores), BLACK_BOLD(" (") CYAN_BOLD("%zu") "E" BLACK_BOLD(")"), info->eCores());
+    }
+
     Log::print(WHITE_BOLD("   %-13s") BLACK_BOLD("L2:") WHITE_BOLD("%.1f MB") BLACK_BOLD(" L3:") WHITE_BOLD("%.1f MB")
-               CYAN_BOLD(" %zu") "C" BLACK_BOLD("/") CYAN_BOLD("%zu") "T"
+               CYAN_BOLD(" %zu") "C" "%s" BLACK_BOLD("/") CYAN_BOLD("%zu") "T"
                BLACK_BOLD(" NUMA:") CYAN_BOLD("%zu"),
                "",
                info->L2() / 1048576.0,
                info->L3() / 1048576.0,
                info->cores(),
+               eCores,
                info->threads(),
                info->nodes()
                );
@@ -164,6 +172,40 @@ static void print_memory(const Config *config)
 }
 
 
+static void print_limits(const Config *)
+{
+    if (!ResourceLimits::isLimited()) {
+        return;
+    }
+
+    constexpr double oneGiB = 1024.0 * 1024.0 * 1024.0;
+    char buf[64]            = { 0 };
+    std::string out         = WHITE_BOLD_S "v" + std::to_string(ResourceLimits::version()) + CLEAR;
+
+    if (ResourceLimits::cpus() > 0.0) {
+        snprintf(buf, sizeof(buf), " cpus " CYAN_BOLD("%.2f"), ResourceLimits::cpus());
+        out += buf;
+    }
+
+    if (!ResourceLimits::cpuset().empty()) {
+        out += std::string(" cpuset ") + CYAN_BOLD_S + ResourceLimits::cpusetToString().data() + CLEAR;
+    }
+
+    if (ResourceLimits::memory() < uv_get_total_memory()) {
+        snprintf(buf, sizeof(buf), " memory " CYAN_BOLD("%.1f") CYAN(" GB"), ResourceLimits::memory() / oneGiB);
+        out += buf;
+    }
+
+    const uint64_t hugePages = ResourceLimits::hugePages(VirtualMemory::hugePageSize());
+    if (hugePages != ResourceLimits::kUnlimited) {
+        snprintf(buf, sizeof(buf), " huge pages " CYAN_BOLD("%.1f") CYAN(" GB"), hugePages / oneGiB);
+        out += buf;
+    }
+
+    Log::print(GREEN_BOLD(" * ") WHITE_BOLD("%-13s") "%s", "CGROUP", out.c_str());
+}
+
+
 static void print_threads(const Config *config)
 {
     Log::print(GREEN_BOLD(" * ") WHITE_BOLD("%-13s") WHITE_BOLD("%s%d%%"),
@@ -212,6 +254,7 @@ void xmrig::Summary::print(Controller *controller)
     print_pages(config);
     print_cpu(config);
     print_memory(config);
+    print_limits(config);
     print_threads(config);
     config->pools().print();
 
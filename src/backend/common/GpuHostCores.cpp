@@ -0,0 +1,215 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "backend/common/GpuHostCores.h"
+#include "backend/common/Hashrate.h"
+#include "backend/common/interfaces/IBackend.h"
+#include "base/crypto/Algorithm.h"
+#include "base/io/log/Log.h"
+#include "base/io/log/Tags.h"
+#include "base/tools/String.h"
+#include "core/Miner.h"
+
+
+#include <algorithm>
+#include <map>
+
+
+namespace xmrig {
+
+
+constexpr uint64_t kWarmup = 30000;
+
+
+struct Trial
+{
+    Algorithm algorithm;
+    std::vector<size_t> candidates;
+    std::vector<double> results;
+    uint64_t start = 0;
+};
+
+
+struct Split
+{
+    size_t reserved;
+    size_t pinned;
+};
+
+
+static size_t pinned = 0;
+static std::map<Algorithm::Id, Split> tuned;
+static std::vector<int64_t> cores;
+static Trial trial;
+
+
+static bool isGpuEnabled(const Miner *miner, const Algorithm &algorithm)
+{
+    for (const IBackend *backend : miner->backends()) {
+        if (backend->type() != "cpu" && backend->isEnabled() && backend->isEnabled(algorithm)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+static double totalHashrate(const Miner *miner)
+{
+    double total = 0.0;
+
+    for (const IBackend *backend : miner->backends()) {
+        if (backend->isEnabled() && backend->hashrate()) {
+            total += backend->hashrate()->calc(Hashrate::MediumInterval);
+        }
+    }
+
+    return total;
+}
+
+
+static void prepareTrial(const Miner *miner)
+{
+    size_t cpuThreads = 0;
+    size_t gpuThreads = 0;
+
+    for (const IBackend *backend : miner->backends()) {
+        if (!backend->isEnabled() || !backend->hashrate()) {
+            continue;
+        }
+
+        (backend->type() == "cpu" ? cpuThreads : gpuThreads) += backend->hashrate()->threads();
+    }
+
+    // GPU workers are not running yet
+    if (cpuThreads < 2 || gpuThreads == 0) {
+        return;
+    }
+
+    for (size_t count : { size_t(0), std::max<size_t>(gpuThreads / 2, 1), gpuThreads }) {
+        count = std::min(count, cpuThreads - 1);
+
+        if (std::find(trial.candidates.begin(), trial.candidates.end(), count) == trial.candidates.end()) {
+            trial.candidates.emplace_back(count);
+        }
+    }
+}
+
+
+} // namespace xmrig
+
+
+int64_t xmrig::GpuHostCores::affinity(size_t index)
+{
+    return cores.empty() ? -1 : cores[index % cores.size()];
+}
+
+
+size_t xmrig::GpuHostCores::pinned()
+{
+    return xmrig::pinned;
+}
+
+
+size_t xmrig::GpuHostCores::reserve(const Miner *miner, const Algorithm &algorithm, size_t threads, int config)
+{
+    xmrig::pinned = 0;
+
+    if (config == 0 || threads < 2 || !isGpuEnabled(miner, algorithm)) {
+        return 0;
+    }
+
+    size_t count = 0;
+
+    if (config > 0) {
+        count         = std::min(static_cast<size_t>(config), threads - 1);
+        xmrig::pinned = count;
+    }
+    else if (tuned.count(algorithm.id())) {
+        count         = std::min(tuned.at(algorithm.id()).reserved, threads - 1);
+        xmrig::pinned = std::min(tuned.at(algorithm.id()).pinned, threads - 1);
+    }
+    else if (trial.algorithm == algorithm) {
+        // GPU host threads stay on the cores of the largest size for the whole trial and after it, only the CPU
+        // backend changes between sizes, so the GPU workers are restarted once, when the trial starts
+        count         = trial.candidates.empty() ? 0 : std::min(trial.candidates[trial.results.size()], threads - 1);
+        xmrig::pinned = trial.candidates.empty() ? 0 : std::min(trial.candidates.back(), threads - 1);
+    }
+    else {
+        trial           = {};
+        trial.algorithm = algorithm;
+    }
+
+    return count;
+}
+
+
+void xmrig::GpuHostCores::setCores(std::vector<int64_t> &&cores)
+{
+    xmrig::cores = std::move(cores);
+}
+
+
+bool xmrig::GpuHostCores::tick(const Miner *miner, const Algorithm &algorithm, int config, bool running, uint64_t now)
+{
+    if (config != kAuto || !trial.algorithm.isValid() || trial.algorithm != algorithm) {
+        return false;
+    }
+
+    // a paused miner says nothing about the split, measure again from scratch
+    if (!running) {
+        trial.start = now;
+
+        return false;
+    }
+
+    if (trial.candidates.empty()) {
+        prepareTrial(miner);
+        trial.start = now;
+
+        // pin the GPU host threads before the first size is measured
+        return !trial.candidates.empty() && trial.candidates.back() > 0;
+    }
+
+    if (now - trial.start < kWarmup + Hashrate::MediumInterval) {
+        return false;
+    }
+
+    char num[16] = { 0 };
+    const double hashrate = totalHashrate(miner);
+    const size_t count    = trial.candidates[trial.results.size()];
+
+    trial.results.emplace_back(hashrate);
+    trial.start = now;
+
+    LOG_INFO("%s " WHITE_BOLD("gpu host cores %zu") " combined hashrate " CYAN_BOLD("%s") " H/s", Tags::miner(), count, Hashrate::format(hashrate, num, sizeof(num)));
+
+    if (trial.results.size() < trial.candidates.size()) {
+        return true;
+    }
+
+    const size_t best = static_cast<size_t>(std::max_element(trial.results.begin(), trial.results.end()) - trial.results.begin());
+    tuned[algorithm.id()] = { trial.candidates[best], trial.candidates.back() };
+
+    LOG_INFO("%s " GREEN_BOLD("reserved %zu host cores for GPU backends") " algo " WHITE_BOLD("%s"), Tags::miner(), trial.candidates[best], algorithm.name());
+
+    trial = {};
+
+    return true;
+}
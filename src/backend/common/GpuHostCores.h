@@ -0,0 +1,60 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_GPUHOSTCORES_H
+#define XMRIG_GPUHOSTCORES_H
+
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+namespace xmrig {
+
+
+class Algorithm;
+class Miner;
+
+
+/**
+ * Host cores reserved for the GPU backends.
+ *
+ * Each OpenCL/CUDA device is fed by its own host threads and GPU results are verified on the libuv pool, with a CPU
+ * profile covering every core they compete with the CPU workers and GPU batches get delayed. When a GPU backend is
+ * active the CPU profile gives up its last threads and GPU host threads without an explicit affinity are pinned to
+ * the freed cores. In auto mode a few reservation sizes are tried and the one with the best combined hashrate wins,
+ * the GPU host threads are pinned to the cores of the largest size throughout, so only the CPU backend is restarted.
+ */
+class GpuHostCores
+{
+public:
+    constexpr static int kAuto = -1;
+
+    static int64_t affinity(size_t index);
+    static size_t pinned();
+    static size_t reserve(const Miner *miner, const Algorithm &algorithm, size_t threads, int config);
+    static void setCores(std::vector<int64_t> &&cores);
+    static bool tick(const Miner *miner, const Algorithm &algorithm, int config, bool running, uint64_t now);
+};
+
+
+} // namespace xmrig
+
+
+#endif // XMRIG_GPUHOSTCORES_H
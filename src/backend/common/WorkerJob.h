@@ -27,11 +27,13 @@
 
 
 #include <cstring>
+#include <memory>
 
 
 #include "base/net/stratum/Job.h"
 #include "base/tools/Alignment.h"
 #include "crypto/common/Nonce.h"
+#include "crypto/common/NonceShard.h"
 
 
 namespace xmrig {
@@ -41,27 +43,33 @@ template<size_t N>
 class WorkerJob
 {
 public:
-    inline const Job &currentJob() const    { return m_jobs[index()]; }
+    inline WorkerJob()
+    {
+        m_jobs[0] = m_jobs[1] = std::make_shared<const Job>();
+    }
+
+    inline const Job &currentJob() const    { return *m_jobs[index()]; }
     inline uint32_t *nonce(size_t i = 0)    { return reinterpret_cast<uint32_t*>(blob() + (i * currentJob().size()) + nonceOffset()); }
     inline uint64_t sequence() const        { return m_sequence; }
     inline uint8_t *blob()                  { return m_blobs[index()]; }
     inline uint8_t index() const            { return m_index; }
+    inline void setShard(NonceShard *shard) { m_shard = shard; }
 
 
-    inline void add(const Job &job, uint32_t reserveCount, Nonce::Backend backend)
+    inline void add(const std::shared_ptr<const Job> &job, uint32_t reserveCount, Nonce::Backend backend)
     {
         m_sequence = Nonce::sequence(backend);
 
-        if (currentJob() == job) {
+        if (!job || job == m_jobs[index()] || currentJob() == *job) {
             return;
         }
 
-        if (index() == 1 && job.index() == 0 && job == m_jobs[0]) {
+        if (index() == 1 && job->index() == 0 && *job == *m_jobs[0]) {
             m_index = 0;
             return;
         }
 
-        save(job, reserveCount, backend);
+        save(job, reserveCount);
     }
 
 
@@ -71,7 +79,7 @@ public:
 
         if ((m_rounds[index()] & (rounds - 1)) == 0) {
             for (size_t i = 0; i < N; ++i) {
-                if (!Nonce::next(index(), nonce(i), rounds * roundSize, nonceMask())) {
+                if (!nextNonce(nonce(i), rounds * roundSize)) {
                     return false;
                 }
             }
@@ -92,25 +100,30 @@ public:
 private:
     inline uint64_t nonceMask() const     { return m_nonce_mask[index()]; }
 
-    inline void save(const Job &job, uint32_t reserveCount, Nonce::Backend backend)
+    inline bool nextNonce(uint32_t *nonce, uint32_t reserveCount)
+    {
+        return m_shard ? m_shard->next(index(), nonce, reserveCount, nonceMask()) : Nonce::next(index(), nonce, reserveCount, nonceMask());
+    }
+
+    inline void save(const std::shared_ptr<const Job> &job, uint32_t reserveCount)
     {
-        m_index           = job.index();
-        const size_t size = job.size();
+        m_index           = job->index();
+        const size_t size = job->size();
         m_jobs[index()]   = job;
         m_rounds[index()] = 0;
-        m_nonce_mask[index()] = job.nonceMask();
-
-        m_jobs[index()].setBackend(backend);
+        m_nonce_mask[index()] = job->nonceMask();
 
         for (size_t i = 0; i < N; ++i) {
-            memcpy(m_blobs[index()] + (i * size), job.blob(), size);
-            Nonce::next(index(), nonce(i), reserveCount, nonceMask());
+            memcpy(m_blobs[index()] + (i * size), job->blob(), size);
+            nextNonce(nonce(i), reserveCount);
         }
     }
 
 
     alignas(8) uint8_t m_blobs[2][Job::kMaxBlobSize * N]{};
-    Job m_jobs[2];
+    std::shared_ptr<const Job> m_jobs[2];
+    std::shared_ptr<Job> m_privateJobs[2];
+    NonceShard *m_shard  = nullptr;
     uint32_t m_rounds[2] = { 0, 0 };
     uint64_t m_nonce_mask[2] = { 0, 0 };
     uint64_t m_sequence  = 0;
@@ -133,11 +146,11 @@ inline bool xmrig::WorkerJob<1>::nextRound(uint32_t rounds, uint32_t roundSize)
     uint32_t* n = nonce();
 
     if ((m_rounds[index()] & (rounds - 1)) == 0) {
-        if (!Nonce::next(index(), n, rounds * roundSize, nonceMask())) {
+        if (!nextNonce(n, rounds * roundSize)) {
             return false;
         }
         if (nonceSize() == sizeof(uint64_t)) {
-            writeUnaligned(m_jobs[index()].nonce() + 1, readUnaligned(n + 1));
+            writeUnaligned(m_privateJobs[index()]->nonce() + 1, readUnaligned(n + 1));
         }
     }
     else {
@@ -149,17 +162,24 @@ inline bool xmrig::WorkerJob<1>::nextRound(uint32_t rounds, uint32_t roundSize)
 
 
 template<>
-inline void xmrig::WorkerJob<1>::save(const Job &job, uint32_t reserveCount, Nonce::Backend backend)
+inline void xmrig::WorkerJob<1>::save(const std::shared_ptr<const Job> &job, uint32_t reserveCount)
 {
-    m_index           = job.index();
-    m_jobs[index()]   = job;
+    m_index           = job->index();
     m_rounds[index()] = 0;
-    m_nonce_mask[index()] = job.nonceMask();
+    m_nonce_mask[index()] = job->nonceMask();
 
-    m_jobs[index()].setBackend(backend);
+    // The upper half of a 64-bit nonce is tracked in the job itself, so only such jobs need a private copy.
+    if (job->nonceSize() == sizeof(uint64_t)) {
+        m_privateJobs[index()] = std::make_shared<Job>(*job);
+        m_jobs[index()]        = m_privateJobs[index()];
+    }
+    else {
+        m_privateJobs[index()].reset();
+        m_jobs[index()] = job;
+    }
 
-    memcpy(blob(), job.blob(), job.size());
-    Nonce::next(index(), nonce(), reserveCount, nonceMask());
+    memcpy(blob(), job->blob(), job->size());
+    nextNonce(nonce(), reserveCount);
 }
 
 
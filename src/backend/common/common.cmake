@@ -23,11 +23,13 @@ set(SOURCES_BACKEND_COMMON
 if (WITH_OPENCL OR WITH_CUDA)
     list(APPEND HEADERS_BACKEND_COMMON
         src/backend/common/HashrateInterpolator.h
+        src/backend/common/GpuHostCores.h
         src/backend/common/GpuWorker.h
         )
 
     list(APPEND SOURCES_BACKEND_COMMON
         src/backend/common/HashrateInterpolator.cpp
+        src/backend/common/GpuHostCores.cpp
         src/backend/common/GpuWorker.cpp
         )
 endif()
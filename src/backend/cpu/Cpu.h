@@ -33,7 +33,7 @@ public:
     static rapidjson::Value toJSON(rapidjson::Document &doc);
     static void release();
 
-    inline static Assembly::Id assembly(Assembly::Id hint) { return hint == Assembly::AUTO ? Cpu::info()->assembly() : hint; }
+    inline static Assembly::Id assembly(Assembly::Id hint) { return (hint == Assembly::AUTO || hint == Assembly::TUNE) ? Cpu::info()->assembly() : hint; }
 };
 
 
@@ -27,6 +27,9 @@
 #include "backend/common/Tags.h"
 #include "backend/common/Workers.h"
 #include "backend/cpu/Cpu.h"
+#include "backend/cpu/CpuEfficiency.h"
+#include "backend/cpu/CpuShards.h"
+#include "backend/cpu/CpuThermal.h"
 #include "base/io/log/Log.h"
 #include "base/io/log/Tags.h"
 #include "base/net/stratum/Job.h"
@@ -34,6 +37,7 @@
 #include "base/tools/String.h"
 #include "core/config/Config.h"
 #include "core/Controller.h"
+#include "core/Miner.h"
 #include "crypto/common/VirtualMemory.h"
 #include "crypto/rx/Rx.h"
 #include "crypto/rx/RxDataset.h"
@@ -49,6 +53,11 @@
 #endif
 
 
+#ifdef XMRIG_FEATURE_ASM
+#   include "crypto/cn/CnAsmTuner.h"
+#endif
+
+
 namespace xmrig {
 
 
@@ -152,6 +161,8 @@ public:
                  );
 
         status.start(threads, algo.l3());
+        efficiency.start(algo, threads.size(), threads.front().maxCpuUsage, controller->config()->cpu().isEfficiencyMode());
+        thermal.start(threads, controller->config()->cpu().thermalSysfs(), controller->config()->cpu().thermalTarget(), controller->config()->cpu().thermalHysteresis());
 
         workers.start(threads);
     }
@@ -198,7 +209,9 @@ public:
 
     Algorithm algo;
     Controller *controller;
+    CpuEfficiency efficiency;
     CpuLaunchStatus status;
+    CpuThermal thermal;
     std::vector<CpuLaunchData> threads;
     String profileName;
     Workers<CpuLaunchData> workers;
@@ -259,7 +272,14 @@ bool xmrig::CpuBackend::isEnabled(const Algorithm &algorithm) const
 
 bool xmrig::CpuBackend::tick(uint64_t ticks)
 {
-    return d_ptr->workers.tick(ticks);
+    const bool ok = d_ptr->workers.tick(ticks);
+
+    if (!d_ptr->threads.empty()) {
+        d_ptr->efficiency.tick(ticks, hashrate());
+        d_ptr->thermal.tick(ticks);
+    }
+
+    return ok;
 }
 
 
@@ -283,6 +303,12 @@ const xmrig::String &xmrig::CpuBackend::type() const
 
 void xmrig::CpuBackend::prepare(const Job &nextJob)
 {
+    // the same blob with a new target or id keeps the nonces, hashes in progress are still valid
+    const auto current = d_ptr->controller->miner()->jobSnapshot(Nonce::CPU);
+    if (!current || !current->isEqualBlob(nextJob)) {
+        d_ptr->workers.jobEarlyNotification(nextJob);
+    }
+
 #   ifdef XMRIG_ALGO_ARGON2
     const auto f = nextJob.algorithm().family();
     if ((f == Algorithm::ARGON2) || (f == Algorithm::RANDOM_X)) {
@@ -331,6 +357,30 @@ void xmrig::CpuBackend::printHashrate(bool details)
 
 void xmrig::CpuBackend::printHealth()
 {
+    if (d_ptr->threads.empty() || !d_ptr->thermal.isAvailable()) {
+        return;
+    }
+
+    const double temperature = d_ptr->thermal.temperature();
+    size_t throttled         = 0;
+    int duty                 = 100;
+
+    for (const auto &zone : d_ptr->thermal.zones()) {
+        if (zone.duty < 100) {
+            throttled += zone.threads;
+            duty = std::min(duty, zone.duty);
+        }
+    }
+
+    LOG_INFO("%s" CSI "1;%um %.0fC" CLEAR " throttled threads %s%zu/%zu" CLEAR BLACK_BOLD(" (min duty %d%%)"),
+             Tags::cpu(),
+             temperature < 70 ? 32 : (temperature > 85 ? 31 : 33),
+             temperature,
+             throttled > 0 ? YELLOW_BOLD_S : CYAN_BOLD_S,
+             throttled,
+             d_ptr->threads.size(),
+             duty
+             );
 }
 
 
@@ -387,9 +437,13 @@ void xmrig::CpuBackend::stop()
 
     const uint64_t ts = Chrono::steadyMSecs();
 
+    d_ptr->efficiency.stop();
+    d_ptr->thermal.stop();
     d_ptr->workers.stop();
     d_ptr->threads.clear();
 
+    CpuShards::release();
+
     LOG_INFO("%s" YELLOW(" stopped") BLACK_BOLD(" (%" PRIu64 " ms)"), Tags::cpu(), Chrono::steadyMSecs() - ts);
 }
 
@@ -411,7 +465,7 @@ rapidjson::Value xmrig::CpuBackend::toJSON(rapidjson::Document &doc) const
     out.AddMember("msr",        Rx::isMSR(), allocator);
 
 #   ifdef XMRIG_FEATURE_ASM
-    const Assembly assembly = Cpu::assembly(cpu.assembly());
+    const Assembly assembly = cpu.assembly() != Assembly::TUNE ? Cpu::assembly(cpu.assembly()) : (d_ptr->threads.empty() ? Assembly::TUNE : CnAsmTuner::cached(d_ptr->threads.front()));
     out.AddMember("asm", assembly.toJSON(), allocator);
 #   else
     out.AddMember("asm", false, allocator);
@@ -423,6 +477,8 @@ rapidjson::Value xmrig::CpuBackend::toJSON(rapidjson::Document &doc) const
 
     out.AddMember("hugepages", d_ptr->hugePages(2, doc), allocator);
     out.AddMember("memory",    static_cast<uint64_t>(d_ptr->algo.isValid() ? (d_ptr->ways() * d_ptr->algo.l3()) : 0), allocator);
+    out.AddMember("energy",    d_ptr->efficiency.toJSON(doc), allocator);
+    out.AddMember("thermal",   d_ptr->thermal.toJSON(doc), allocator);
 
     if (d_ptr->threads.empty() || !hashrate()) {
         return out;
@@ -446,6 +502,10 @@ rapidjson::Value xmrig::CpuBackend::toJSON(rapidjson::Document &doc) const
 
     out.AddMember("threads", threads, allocator);
 
+    if (cpu.isNumaShards()) {
+        out.AddMember("numa", CpuShards::toJSON(hashrate(), doc), allocator);
+    }
+
     return out;
 }
 
@@ -469,4 +529,24 @@ size_t xmrig::CpuBackend::ways() const
 {
   return d_ptr->status.ways();
 }
+
+double xmrig::CpuBackend::power() const
+{
+  return d_ptr->efficiency.power();
+}
+
+double xmrig::CpuBackend::hashesPerJoule() const
+{
+  return d_ptr->efficiency.hashesPerJoule();
+}
+
+double xmrig::CpuBackend::temperature() const
+{
+  return d_ptr->thermal.temperature();
+}
+
+std::vector<xmrig::CpuThermal::Zone> xmrig::CpuBackend::thermalZones() const
+{
+  return d_ptr->thermal.zones();
+}
 #endif
\ No newline at end of file
@@ -21,11 +21,13 @@
 
 
 #include "backend/common/interfaces/IBackend.h"
+#include "backend/cpu/CpuThermal.h"
 #include "crypto/common/HugePagesInfo.h"
 #include "base/tools/Object.h"
 
 
 #include <utility>
+#include <vector>
 
 
 namespace xmrig {
@@ -47,6 +49,10 @@ public:
 #   ifdef XMRIG_FEATURE_CC_CLIENT
     const HugePagesInfo& hugePages() const;
     size_t ways() const;
+    double power() const;
+    double hashesPerJoule() const;
+    double temperature() const;
+    std::vector<CpuThermal::Zone> thermalZones() const;
 #   endif
 
 
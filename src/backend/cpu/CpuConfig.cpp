@@ -22,6 +22,12 @@
 #include "backend/cpu/Cpu.h"
 #include "base/io/json/Json.h"
 
+
+#if defined(XMRIG_FEATURE_OPENCL) || defined(XMRIG_FEATURE_CUDA)
+#   include "backend/common/GpuHostCores.h"
+#endif
+
+
 #include <algorithm>
 
 
@@ -36,8 +42,16 @@ const char *CpuConfig::kMaxThreadsHint      = "max-threads-hint";
 const char *CpuConfig::kMemoryPool          = "memory-pool";
 const char *CpuConfig::kPriority            = "priority";
 const char *CpuConfig::kYield               = "yield";
+const char *CpuConfig::kScratchpadPlacement = "scratchpad-placement";
+const char *CpuConfig::kNumaShards          = "numa-shards";
+const char *CpuConfig::kEfficiencyMode      = "efficiency-mode";
 const char *CpuConfig::kForceAutoconfig     = "force-autoconfig";
 const char *CpuConfig::kMaxCpuUsage         = "max-cpu-usage";
+const char *CpuConfig::kGpuReserve          = "gpu-reserve";
+const char *CpuConfig::kECores              = "e-cores";
+const char *CpuConfig::kThermalTarget       = "thermal-target";
+const char *CpuConfig::kThermalHysteresis   = "thermal-hysteresis";
+const char *CpuConfig::kThermalSysfs        = "thermal-sysfs";
 
 #ifdef XMRIG_FEATURE_ASM
 const char *CpuConfig::kAsm                 = "asm";
@@ -53,6 +67,21 @@ extern template class Threads<CpuThreads>;
 } // namespace xmrig
 
 
+bool xmrig::CpuConfig::isECores(const char *profile, const Algorithm &algorithm) const
+{
+    if (!m_eCoreProfiles.empty()) {
+        return std::find(m_eCoreProfiles.begin(), m_eCoreProfiles.end(), profile) != m_eCoreProfiles.end();
+    }
+
+    if (m_eCores >= 0) {
+        return m_eCores > 0;
+    }
+
+    // GhostRider runs one thread per core with a helper thread, slow E-cores only hold it back
+    return algorithm.family() != Algorithm::GHOSTRIDER;
+}
+
+
 bool xmrig::CpuConfig::isHwAES() const
 {
     return (m_aes == AES_AUTO ? (Cpu::info()->hasAES() ? AES_HW : AES_SOFT) : m_aes) == AES_HW;
@@ -74,8 +103,28 @@ rapidjson::Value xmrig::CpuConfig::toJSON(rapidjson::Document &doc) const
     obj.AddMember(StringRef(kMaxCpuUsage),  maxCpuUsage() != -1  ? Value(maxCpuUsage()) : Value(kNullType), allocator);
     obj.AddMember(StringRef(kMemoryPool),   m_memoryPool < 1 ? Value(m_memoryPool < 0) : Value(m_memoryPool), allocator);
     obj.AddMember(StringRef(kYield),        m_yield, allocator);
+    obj.AddMember(StringRef(kScratchpadPlacement), m_scratchpadPlacement, allocator);
+    obj.AddMember(StringRef(kNumaShards),   m_numaShards, allocator);
+    obj.AddMember(StringRef(kEfficiencyMode), m_efficiencyMode, allocator);
     obj.AddMember(StringRef(kForceAutoconfig), m_forceAutoconfig, allocator);
     obj.AddMember(StringRef(kMaxThreadsHint), m_limit, allocator);
+    obj.AddMember(StringRef(kGpuReserve),   m_gpuReserve > 0 ? Value(m_gpuReserve) : Value(m_gpuReserve < 0), allocator);
+
+    if (!m_eCoreProfiles.empty()) {
+        Value profiles(kArrayType);
+        for (const String &profile : m_eCoreProfiles) {
+            profiles.PushBack(profile.toJSON(doc), allocator);
+        }
+
+        obj.AddMember(StringRef(kECores), profiles, allocator);
+    }
+    else {
+        obj.AddMember(StringRef(kECores), m_eCores < 0 ? Value(kNullType) : Value(m_eCores > 0), allocator);
+    }
+
+    obj.AddMember(StringRef(kThermalTarget),     m_thermalTarget > 0 ? Value(m_thermalTarget) : Value(kNullType), allocator);
+    obj.AddMember(StringRef(kThermalHysteresis), m_thermalHysteresis, allocator);
+    obj.AddMember(StringRef(kThermalSysfs),      m_thermalSysfs.toJSON(), allocator);
 
 #   ifdef XMRIG_FEATURE_ASM
     obj.AddMember(StringRef(kAsm), m_assembly.toJSON(), allocator);
@@ -110,20 +159,41 @@ std::vector<xmrig::CpuLaunchData> xmrig::CpuConfig::get(const Miner *miner, cons
         return out;
     }
 
-    const size_t count = threads.count();
+#   if defined(XMRIG_FEATURE_OPENCL) || defined(XMRIG_FEATURE_CUDA)
+    const size_t reserved = GpuHostCores::reserve(miner, algorithm, threads.count(), m_gpuReserve);
+#   else
+    constexpr size_t reserved = 0;
+#   endif
+
+    const size_t count = threads.count() - reserved;
     out.reserve(count);
 
     std::vector<int64_t> affinities;
     affinities.reserve(count);
 
-    for (const auto& thread : threads.data()) {
-        affinities.emplace_back(thread.affinity());
+    for (size_t i = 0; i < count; ++i) {
+        affinities.emplace_back(threads.data()[i].affinity());
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        out.emplace_back(miner, algorithm, *this, threads.data()[i], count, affinities);
     }
 
-    for (const auto &thread : threads.data()) {
-        out.emplace_back(miner, algorithm, *this, thread, count, affinities);
+#   if defined(XMRIG_FEATURE_OPENCL) || defined(XMRIG_FEATURE_CUDA)
+    // the GPU host threads take the last threads of the profile, unpinned ones take the last logical CPUs
+    const size_t first = threads.count() - GpuHostCores::pinned();
+    std::vector<int64_t> cores;
+    cores.reserve(threads.count() - first);
+
+    for (size_t i = first; i < threads.count(); ++i) {
+        const int64_t affinity = threads.data()[i].affinity();
+
+        cores.emplace_back(affinity >= 0 ? affinity : static_cast<int64_t>(Cpu::info()->threads() - 1 - (i - first)));
     }
 
+    GpuHostCores::setCores(std::move(cores));
+#   endif
+
     return out;
 }
 
@@ -135,6 +205,9 @@ void xmrig::CpuConfig::read(const rapidjson::Value &value)
         m_hugePagesJit = Json::getBool(value, kHugePagesJit, m_hugePagesJit);
         m_limit        = Json::getUint(value, kMaxThreadsHint, m_limit);
         m_yield        = Json::getBool(value, kYield, m_yield);
+        m_scratchpadPlacement = Json::getBool(value, kScratchpadPlacement, m_scratchpadPlacement);
+        m_numaShards   = Json::getBool(value, kNumaShards, m_numaShards);
+        m_efficiencyMode = Json::getBool(value, kEfficiencyMode, m_efficiencyMode);
         m_forceAutoconfig = Json::getBool(value, kForceAutoconfig, m_forceAutoconfig);
 
         setAesMode(Json::getValue(value, kHwAes));
@@ -142,6 +215,12 @@ void xmrig::CpuConfig::read(const rapidjson::Value &value)
         setMemoryPool(Json::getValue(value, kMemoryPool));
         setPriority(Json::getInt(value,  kPriority, -1));
         setMaxCpuUsage(Json::getInt(value,  kMaxCpuUsage, -1));
+        setGpuReserve(Json::getValue(value, kGpuReserve));
+        setECores(Json::getValue(value, kECores));
+        setThermalTarget(Json::getInt(value, kThermalTarget, 0));
+        setThermalHysteresis(Json::getInt(value, kThermalHysteresis, m_thermalHysteresis));
+
+        m_thermalSysfs = Json::getString(value, kThermalSysfs);
 
 #       ifdef XMRIG_FEATURE_ASM
         m_assembly = Json::getValue(value, kAsm);
@@ -178,14 +257,14 @@ void xmrig::CpuConfig::generate()
 
     size_t count = 0;
 
-    count += xmrig::generate<Algorithm::CN>(m_threads, m_limit);
-    count += xmrig::generate<Algorithm::CN_LITE>(m_threads, m_limit);
-    count += xmrig::generate<Algorithm::CN_HEAVY>(m_threads, m_limit);
-    count += xmrig::generate<Algorithm::CN_PICO>(m_threads, m_limit);
-    count += xmrig::generate<Algorithm::CN_FEMTO>(m_threads, m_limit);
-    count += xmrig::generate<Algorithm::RANDOM_X>(m_threads, m_limit);
-    count += xmrig::generate<Algorithm::ARGON2>(m_threads, m_limit);
-    count += xmrig::generate<Algorithm::GHOSTRIDER>(m_threads, m_limit);
+    count += xmrig::generate<Algorithm::CN>(m_threads, *this);
+    count += xmrig::generate<Algorithm::CN_LITE>(m_threads, *this);
+    count += xmrig::generate<Algorithm::CN_HEAVY>(m_threads, *this);
+    count += xmrig::generate<Algorithm::CN_PICO>(m_threads, *this);
+    count += xmrig::generate<Algorithm::CN_FEMTO>(m_threads, *this);
+    count += xmrig::generate<Algorithm::RANDOM_X>(m_threads, *this);
+    count += xmrig::generate<Algorithm::ARGON2>(m_threads, *this);
+    count += xmrig::generate<Algorithm::GHOSTRIDER>(m_threads, *this);
 
     m_shouldSave |= count > 0;
 }
@@ -202,6 +281,42 @@ void xmrig::CpuConfig::setAesMode(const rapidjson::Value &value)
 }
 
 
+void xmrig::CpuConfig::setECores(const rapidjson::Value &value)
+{
+    m_eCoreProfiles.clear();
+
+    if (value.IsBool()) {
+        m_eCores = value.GetBool() ? 1 : 0;
+    }
+    else if (value.IsArray()) {
+        m_eCores = 0;
+
+        for (const rapidjson::Value &profile : value.GetArray()) {
+            if (profile.IsString()) {
+                m_eCoreProfiles.emplace_back(profile.GetString());
+            }
+        }
+    }
+    else {
+        m_eCores = -1;
+    }
+}
+
+
+void xmrig::CpuConfig::setGpuReserve(const rapidjson::Value &value)
+{
+    if (value.IsBool()) {
+        m_gpuReserve = value.GetBool() ? -1 : 0;
+    }
+    else if (value.IsUint()) {
+        m_gpuReserve = static_cast<int>(value.GetUint());
+    }
+    else {
+        m_gpuReserve = -1;
+    }
+}
+
+
 void xmrig::CpuConfig::setHugePages(const rapidjson::Value &value)
 {
     if (value.IsBool()) {
@@ -48,7 +48,15 @@ public:
     static const char *kPriority;
     static const char *kMaxCpuUsage;
     static const char *kYield;
+    static const char *kScratchpadPlacement;
+    static const char *kNumaShards;
+    static const char *kEfficiencyMode;
     static const char *kForceAutoconfig;
+    static const char *kGpuReserve;
+    static const char *kECores;
+    static const char *kThermalTarget;
+    static const char *kThermalHysteresis;
+    static const char *kThermalSysfs;
 
 #   ifdef XMRIG_FEATURE_ASM
     static const char *kAsm;
@@ -60,6 +68,7 @@ public:
 
     CpuConfig() = default;
 
+    bool isECores(const char *profile, const Algorithm &algorithm) const;
     bool isHwAES() const;
     rapidjson::Value toJSON(rapidjson::Document &doc) const;
     size_t memPoolSize() const;
@@ -71,13 +80,20 @@ public:
     inline bool isHugePagesJit() const                  { return m_hugePagesJit; }
     inline bool isShouldSave() const                    { return m_shouldSave; }
     inline bool isYield() const                         { return m_yield; }
+    inline bool isScratchpadPlacement() const           { return m_scratchpadPlacement; }
+    inline bool isNumaShards() const                    { return m_numaShards; }
+    inline bool isEfficiencyMode() const                { return m_efficiencyMode; }
     inline bool isForceAutoconfig() const               { return m_forceAutoconfig; }
     inline const Assembly &assembly() const             { return m_assembly; }
     inline const String &argon2Impl() const             { return m_argon2Impl; }
+    inline const String &thermalSysfs() const           { return m_thermalSysfs; }
     inline const Threads<CpuThreads> &threads() const   { return m_threads; }
     inline int priority() const                         { return m_priority; }
     inline size_t hugePageSize() const                  { return m_hugePageSize * 1024U; }
     inline int maxCpuUsage() const                      { return m_maxCpuUsage; }
+    inline int gpuReserve() const                       { return m_gpuReserve; }
+    inline int thermalHysteresis() const                { return m_thermalHysteresis; }
+    inline int thermalTarget() const                    { return m_thermalTarget; }
     inline uint32_t limit() const                       { return m_limit; }
 
 private:
@@ -86,11 +102,15 @@ private:
 
     void generate();
     void setAesMode(const rapidjson::Value &value);
+    void setECores(const rapidjson::Value &value);
+    void setGpuReserve(const rapidjson::Value &value);
     void setHugePages(const rapidjson::Value &value);
     void setMemoryPool(const rapidjson::Value &value);
 
     inline void setPriority(int priority)   { m_priority = (priority >= -1 && priority <= 5) ? priority : -1; }
     inline void setMaxCpuUsage(int maxCpuUsage) { m_maxCpuUsage = (maxCpuUsage > 0 && maxCpuUsage < 100) ? maxCpuUsage : -1; }
+    inline void setThermalHysteresis(int value) { m_thermalHysteresis = (value >= 1 && value <= 20) ? value : 3; }
+    inline void setThermalTarget(int value)     { m_thermalTarget = (value >= 40 && value <= 110) ? value : 0; }
 
     AesMode m_aes           = AES_AUTO;
     Assembly m_assembly;
@@ -98,14 +118,23 @@ private:
     bool m_hugePagesJit     = false;
     bool m_shouldSave       = false;
     bool m_yield            = true;
+    bool m_scratchpadPlacement = false;
+    bool m_numaShards       = false;
+    bool m_efficiencyMode   = false;
     bool m_forceAutoconfig  = false;
     int m_memoryPool        = 0;
     int m_priority          = -1;
     int m_maxCpuUsage       = -1;
+    int m_gpuReserve        = -1;
+    int m_eCores            = -1;
+    int m_thermalHysteresis = 3;
+    int m_thermalTarget     = 0;
     size_t m_hugePageSize   = kDefaultHugePageSizeKb;
     String m_argon2Impl;
+    String m_thermalSysfs;
     Threads<CpuThreads> m_threads;
     uint32_t m_limit        = 100;
+    std::vector<String> m_eCoreProfiles;
 };
 
 
@@ -22,34 +22,83 @@
 
 #include "backend/common/Threads.h"
 #include "backend/cpu/Cpu.h"
+#include "backend/cpu/CpuConfig.h"
 #include "backend/cpu/CpuThreads.h"
+#include "base/kernel/ResourceLimits.h"
+
+
+#include <algorithm>
 
 
 namespace xmrig {
 
 
-static inline size_t generate(const char *key, Threads<CpuThreads> &threads, const Algorithm &algorithm, uint32_t limit)
+// Keeps autoconfigured threads inside the cgroup envelope: threads pinned outside of the allowed cpuset are dropped,
+// unpinned ones are spread over it and the count is capped by the CPU quota.
+static inline CpuThreads limitThreads(const CpuThreads &threads)
+{
+    const auto &cpuset = ResourceLimits::cpuset();
+    const size_t count = ResourceLimits::threads(threads.count());
+
+    if (threads.isEmpty() || (cpuset.empty() && count == threads.count())) {
+        return threads;
+    }
+
+    CpuThreads out;
+    out.reserve(count);
+
+    for (const CpuThread &thread : threads.data()) {
+        if (out.count() == count) {
+            break;
+        }
+
+        if (cpuset.empty()) {
+            out.add(thread);
+        }
+        else if (thread.affinity() < 0) {
+            out.add(cpuset[out.count() % cpuset.size()], thread.intensity());
+        }
+        else if (std::find(cpuset.begin(), cpuset.end(), thread.affinity()) != cpuset.end()) {
+            out.add(thread);
+        }
+    }
+
+    if (out.isEmpty()) {
+        out.add(cpuset.empty() ? -1 : cpuset.front(), threads.data().front().intensity());
+    }
+
+    return out;
+}
+
+
+static inline CpuThreads autoThreads(const char *key, const Algorithm &algorithm, const CpuConfig &config)
+{
+    return limitThreads(Cpu::info()->threads(algorithm, config.limit(), config.isECores(key, algorithm)));
+}
+
+
+static inline size_t generate(const char *key, Threads<CpuThreads> &threads, const Algorithm &algorithm, const CpuConfig &config)
 {
     if (threads.isExist(algorithm) || threads.has(key)) {
         return 0;
     }
 
-    return threads.move(key, Cpu::info()->threads(algorithm, limit));
+    return threads.move(key, autoThreads(key, algorithm, config));
 }
 
 
 template<Algorithm::Family FAMILY>
-static inline size_t generate(Threads<CpuThreads> &, uint32_t) { return 0; }
+static inline size_t generate(Threads<CpuThreads> &, const CpuConfig &) { return 0; }
 
 
 template<>
-size_t inline generate<Algorithm::CN>(Threads<CpuThreads> &threads, uint32_t limit)
+size_t inline generate<Algorithm::CN>(Threads<CpuThreads> &threads, const CpuConfig &config)
 {
     size_t count = 0;
 
-    count += generate(Algorithm::kCN, threads, Algorithm::CN_1, limit);
+    count += generate(Algorithm::kCN, threads, Algorithm::CN_1, config);
 #   ifdef XMRIG_ALGO_CN_GPU
-    count += generate(Algorithm::kCN_GPU, threads, Algorithm::CN_GPU, limit);
+    count += generate(Algorithm::kCN_GPU, threads, Algorithm::CN_GPU, config);
 #   endif
 
     if (!threads.isExist(Algorithm::CN_0)) {
@@ -63,11 +112,11 @@ size_t inline generate<Algorithm::CN>(Threads<CpuThreads> &threads, uint32_t lim
 
 #ifdef XMRIG_ALGO_CN_LITE
 template<>
-size_t inline generate<Algorithm::CN_LITE>(Threads<CpuThreads> &threads, uint32_t limit)
+size_t inline generate<Algorithm::CN_LITE>(Threads<CpuThreads> &threads, const CpuConfig &config)
 {
     size_t count = 0;
 
-    count += generate(Algorithm::kCN_LITE, threads, Algorithm::CN_LITE_1, limit);
+    count += generate(Algorithm::kCN_LITE, threads, Algorithm::CN_LITE_1, config);
 
     if (!threads.isExist(Algorithm::CN_LITE_0)) {
         threads.disable(Algorithm::CN_LITE_0);
@@ -81,41 +130,40 @@ size_t inline generate<Algorithm::CN_LITE>(Threads<CpuThreads> &threads, uint32_
 
 #ifdef XMRIG_ALGO_CN_HEAVY
 template<>
-size_t inline generate<Algorithm::CN_HEAVY>(Threads<CpuThreads> &threads, uint32_t limit)
+size_t inline generate<Algorithm::CN_HEAVY>(Threads<CpuThreads> &threads, const CpuConfig &config)
 {
-    return generate(Algorithm::kCN_HEAVY, threads, Algorithm::CN_HEAVY_0, limit);
+    return generate(Algorithm::kCN_HEAVY, threads, Algorithm::CN_HEAVY_0, config);
 }
 #endif
 
 
 #ifdef XMRIG_ALGO_CN_PICO
 template<>
-size_t inline generate<Algorithm::CN_PICO>(Threads<CpuThreads> &threads, uint32_t limit)
+size_t inline generate<Algorithm::CN_PICO>(Threads<CpuThreads> &threads, const CpuConfig &config)
 {
-    return generate(Algorithm::kCN_PICO, threads, Algorithm::CN_PICO_0, limit);
+    return generate(Algorithm::kCN_PICO, threads, Algorithm::CN_PICO_0, config);
 }
 #endif
 
 
 #ifdef XMRIG_ALGO_CN_FEMTO
 template<>
-size_t inline generate<Algorithm::CN_FEMTO>(Threads<CpuThreads>& threads, uint32_t limit)
+size_t inline generate<Algorithm::CN_FEMTO>(Threads<CpuThreads>& threads, const CpuConfig &config)
 {
-    return generate(Algorithm::kCN_UPX2, threads, Algorithm::CN_UPX2, limit);
+    return generate(Algorithm::kCN_UPX2, threads, Algorithm::CN_UPX2, config);
 }
 #endif
 
 
 #ifdef XMRIG_ALGO_RANDOMX
 template<>
-size_t inline generate<Algorithm::RANDOM_X>(Threads<CpuThreads> &threads, uint32_t limit)
+size_t inline generate<Algorithm::RANDOM_X>(Threads<CpuThreads> &threads, const CpuConfig &config)
 {
     size_t count = 0;
-    auto cpuInfo = Cpu::info();
-    auto wow     = cpuInfo->threads(Algorithm::RX_WOW, limit);
+    auto wow    = autoThreads(Algorithm::kRX_WOW, Algorithm::RX_WOW, config);
 
     if (!threads.isExist(Algorithm::RX_ARQ)) {
-        auto arq = cpuInfo->threads(Algorithm::RX_ARQ, limit);
+        auto arq = autoThreads(Algorithm::kRX_ARQ, Algorithm::RX_ARQ, config);
         if (arq == wow) {
             threads.setAlias(Algorithm::RX_ARQ, Algorithm::kRX_WOW);
             ++count;
@@ -126,7 +174,7 @@ size_t inline generate<Algorithm::RANDOM_X>(Threads<CpuThreads> &threads, uint32
     }
 
     if (!threads.isExist(Algorithm::RX_KEVA)) {
-        auto keva = cpuInfo->threads(Algorithm::RX_KEVA, limit);
+        auto keva = autoThreads(Algorithm::kRX_KEVA, Algorithm::RX_KEVA, config);
         if (keva == wow) {
             threads.setAlias(Algorithm::RX_KEVA, Algorithm::kRX_WOW);
             ++count;
@@ -140,7 +188,7 @@ size_t inline generate<Algorithm::RANDOM_X>(Threads<CpuThreads> &threads, uint32
         count += threads.move(Algorithm::kRX_WOW, std::move(wow));
     }
 
-    count += generate(Algorithm::kRX, threads, Algorithm::RX_0, limit);
+    count += generate(Algorithm::kRX, threads, Algorithm::RX_0, config);
 
     return count;
 }
@@ -149,18 +197,18 @@ size_t inline generate<Algorithm::RANDOM_X>(Threads<CpuThreads> &threads, uint32
 
 #ifdef XMRIG_ALGO_ARGON2
 template<>
-size_t inline generate<Algorithm::ARGON2>(Threads<CpuThreads> &threads, uint32_t limit)
+size_t inline generate<Algorithm::ARGON2>(Threads<CpuThreads> &threads, const CpuConfig &config)
 {
-    return generate(Algorithm::kAR2, threads, Algorithm::AR2_CHUKWA_V2, limit);
+    return generate(Algorithm::kAR2, threads, Algorithm::AR2_CHUKWA_V2, config);
 }
 #endif
 
 
 #ifdef XMRIG_ALGO_GHOSTRIDER
 template<>
-size_t inline generate<Algorithm::GHOSTRIDER>(Threads<CpuThreads>& threads, uint32_t limit)
+size_t inline generate<Algorithm::GHOSTRIDER>(Threads<CpuThreads>& threads, const CpuConfig &config)
 {
-    return generate(Algorithm::kGHOSTRIDER, threads, Algorithm::GHOSTRIDER_RTM, limit);
+    return generate(Algorithm::kGHOSTRIDER, threads, Algorithm::GHOSTRIDER_RTM, config);
 }
 #endif
 
@@ -0,0 +1,305 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "backend/cpu/CpuEfficiency.h"
+#include "3rdparty/rapidjson/document.h"
+#include "backend/common/Hashrate.h"
+#include "base/io/log/Log.h"
+#include "base/io/log/Tags.h"
+#include "crypto/common/Nonce.h"
+
+
+#ifdef XMRIG_FEATURE_ENERGY
+#   include "hw/energy/EnergyMeter.h"
+#endif
+
+
+#include <limits>
+
+
+namespace xmrig {
+
+
+constexpr uint64_t kWindowTicks = 60;     // 30 seconds
+constexpr double kMinGain       = 0.01;
+constexpr int kUsageStep        = 10;
+constexpr int kMinUsage         = 50;
+
+
+std::atomic<size_t> CpuEfficiency::m_activeThreads{ std::numeric_limits<size_t>::max() };
+std::atomic<int> CpuEfficiency::m_maxCpuUsage{ 0 };
+
+
+#ifndef XMRIG_FEATURE_ENERGY
+class EnergyMeter {};
+#endif
+
+
+} // namespace xmrig
+
+
+xmrig::CpuEfficiency::CpuEfficiency()
+{
+#   ifdef XMRIG_FEATURE_ENERGY
+    m_meter.reset(new EnergyMeter());
+
+    if (m_meter->isAvailable()) {
+        LOG_INFO("%s " WHITE_BOLD("%s") " counters for " CYAN_BOLD("%zu") " package(s)", EnergyMeter::tag(), m_meter->source(), m_meter->packages());
+    }
+#   endif
+}
+
+
+xmrig::CpuEfficiency::~CpuEfficiency()
+{
+    stop();
+}
+
+
+bool xmrig::CpuEfficiency::isAvailable() const
+{
+#   ifdef XMRIG_FEATURE_ENERGY
+    return m_meter && m_meter->isAvailable();
+#   else
+    return false;
+#   endif
+}
+
+
+double xmrig::CpuEfficiency::hashesPerJoule() const
+{
+    return m_joules > 0.0 ? m_hashes / m_joules : 0.0;
+}
+
+
+void xmrig::CpuEfficiency::start(const Algorithm &algorithm, size_t threads, int maxCpuUsage, bool governor)
+{
+    stop();
+
+    m_algorithm     = algorithm;
+    m_totalThreads  = threads;
+    m_threads       = threads;
+    m_usage         = maxCpuUsage > 0 ? maxCpuUsage : 100;
+    m_maxUsage      = m_usage;
+    m_governor      = governor && isAvailable() && threads > 0;
+    m_best          = 0.0;
+    m_failures      = 0;
+    m_move          = LessUsage;
+    m_converged     = false;
+    m_settling      = true;
+
+    if (m_governor) {
+        m_activeThreads = m_threads;
+        m_maxCpuUsage   = m_usage;
+    }
+}
+
+
+void xmrig::CpuEfficiency::stop()
+{
+    m_activeThreads = std::numeric_limits<size_t>::max();
+    m_maxCpuUsage   = 0;
+    m_lastTs        = 0;
+    m_power         = 0.0;
+    m_hashes        = 0.0;
+    m_joules        = 0.0;
+}
+
+
+void xmrig::CpuEfficiency::tick(uint64_t ticks, const Hashrate *hashrate)
+{
+#   ifdef XMRIG_FEATURE_ENERGY
+    if (!isAvailable() || !m_algorithm.isValid() || (ticks % kWindowTicks) != 0) {
+        return;
+    }
+
+    const auto sample = m_meter->read();
+    const uint64_t ts = m_lastTs;
+    const double package = sample.package - m_lastPackage;
+    const double core    = sample.core - m_lastCore;
+
+    m_lastTs      = sample.ts;
+    m_lastPackage = sample.package;
+    m_lastCore    = sample.core;
+
+    if (ts == 0 || sample.ts <= ts || package <= 0.0) {
+        return;
+    }
+
+    const uint64_t elapsed = sample.ts - ts;
+
+    m_joules = package;
+    m_hashes = hashrate ? hashrate->calc(elapsed) * elapsed / 1000.0 : 0.0;
+    m_power  = package * 1000.0 / elapsed;
+    m_core   = core * 1000.0 / elapsed;
+
+    auto &stats = m_stats[m_algorithm.id()];
+    stats.hashes += m_hashes;
+    stats.joules += m_joules;
+
+    if (!m_governor || m_converged || m_hashes <= 0.0) {
+        return;
+    }
+
+    // the first window after a change still contains the previous configuration
+    if (m_settling) {
+        m_settling = false;
+
+        return;
+    }
+
+    govern(hashesPerJoule());
+#   endif
+}
+
+
+#ifdef XMRIG_FEATURE_API
+rapidjson::Value xmrig::CpuEfficiency::toJSON(rapidjson::Document &doc) const
+{
+    using namespace rapidjson;
+    auto &allocator = doc.GetAllocator();
+
+    if (!isAvailable()) {
+        return Value(kNullType);
+    }
+
+    Value out(kObjectType);
+
+#   ifdef XMRIG_FEATURE_ENERGY
+    out.AddMember("source",             StringRef(m_meter->source()), allocator);
+    out.AddMember("packages",           static_cast<uint64_t>(m_meter->packages()), allocator);
+#   endif
+
+    out.AddMember("power",              Hashrate::normalize(m_power), allocator);
+    out.AddMember("core-power",         Hashrate::normalize(m_core), allocator);
+    out.AddMember("hashes-per-joule",   Hashrate::normalize(hashesPerJoule()), allocator);
+
+    Value algorithms(kObjectType);
+    for (const auto &kv : m_stats) {
+        if (kv.second.joules > 0.0) {
+            algorithms.AddMember(Algorithm(kv.first).toJSON(), Hashrate::normalize(kv.second.hashes / kv.second.joules), allocator);
+        }
+    }
+
+    out.AddMember("algorithms", algorithms, allocator);
+
+    Value governor(kObjectType);
+    governor.AddMember("enabled",       m_governor, allocator);
+    governor.AddMember("threads",       static_cast<uint64_t>(m_threads), allocator);
+    governor.AddMember("max-cpu-usage", m_usage, allocator);
+    governor.AddMember("converged",     m_converged, allocator);
+
+    out.AddMember("governor", governor, allocator);
+
+    return out;
+}
+#endif
+
+
+bool xmrig::CpuEfficiency::apply(Move move)
+{
+    const size_t minThreads = m_totalThreads > 1 ? m_totalThreads / 2 : 1;
+
+    switch (move) {
+    case LessUsage:
+        if (m_bestUsage - kUsageStep < kMinUsage) {
+            return false;
+        }
+
+        set(m_bestThreads, m_bestUsage - kUsageStep);
+        break;
+
+    case MoreUsage:
+        if (m_bestUsage + kUsageStep > m_maxUsage) {
+            return false;
+        }
+
+        set(m_bestThreads, m_bestUsage + kUsageStep);
+        break;
+
+    case LessThreads:
+        if (m_bestThreads <= minThreads) {
+            return false;
+        }
+
+        set(m_bestThreads - 1, m_bestUsage);
+        break;
+
+    case MoreThreads:
+        if (m_bestThreads >= m_totalThreads) {
+            return false;
+        }
+
+        set(m_bestThreads + 1, m_bestUsage);
+        break;
+
+    default:
+        return false;
+    }
+
+    return true;
+}
+
+
+void xmrig::CpuEfficiency::govern(double efficiency)
+{
+    if (m_best <= 0.0 || efficiency > m_best * (1.0 + kMinGain)) {
+        if (m_best > 0.0) {
+            LOG_INFO("%s " GREEN_BOLD("%.2f H/J") " threads " CYAN_BOLD("%zu") " max-cpu-usage " CYAN_BOLD("%d%%"), Tags::cpu(), efficiency, m_threads, m_usage);
+        }
+
+        m_best        = efficiency;
+        m_bestThreads = m_threads;
+        m_bestUsage   = m_usage;
+        m_failures    = 0;
+    }
+    else {
+        m_failures++;
+        m_move = (m_move + 1) % MoveMax;
+    }
+
+    // keep moving in the same direction while it helps, otherwise try the next move from the best point
+    while (m_failures < MoveMax) {
+        if (apply(static_cast<Move>(m_move))) {
+            return;
+        }
+
+        m_failures++;
+        m_move = (m_move + 1) % MoveMax;
+    }
+
+    set(m_bestThreads, m_bestUsage);
+    m_converged = true;
+
+    LOG_INFO("%s efficiency mode " WHITE_BOLD("%.2f H/J") " threads " CYAN_BOLD("%zu/%zu") " max-cpu-usage " CYAN_BOLD("%d%%"), Tags::cpu(), m_best, m_bestThreads, m_totalThreads, m_bestUsage);
+}
+
+
+void xmrig::CpuEfficiency::set(size_t threads, int usage)
+{
+    m_threads       = threads;
+    m_usage         = usage;
+    m_settling      = true;
+    m_activeThreads = threads;
+    m_maxCpuUsage   = usage;
+
+    // workers re-read the limits when they pick up a job
+    if (Nonce::sequence(Nonce::CPU) > 0) {
+        Nonce::touch(Nonce::CPU);
+    }
+}
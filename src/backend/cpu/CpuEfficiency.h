@@ -0,0 +1,119 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_CPUEFFICIENCY_H
+#define XMRIG_CPUEFFICIENCY_H
+
+
+#include <atomic>
+#include <map>
+#include <memory>
+
+
+#include "3rdparty/rapidjson/fwd.h"
+#include "base/crypto/Algorithm.h"
+#include "base/tools/Object.h"
+
+
+namespace xmrig {
+
+
+class EnergyMeter;
+class Hashrate;
+
+
+/**
+ * Samples CPU package energy alongside the CPU backend hashrate and reports hashes per joule per algorithm.
+ *
+ * In efficiency mode it also runs a simple hill climb over the number of active threads and the max-cpu-usage
+ * governor: every window the last change is kept if H/J improved and reverted otherwise.
+ */
+class CpuEfficiency
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE(CpuEfficiency)
+
+    CpuEfficiency();
+    ~CpuEfficiency();
+
+    static inline bool isActive(size_t threadId)            { return threadId < m_activeThreads.load(std::memory_order_relaxed); }
+    static inline int maxCpuUsage(int configured)           { const int usage = m_maxCpuUsage.load(std::memory_order_relaxed); return usage > 0 ? usage : configured; }
+
+    bool isAvailable() const;
+    double hashesPerJoule() const;
+    inline double power() const                             { return m_power; }
+
+    void start(const Algorithm &algorithm, size_t threads, int maxCpuUsage, bool governor);
+    void stop();
+    void tick(uint64_t ticks, const Hashrate *hashrate);
+
+#   ifdef XMRIG_FEATURE_API
+    rapidjson::Value toJSON(rapidjson::Document &doc) const;
+#   endif
+
+private:
+    enum Move {
+        LessUsage,
+        LessThreads,
+        MoreUsage,
+        MoreThreads,
+        MoveMax
+    };
+
+    struct Stats
+    {
+        double hashes   = 0.0;
+        double joules   = 0.0;
+    };
+
+    bool apply(Move move);
+    void govern(double efficiency);
+    void set(size_t threads, int usage);
+
+    static std::atomic<size_t> m_activeThreads;
+    static std::atomic<int> m_maxCpuUsage;
+
+    Algorithm m_algorithm;
+    bool m_governor         = false;
+    bool m_settling         = false;
+    bool m_converged        = false;
+    double m_best           = 0.0;
+    double m_core           = 0.0;
+    double m_hashes         = 0.0;
+    double m_joules         = 0.0;
+    double m_power          = 0.0;
+    double m_lastCore       = 0.0;
+    double m_lastPackage    = 0.0;
+    int m_bestUsage         = 100;
+    int m_maxUsage          = 100;
+    int m_usage             = 100;
+    size_t m_bestThreads    = 0;
+    size_t m_failures       = 0;
+    size_t m_move           = LessUsage;
+    size_t m_threads        = 0;
+    size_t m_totalThreads   = 0;
+    std::map<Algorithm::Id, Stats> m_stats;
+    std::unique_ptr<EnergyMeter> m_meter;
+    uint64_t m_lastTs       = 0;
+};
+
+
+} // namespace xmrig
+
+
+#endif /* XMRIG_CPUEFFICIENCY_H */
@@ -37,6 +37,8 @@ xmrig::CpuLaunchData::CpuLaunchData(const Miner *miner, const Algorithm &algorit
     assembly(config.assembly()),
     hugePages(config.isHugePages()),
     hwAES(config.isHwAES()),
+    numaShards(config.isNumaShards()),
+    scratchpadPlacement(config.isScratchpadPlacement()),
     yield(config.isYield()),
     priority(config.priority()),
     maxCpuUsage(config.maxCpuUsage()),
@@ -55,6 +57,8 @@ bool xmrig::CpuLaunchData::isEqual(const CpuLaunchData &other) const
             && assembly         == other.assembly
             && hugePages        == other.hugePages
             && hwAES            == other.hwAES
+            && numaShards       == other.numaShards
+            && scratchpadPlacement == other.scratchpadPlacement
             && intensity        == other.intensity
             && priority         == other.priority
             && affinity         == other.affinity
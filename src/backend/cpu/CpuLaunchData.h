@@ -60,6 +60,8 @@ public:
     const Assembly assembly;
     const bool hugePages;
     const bool hwAES;
+    const bool numaShards;
+    const bool scratchpadPlacement;
     const bool yield;
     const int priority;
     const int maxCpuUsage;
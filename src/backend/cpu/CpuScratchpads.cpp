@@ -0,0 +1,215 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "backend/cpu/CpuScratchpads.h"
+#include "backend/cpu/Cpu.h"
+#include "backend/cpu/CpuLaunchData.h"
+#include "crypto/common/VirtualMemory.h"
+
+
+#ifdef XMRIG_FEATURE_HWLOC
+#   include <hwloc.h>
+
+#   if HWLOC_API_VERSION < 0x20000
+static inline int hwloc_obj_type_is_cache(hwloc_obj_type_t type)
+{
+    return type == HWLOC_OBJ_CACHE;
+}
+#   endif
+#endif
+
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+
+
+namespace xmrig {
+
+
+constexpr size_t kCacheLine         = 64;
+constexpr size_t kDefaultWays       = 16;
+constexpr int64_t kZen3HeavyGroup   = -2;
+
+
+struct CacheGroup
+{
+    int64_t id  = -1;
+    size_t size = 0;
+    size_t ways = kDefaultWays;
+};
+
+
+struct SharedBlock
+{
+    VirtualMemory *memory   = nullptr;
+    size_t refs             = 0;
+};
+
+
+static std::map<std::pair<int64_t, size_t>, SharedBlock> blocks;
+static std::mutex mutex;
+
+
+static CacheGroup cacheGroup(int64_t affinity)
+{
+    CacheGroup group;
+    group.size = Cpu::info()->L3() ? Cpu::info()->L3() : Cpu::info()->L2();
+
+#   ifdef XMRIG_FEATURE_HWLOC
+    if (affinity < 0) {
+        return group;
+    }
+
+    hwloc_obj_t pu = hwloc_get_pu_obj_by_os_index(Cpu::info()->topology(), static_cast<unsigned>(affinity));
+
+    // walk up from the PU, the outermost L2/L3 cache wins
+    for (hwloc_obj_t obj = pu ? pu->parent : nullptr; obj != nullptr; obj = obj->parent) {
+        if (!hwloc_obj_type_is_cache(obj->type) || obj->attr->cache.depth < 2 || obj->attr->cache.depth > 3) {
+            continue;
+        }
+
+        group.id   = (static_cast<int64_t>(obj->attr->cache.depth) << 32) | obj->logical_index;
+        group.size = obj->attr->cache.size;
+        group.ways = obj->attr->cache.associativity > 0 ? static_cast<size_t>(obj->attr->cache.associativity) : kDefaultWays;
+    }
+#   endif
+
+    return group;
+}
+
+
+static size_t colourStep(const CacheGroup &group, size_t slots)
+{
+    // Distance after which the same cache set repeats. Physical addresses are only contiguous inside
+    // one huge page, so colours beyond that can't be chosen by a virtual offset.
+    const size_t span = std::min(std::max(group.size / group.ways, kCacheLine), VirtualMemory::hugePageSize());
+
+    return std::max(kCacheLine, (span / slots) & ~(kCacheLine - 1));
+}
+
+
+#ifdef XMRIG_ALGO_CN_HEAVY
+static bool isZen3Heavy(const CpuLaunchData &data, size_t ways)
+{
+    const auto arch = Cpu::info()->arch();
+    const uint32_t model = Cpu::info()->model();
+    const bool is_vermeer = (arch == ICpuInfo::ARCH_ZEN3) && (model == 0x21);
+    const bool is_raphael = (arch == ICpuInfo::ARCH_ZEN4) && (model == 0x61);
+
+    return (ways == 1) && (data.av() == CnHash::AV_SINGLE) && (data.algorithm.family() == Algorithm::CN_HEAVY) && (data.assembly != Assembly::NONE) && (is_vermeer || is_raphael);
+}
+#endif
+
+
+static VirtualMemory *acquireBlock(const std::pair<int64_t, size_t> &key, size_t size, bool hugePages, bool usePool, uint32_t node)
+{
+    auto &block = blocks[key];
+    if (!block.memory) {
+        block.memory = new VirtualMemory(size, hugePages, false, usePool, node);
+    }
+
+    block.refs++;
+
+    return block.memory;
+}
+
+
+} // namespace xmrig
+
+
+xmrig::CpuScratchpads::Slot xmrig::CpuScratchpads::acquire(const CpuLaunchData &data, size_t id, size_t ways, uint32_t node)
+{
+    const size_t stride = data.algorithm.l3() * ways;
+    Slot slot;
+
+#   ifdef XMRIG_ALGO_CN_HEAVY
+    // cn-heavy optimization for Zen3 CPUs, groups of 8 threads share one scratchpad shifted by a cache line
+    if (isZen3Heavy(data, ways)) {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        // Round up number of threads to the multiple of 8
+        const size_t num_threads = ((data.threads + 7) / 8) * 8;
+
+        slot.memory = acquireBlock({ kZen3HeavyGroup, stride }, stride * num_threads, data.hugePages, false, node);
+        slot.offset = (id / 8) * stride * 8 + (id % 8) * kCacheLine;
+        slot.shared = true;
+
+        return slot;
+    }
+#   endif
+
+    if (data.scratchpadPlacement && data.algorithm.isCN() && data.affinities.size() > 1) {
+        const CacheGroup group = cacheGroup(data.affinity);
+        size_t index = 0;
+        size_t slots = 0;
+
+        for (size_t i = 0; i < data.affinities.size(); ++i) {
+            if (cacheGroup(data.affinities[i]).id != group.id) {
+                continue;
+            }
+
+            if (i < id) {
+                ++index;
+            }
+
+            ++slots;
+        }
+
+        if (slots > 1) {
+            const size_t step = colourStep(group, slots);
+
+            std::lock_guard<std::mutex> lock(mutex);
+
+            slot.memory = acquireBlock({ group.id, stride }, slots * (stride + step), data.hugePages, true, node);
+            slot.offset = index * (stride + step);
+            slot.shared = true;
+
+            return slot;
+        }
+    }
+
+    slot.memory = new VirtualMemory(stride, data.hugePages, false, true, node);
+
+    return slot;
+}
+
+
+void xmrig::CpuScratchpads::release(const Slot &slot)
+{
+    if (!slot.shared) {
+        delete slot.memory;
+
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for (auto it = blocks.begin(); it != blocks.end(); ++it) {
+        if (it->second.memory != slot.memory) {
+            continue;
+        }
+
+        if (--it->second.refs == 0) {
+            delete it->second.memory;
+            blocks.erase(it);
+        }
+
+        return;
+    }
+}
@@ -0,0 +1,59 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_CPUSCRATCHPADS_H
+#define XMRIG_CPUSCRATCHPADS_H
+
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace xmrig {
+
+
+class CpuLaunchData;
+class VirtualMemory;
+
+
+/**
+ * Chooses where the CryptoNight scratchpads of CPU workers live.
+ *
+ * By default every worker gets its own huge page aligned block, so all scratchpads start at the same cache set.
+ * With placement enabled, workers sharing the same top level cache are packed into one block and every scratchpad
+ * is shifted by a different number of cache lines ("colour"), spreading them over all sets of that cache.
+ */
+class CpuScratchpads
+{
+public:
+    struct Slot
+    {
+        VirtualMemory *memory   = nullptr;
+        size_t offset           = 0;
+        bool shared             = false;
+    };
+
+    static Slot acquire(const CpuLaunchData &data, size_t id, size_t ways, uint32_t node);
+    static void release(const Slot &slot);
+};
+
+
+} // namespace xmrig
+
+
+#endif // XMRIG_CPUSCRATCHPADS_H
@@ -0,0 +1,136 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "backend/cpu/CpuShards.h"
+#include "3rdparty/rapidjson/document.h"
+#include "backend/common/Hashrate.h"
+#include "base/net/stratum/Job.h"
+#include "core/Miner.h"
+#include "crypto/common/portable/mm_malloc.h"
+
+
+#include <algorithm>
+#include <new>
+
+
+namespace xmrig {
+
+
+static std::mutex mutex;
+static std::vector<CpuShards::Shard *> shards;
+
+
+} // namespace xmrig
+
+
+std::shared_ptr<const xmrig::Job> xmrig::CpuShards::Shard::job(const Miner *miner)
+{
+    // the sequence is always changed after a new job was published, so read it first
+    const uint64_t sequence = Nonce::sequence(Nonce::CPU);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (!m_job || m_sequence != sequence) {
+        auto source = miner->jobSnapshot(Nonce::CPU);
+
+        if (source != m_source) {
+            m_job    = source ? std::make_shared<const Job>(*source) : source;
+            m_source = std::move(source);
+        }
+
+        m_sequence = sequence;
+    }
+
+    return m_job;
+}
+
+
+xmrig::CpuShards::Shard *xmrig::CpuShards::get(uint32_t node, size_t threadId)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto it = std::find_if(shards.begin(), shards.end(), [node](const Shard *shard) { return shard->node == node; });
+    if (it == shards.end()) {
+        // plain operator new ignores the cache line alignment in C++11
+        shards.push_back(new (_mm_malloc(sizeof(Shard), alignof(Shard))) Shard(node, static_cast<uint32_t>(shards.size())));
+        it = shards.end() - 1;
+    }
+
+    (*it)->threads.push_back(threadId);
+
+    return *it;
+}
+
+
+void xmrig::CpuShards::release()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for (Shard *shard : shards) {
+        shard->~Shard();
+        _mm_free(shard);
+    }
+
+    shards.clear();
+}
+
+
+#ifdef XMRIG_FEATURE_API
+rapidjson::Value xmrig::CpuShards::toJSON(const Hashrate *hashrate, rapidjson::Document &doc)
+{
+    using namespace rapidjson;
+    auto &allocator = doc.GetAllocator();
+
+    Value out(kArrayType);
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for (const Shard *shard : shards) {
+        double values[3] = { 0.0, 0.0, 0.0 };
+        const size_t intervals[3] = { Hashrate::ShortInterval, Hashrate::MediumInterval, Hashrate::LargeInterval };
+
+        for (size_t i = 0; i < 3; ++i) {
+            for (size_t id : shard->threads) {
+                const double value = hashrate ? hashrate->calc(id, intervals[i]) : 0.0;
+                if (std::isnormal(value)) {
+                    values[i] += value;
+                }
+            }
+        }
+
+        Value threads(kArrayType);
+        for (size_t id : shard->threads) {
+            threads.PushBack(static_cast<uint64_t>(id), allocator);
+        }
+
+        Value hr(kArrayType);
+        for (double value : values) {
+            hr.PushBack(Hashrate::normalize(value), allocator);
+        }
+
+        Value item(kObjectType);
+        item.AddMember("node",      shard->node, allocator);
+        item.AddMember("threads",   threads, allocator);
+        item.AddMember("hashrate",  hr, allocator);
+
+        out.PushBack(item, allocator);
+    }
+
+    return out;
+}
+#endif
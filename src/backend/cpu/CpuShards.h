@@ -0,0 +1,80 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_CPUSHARDS_H
+#define XMRIG_CPUSHARDS_H
+
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+
+#include "3rdparty/rapidjson/fwd.h"
+#include "crypto/common/NonceShard.h"
+
+
+namespace xmrig {
+
+
+class Hashrate;
+class Job;
+class Miner;
+
+
+/**
+ * Per NUMA node state of the CPU backend: a node local job replica, nonce allocator and list of threads.
+ *
+ * Shards are created lazily by the first worker of a node, after the worker thread was bound to that node,
+ * so the shard memory is allocated node local as well.
+ */
+class CpuShards
+{
+public:
+    class alignas(64) Shard
+    {
+    public:
+        inline Shard(uint32_t node, uint32_t index) : node(node), index(index), nonce(Nonce::CPU) {}
+
+        std::shared_ptr<const Job> job(const Miner *miner);
+
+        const uint32_t node;
+        const uint32_t index;
+        NonceShard nonce;
+        std::vector<size_t> threads;
+
+    private:
+        std::mutex m_mutex;
+        std::shared_ptr<const Job> m_job;
+        std::shared_ptr<const Job> m_source;
+        uint64_t m_sequence = 0;
+    };
+
+    static Shard *get(uint32_t node, size_t threadId);
+    static void release();
+
+#   ifdef XMRIG_FEATURE_API
+    static rapidjson::Value toJSON(const Hashrate *hashrate, rapidjson::Document &doc);
+#   endif
+};
+
+
+} // namespace xmrig
+
+
+#endif /* XMRIG_CPUSHARDS_H */
@@ -0,0 +1,381 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "backend/cpu/CpuThermal.h"
+#include "3rdparty/rapidjson/document.h"
+#include "backend/common/Hashrate.h"
+#include "backend/cpu/Cpu.h"
+#include "backend/cpu/CpuLaunchData.h"
+#include "base/io/log/Log.h"
+
+
+#ifdef XMRIG_FEATURE_THERMAL
+#   include "hw/thermal/ThermalMeter.h"
+#endif
+
+
+#ifdef XMRIG_FEATURE_HWLOC
+#   include <hwloc.h>
+
+#   if HWLOC_API_VERSION < 0x20000
+static inline int hwloc_obj_type_is_cache(hwloc_obj_type_t type)
+{
+    return type == HWLOC_OBJ_CACHE;
+}
+#   endif
+#endif
+
+
+#include <algorithm>
+
+
+namespace xmrig {
+
+
+constexpr uint64_t kThermalTicks    = 2;    // 1 second
+constexpr int kStepDown             = 10;
+constexpr int kMaxStepDown          = 30;
+constexpr int kStepUp               = 5;
+
+
+std::vector<std::atomic<int>> CpuThermal::m_duty;
+
+
+#ifdef XMRIG_FEATURE_THERMAL
+#ifdef XMRIG_FEATURE_HWLOC
+static void findL3(hwloc_obj_t obj, std::vector<hwloc_obj_t> &out)
+{
+    if (hwloc_obj_type_is_cache(obj->type) && obj->attr->cache.depth == 3) {
+        out.push_back(obj);
+
+        return;
+    }
+
+    for (unsigned i = 0; i < obj->arity; ++i) {
+        findL3(obj->children[i], out);
+    }
+}
+#endif
+
+
+static size_t findSensor(const std::vector<ThermalMeter::Sensor> &sensors, ThermalMeter::Kind kind, int package, int index)
+{
+    for (size_t i = 0; i < sensors.size(); ++i) {
+        if (sensors[i].kind == kind && sensors[i].package == package && sensors[i].index == index) {
+            return i;
+        }
+    }
+
+    return sensors.size();
+}
+
+
+static size_t sensorFor(const ThermalMeter &meter, int64_t affinity)
+{
+    const auto &sensors = meter.sensors();
+    int package         = -1;
+    int core            = -1;
+    int ccd             = -1;
+
+#   ifdef XMRIG_FEATURE_HWLOC
+    hwloc_topology_t topology = Cpu::info()->topology();
+    hwloc_obj_t pu            = affinity >= 0 ? hwloc_get_pu_obj_by_os_index(topology, static_cast<unsigned>(affinity)) : nullptr;
+
+    if (pu) {
+        hwloc_obj_t obj = hwloc_get_ancestor_obj_by_type(topology, HWLOC_OBJ_CORE, pu);
+        if (obj) {
+            core = static_cast<int>(obj->os_index);
+        }
+
+        hwloc_obj_t root = hwloc_get_ancestor_obj_by_type(topology, HWLOC_OBJ_PACKAGE, pu);
+        if (root) {
+            package = static_cast<int>(root->os_index);
+
+            // k10temp numbers CCDs, hwloc knows L3 caches: Zen 3 and newer have one L3 per CCD, Zen 2 two
+            const size_t ccds = static_cast<size_t>(std::count_if(sensors.begin(), sensors.end(), [package](const ThermalMeter::Sensor &sensor) {
+                return sensor.kind == ThermalMeter::Ccd && sensor.package == package;
+            }));
+
+            std::vector<hwloc_obj_t> caches;
+            findL3(root, caches);
+
+            for (obj = pu->parent; ccds > 0 && obj != nullptr; obj = obj->parent) {
+                const auto it = std::find(caches.begin(), caches.end(), obj);
+                if (it != caches.end()) {
+                    ccd = static_cast<int>(static_cast<size_t>(it - caches.begin()) * ccds / caches.size());
+                    break;
+                }
+            }
+        }
+    }
+#   endif
+
+    size_t index = findSensor(sensors, ThermalMeter::Core, package, core);
+    if (index < sensors.size()) {
+        return index;
+    }
+
+    if ((index = findSensor(sensors, ThermalMeter::Ccd, package, ccd)) < sensors.size()) {
+        return index;
+    }
+
+    if ((index = findSensor(sensors, ThermalMeter::Package, package, -1)) < sensors.size()) {
+        return index;
+    }
+
+    // unknown package, the first package level sensor is the best guess
+    for (size_t i = 0; i < sensors.size(); ++i) {
+        if (sensors[i].kind == ThermalMeter::Package) {
+            return i;
+        }
+    }
+
+    return 0;
+}
+#else
+class ThermalMeter {};
+#endif
+
+
+} // namespace xmrig
+
+
+xmrig::CpuThermal::CpuThermal() = default;
+
+
+xmrig::CpuThermal::~CpuThermal()
+{
+    stop();
+}
+
+
+bool xmrig::CpuThermal::isAvailable() const
+{
+#   ifdef XMRIG_FEATURE_THERMAL
+    return m_meter && m_meter->isAvailable();
+#   else
+    return false;
+#   endif
+}
+
+
+double xmrig::CpuThermal::temperature() const
+{
+    double max = 0.0;
+
+#   ifdef XMRIG_FEATURE_THERMAL
+    if (isAvailable()) {
+        for (const auto &sensor : m_meter->sensors()) {
+            max = std::max(max, sensor.temperature);
+        }
+    }
+#   endif
+
+    return max;
+}
+
+
+std::vector<xmrig::CpuThermal::Zone> xmrig::CpuThermal::zones() const
+{
+    std::vector<Zone> out;
+
+#   ifdef XMRIG_FEATURE_THERMAL
+    if (!isAvailable()) {
+        return out;
+    }
+
+    const auto &sensors = m_meter->sensors();
+    out.reserve(sensors.size());
+
+    for (size_t i = 0; i < sensors.size(); ++i) {
+        Zone zone;
+        zone.name        = sensors[i].name;
+        zone.package     = sensors[i].package;
+        zone.temperature = sensors[i].temperature;
+        zone.duty        = i < m_sensorDuty.size() ? m_sensorDuty[i] : 100;
+        zone.threads     = i < m_sensorThreads.size() ? m_sensorThreads[i] : 0;
+
+        out.push_back(std::move(zone));
+    }
+#   endif
+
+    return out;
+}
+
+
+void xmrig::CpuThermal::start(const std::vector<CpuLaunchData> &threads, const String &sysfs, int target, int hysteresis)
+{
+    m_target     = target;
+    m_hysteresis = hysteresis;
+
+    // workers are stopped at this point, so the duty table can be replaced
+    m_duty = std::vector<std::atomic<int>>(threads.size());
+    for (auto &duty : m_duty) {
+        duty = 100;
+    }
+
+#   ifdef XMRIG_FEATURE_THERMAL
+    if (!m_meter || m_sysfs != sysfs) {
+        m_sysfs = sysfs;
+        m_meter.reset(new ThermalMeter(sysfs));
+
+        if (m_meter->isAvailable()) {
+            LOG_INFO("%s " WHITE_BOLD("%s") " sensors " CYAN_BOLD("%zu") " temperature " CYAN_BOLD("%.0fC"), ThermalMeter::tag(), m_meter->source(), m_meter->sensors().size(), temperature());
+        }
+        else if (m_target > 0) {
+            LOG_WARN("%s " YELLOW("no CPU temperature sensors found, thermal-target ignored"), ThermalMeter::tag());
+        }
+    }
+
+    const size_t count = m_meter->sensors().size();
+
+    m_sensorDuty.assign(count, 100);
+    m_sensorThreads.assign(count, 0);
+    m_threadSensor.assign(threads.size(), 0);
+
+    if (!isAvailable()) {
+        return;
+    }
+
+    for (size_t i = 0; i < threads.size(); ++i) {
+        m_threadSensor[i] = sensorFor(*m_meter, threads[i].affinity);
+        m_sensorThreads[m_threadSensor[i]]++;
+    }
+#   endif
+}
+
+
+void xmrig::CpuThermal::stop()
+{
+    for (auto &duty : m_duty) {
+        duty = 100;
+    }
+
+    std::fill(m_sensorDuty.begin(), m_sensorDuty.end(), 100);
+}
+
+
+void xmrig::CpuThermal::tick(uint64_t ticks)
+{
+#   ifdef XMRIG_FEATURE_THERMAL
+    if (!isAvailable() || (ticks % kThermalTicks) != 0) {
+        return;
+    }
+
+    m_meter->read();
+
+    if (m_target > 0 && !m_threadSensor.empty()) {
+        govern();
+    }
+#   endif
+}
+
+
+#ifdef XMRIG_FEATURE_API
+rapidjson::Value xmrig::CpuThermal::toJSON(rapidjson::Document &doc) const
+{
+    using namespace rapidjson;
+    auto &allocator = doc.GetAllocator();
+
+    if (!isAvailable()) {
+        return Value(kNullType);
+    }
+
+    Value out(kObjectType);
+
+#   ifdef XMRIG_FEATURE_THERMAL
+    out.AddMember("source",         StringRef(m_meter->source()), allocator);
+#   endif
+
+    out.AddMember("target",         m_target > 0 ? Value(m_target) : Value(kNullType), allocator);
+    out.AddMember("hysteresis",     m_hysteresis, allocator);
+    out.AddMember("temperature",    Hashrate::normalize(temperature()), allocator);
+
+    Value sensors(kArrayType);
+    for (const auto &zone : zones()) {
+        Value sensor(kObjectType);
+        sensor.AddMember("name",        zone.name.toJSON(doc), allocator);
+        sensor.AddMember("package",     zone.package, allocator);
+        sensor.AddMember("temperature", Hashrate::normalize(zone.temperature), allocator);
+        sensor.AddMember("threads",     static_cast<uint64_t>(zone.threads), allocator);
+        sensor.AddMember("duty",        zone.duty, allocator);
+        sensor.AddMember("throttled",   zone.duty < 100, allocator);
+
+        sensors.PushBack(sensor, allocator);
+    }
+
+    out.AddMember("sensors", sensors, allocator);
+
+    return out;
+}
+#endif
+
+
+void xmrig::CpuThermal::govern()
+{
+#   ifdef XMRIG_FEATURE_THERMAL
+    const auto &sensors = m_meter->sensors();
+
+    for (size_t i = 0; i < sensors.size(); ++i) {
+        const double temperature = sensors[i].temperature;
+        if (m_sensorThreads[i] == 0 || temperature <= 0.0) {
+            continue;
+        }
+
+        const int prev = m_sensorDuty[i];
+        int duty       = prev;
+
+        // the further above target, the bigger the step; inside the hysteresis band nothing changes
+        if (temperature > m_target) {
+            duty -= std::min(kStepDown * (1 + static_cast<int>((temperature - m_target) / m_hysteresis)), kMaxStepDown);
+        }
+        else if (temperature < m_target - m_hysteresis) {
+            duty += kStepUp;
+        }
+
+        duty = std::min(std::max(duty, 0), 100);
+        if (duty == prev) {
+            continue;
+        }
+
+        setDuty(i, duty);
+
+        if (duty == 0) {
+            LOG_WARN("%s " WHITE_BOLD("%s") RED_BOLD(" %.0fC") YELLOW(" paused %zu thread(s)"), ThermalMeter::tag(), sensors[i].name.data(), temperature, m_sensorThreads[i]);
+        }
+        else if (duty == 100) {
+            LOG_INFO("%s " WHITE_BOLD("%s") GREEN_BOLD(" %.0fC") " throttling stopped", ThermalMeter::tag(), sensors[i].name.data(), temperature);
+        }
+        else if (prev == 100) {
+            LOG_WARN("%s " WHITE_BOLD("%s") YELLOW_BOLD(" %.0fC") " above target, duty " CYAN_BOLD("%d%%"), ThermalMeter::tag(), sensors[i].name.data(), temperature, duty);
+        }
+    }
+#   endif
+}
+
+
+void xmrig::CpuThermal::setDuty(size_t sensor, int duty)
+{
+    m_sensorDuty[sensor] = duty;
+
+    for (size_t i = 0; i < m_threadSensor.size() && i < m_duty.size(); ++i) {
+        if (m_threadSensor[i] == sensor) {
+            m_duty[i].store(duty, std::memory_order_relaxed);
+        }
+    }
+}
@@ -0,0 +1,100 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_CPUTHERMAL_H
+#define XMRIG_CPUTHERMAL_H
+
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+
+#include "3rdparty/rapidjson/fwd.h"
+#include "base/tools/Object.h"
+#include "base/tools/String.h"
+
+
+namespace xmrig {
+
+
+class CpuLaunchData;
+class ThermalMeter;
+
+
+/**
+ * Thermal governor of the CPU backend.
+ *
+ * Every worker is bound to the closest temperature sensor of its core: the core itself (coretemp), its CCD (k10temp)
+ * or the package. Once a second, sensors above the target temperature lower the duty cycle of their workers, sensors
+ * which cooled down below target minus hysteresis raise it again, so only the hottest cores are slowed down.
+ * A worker with zero duty is paused.
+ */
+class CpuThermal
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE(CpuThermal)
+
+    struct Zone
+    {
+        String name;
+        int package         = -1;
+        int duty            = 100;
+        double temperature  = 0.0;
+        size_t threads      = 0;
+    };
+
+    CpuThermal();
+    ~CpuThermal();
+
+    static inline int duty(size_t threadId)                 { return threadId < m_duty.size() ? m_duty[threadId].load(std::memory_order_relaxed) : 100; }
+    static inline bool isPaused(size_t threadId)            { return duty(threadId) == 0; }
+    static inline int maxCpuUsage(size_t threadId, int usage) { const int value = duty(threadId); return value < usage ? value : usage; }
+
+    bool isAvailable() const;
+    double temperature() const;
+    std::vector<Zone> zones() const;
+
+    void start(const std::vector<CpuLaunchData> &threads, const String &sysfs, int target, int hysteresis);
+    void stop();
+    void tick(uint64_t ticks);
+
+#   ifdef XMRIG_FEATURE_API
+    rapidjson::Value toJSON(rapidjson::Document &doc) const;
+#   endif
+
+private:
+    void govern();
+    void setDuty(size_t sensor, int duty);
+
+    static std::vector<std::atomic<int>> m_duty;
+
+    int m_hysteresis        = 3;
+    int m_target            = 0;
+    std::unique_ptr<ThermalMeter> m_meter;
+    std::vector<int> m_sensorDuty;
+    std::vector<size_t> m_sensorThreads;
+    std::vector<size_t> m_threadSensor;
+    String m_sysfs;
+};
+
+
+} // namespace xmrig
+
+
+#endif /* XMRIG_CPUTHERMAL_H */
@@ -22,6 +22,10 @@
 
 
 #include "backend/cpu/Cpu.h"
+#include "backend/cpu/CpuEfficiency.h"
+#include "backend/cpu/CpuThermal.h"
+#include "backend/cpu/CpuScratchpads.h"
+#include "backend/cpu/CpuShards.h"
 #include "backend/cpu/CpuWorker.h"
 #include "base/tools/Alignment.h"
 #include "base/tools/Chrono.h"
@@ -30,6 +34,7 @@
 #include "crypto/cn/CnCtx.h"
 #include "crypto/cn/CryptoNight_test.h"
 #include "crypto/cn/CryptoNight.h"
+#include "crypto/common/JobAbort.h"
 #include "crypto/common/Nonce.h"
 #include "crypto/common/VirtualMemory.h"
 #include "crypto/rx/Rx.h"
@@ -37,6 +42,7 @@
 #include "crypto/rx/RxDataset.h"
 #include "crypto/rx/RxVm.h"
 #include "crypto/ghostrider/ghostrider.h"
+#include "net/JobResult.h"
 #include "net/JobResults.h"
 #include "base/kernel/Platform.h"
 
@@ -46,6 +52,10 @@
 #   include "crypto/randomx/sha256/sha256.h"
 #endif
 
+#ifdef XMRIG_FEATURE_ASM
+#   include "crypto/cn/CnAsmTuner.h"
+#endif
+
 
 namespace xmrig {
 
@@ -54,10 +64,19 @@ static constexpr uint32_t kReserveCount = 32768;
 static constexpr size_t GHOSTRIDER_RTM_CORE_ALGO_LIMIT = 15;
 static constexpr size_t GHOSTRIDER_MIKE_CORE_ALGO_LIMIT = 11;
 
-#ifdef XMRIG_ALGO_CN_HEAVY
-static std::mutex cn_heavyZen3MemoryMutex;
-VirtualMemory* cn_heavyZen3Memory = nullptr;
-#endif
+
+// "asm": "tune" is resolved here on the worker thread, the benchmark must not block the main loop
+static inline Assembly::Id resolveAssembly(const CpuLaunchData &data)
+{
+#   ifdef XMRIG_FEATURE_ASM
+    if (data.assembly == Assembly::TUNE) {
+        return CnAsmTuner::assembly(data);
+    }
+#   endif
+
+    return data.assembly.id();
+}
+
 
 } // namespace xmrig
 
@@ -67,7 +86,7 @@ template<size_t N>
 xmrig::CpuWorker<N>::CpuWorker(size_t id, const CpuLaunchData &data) :
     Worker(id, data.affinity, data.priority),
     m_algorithm(data.algorithm),
-    m_assembly(data.assembly),
+    m_assembly(resolveAssembly(data)),
     m_hwAES(data.hwAES),
     m_yield(data.yield),
     m_av(data.av()),
@@ -76,25 +95,12 @@ xmrig::CpuWorker<N>::CpuWorker(size_t id, const CpuLaunchData &data) :
     m_threads(data.threads),
     m_ctx()
 {
-#   ifdef XMRIG_ALGO_CN_HEAVY
-    // cn-heavy optimization for Zen3 CPUs
-    const auto arch = Cpu::info()->arch();
-    const uint32_t model = Cpu::info()->model();
-    const bool is_vermeer = (arch == ICpuInfo::ARCH_ZEN3) && (model == 0x21);
-    const bool is_raphael = (arch == ICpuInfo::ARCH_ZEN4) && (model == 0x61);
-    if ((N == 1) && (m_av == CnHash::AV_SINGLE) && (m_algorithm.family() == Algorithm::CN_HEAVY) && (m_assembly != Assembly::NONE) && (is_vermeer || is_raphael)) {
-        std::lock_guard<std::mutex> lock(cn_heavyZen3MemoryMutex);
-        if (!cn_heavyZen3Memory) {
-            // Round up number of threads to the multiple of 8
-            const size_t num_threads = ((m_threads + 7) / 8) * 8;
-            cn_heavyZen3Memory = new VirtualMemory(m_algorithm.l3() * num_threads, data.hugePages, false, false, node());
-        }
-        m_memory = cn_heavyZen3Memory;
-    }
-    else
-#   endif
-    {
-        m_memory = new VirtualMemory(m_algorithm.l3() * N, data.hugePages, false, true, node());
+    m_scratchpad = CpuScratchpads::acquire(data, id, N, node());
+    m_memory     = m_scratchpad.memory;
+
+    if (data.numaShards) {
+        m_shard = CpuShards::get(node(), id);
+        m_job.setShard(&m_shard->nonce);
     }
 
 #   ifdef XMRIG_ALGO_GHOSTRIDER
@@ -111,13 +117,7 @@ xmrig::CpuWorker<N>::~CpuWorker()
 #   endif
 
     CnCtx::release(m_ctx, N);
-
-#   ifdef XMRIG_ALGO_CN_HEAVY
-    if (m_memory != cn_heavyZen3Memory)
-#   endif
-    {
-        delete m_memory;
-    }
+    CpuScratchpads::release(m_scratchpad);
 
 #   ifdef XMRIG_ALGO_GHOSTRIDER
     ghostrider::destroy_helper_thread(m_ghHelper);
@@ -247,6 +247,8 @@ void xmrig::CpuWorker<N>::hashrateData(uint64_t &hashCount, uint64_t &, uint64_t
 template<size_t N>
 void xmrig::CpuWorker<N>::start()
 {
+    JobAbort::attach(&m_abort);
+
     while (Nonce::sequence(Nonce::CPU) > 0) {
         if (Nonce::isPaused()) {
             do {
@@ -261,8 +263,22 @@ void xmrig::CpuWorker<N>::start()
             consumeJob();
         }
 
-        int maxUsagePerThread = (static_cast<double>(Cpu::info()->threads()) / static_cast<double>(m_threads*threads())) * m_maxCpuUsage;
-        bool limitCpuUsage = m_maxCpuUsage > 0 && m_maxCpuUsage < 100 && maxUsagePerThread < 100;
+        if (!CpuEfficiency::isActive(id())) {
+            do {
+                std::this_thread::sleep_for(std::chrono::milliseconds(200));
+            }
+            while (!CpuEfficiency::isActive(id()) && Nonce::sequence(Nonce::CPU) > 0);
+
+            if (Nonce::sequence(Nonce::CPU) == 0) {
+                break;
+            }
+
+            consumeJob();
+        }
+
+        const int maxCpuUsage = CpuEfficiency::maxCpuUsage(m_maxCpuUsage);
+        int maxUsagePerThread = (static_cast<double>(Cpu::info()->threads()) / static_cast<double>(m_threads*threads())) * maxCpuUsage;
+        bool limitCpuUsage = maxCpuUsage > 0 && maxCpuUsage < 100 && maxUsagePerThread < 100;
 
 #       ifdef XMRIG_ALGO_RANDOMX
         bool first = true;
@@ -304,7 +320,9 @@ void xmrig::CpuWorker<N>::start()
                     memcpy(miner_signature_saved, miner_signature_ptr, sizeof(miner_signature_saved));
                     job.generateMinerSignature(m_job.blob(), job.size(), miner_signature_ptr);
                 }
-                randomx_calculate_hash_next(m_vm, tempHash, m_job.blob(), job.size(), m_hash);
+                if (!randomx_calculate_hash_next(m_vm, tempHash, m_job.blob(), job.size(), m_hash)) {
+                    break;
+                }
 
                 if (job.algorithm() == Algorithm::RX_TUSKE) {
                     SHA256d_Buf(m_hash, RANDOMX_HASH_SIZE, m_hash);
@@ -319,9 +337,9 @@ void xmrig::CpuWorker<N>::start()
                 case Algorithm::GHOSTRIDER:
                     if (N == 8) {
                         if (job.algorithm().id() != Algorithm::GHOSTRIDER_MIKE) {
-                          ghostrider::hash_octa<GHOSTRIDER_RTM_CORE_ALGO_LIMIT>(m_job.blob(), job.size(), m_hash, m_ctx, m_ghHelper);
+                          valid = ghostrider::hash_octa<GHOSTRIDER_RTM_CORE_ALGO_LIMIT>(m_job.blob(), job.size(), m_hash, m_ctx, m_ghHelper);
                         } else {
-                          ghostrider::hash_octa<GHOSTRIDER_MIKE_CORE_ALGO_LIMIT>(m_job.blob(), job.size(), m_hash, m_ctx, m_ghHelper);
+                          valid = ghostrider::hash_octa<GHOSTRIDER_MIKE_CORE_ALGO_LIMIT>(m_job.blob(), job.size(), m_hash, m_ctx, m_ghHelper);
                         }
                     }
                     else {
@@ -335,6 +353,10 @@ void xmrig::CpuWorker<N>::start()
                     break;
                 }
 
+                if (!valid && JobAbort::isRequested()) {
+                    break;
+                }
+
                 if (!nextRound()) {
                     break;
                 };
@@ -344,16 +366,30 @@ void xmrig::CpuWorker<N>::start()
                 for (size_t i = 0; i < N; ++i) {
                     const uint64_t value = *reinterpret_cast<uint64_t*>(m_hash + (i * 32) + 24);
 
-                    if (value < job.target()) {
-                        JobResults::submit(job, current_job_nonces[i], m_hash + (i * 32), job.hasMinerSignature() ? miner_signature_saved : nullptr);
+                    if (value < job.submitTarget()) {
+                        const JobResult result(job, current_job_nonces[i], m_hash + (i * 32), nullptr, nullptr, job.hasMinerSignature() ? miner_signature_saved : nullptr);
+
+                        if (m_shard) {
+                            JobResults::submit(result, m_shard->index);
+                        }
+                        else {
+                            JobResults::submit(result);
+                        }
                     }
                 }
                 m_count += N;
             }
 
-            if ((m_count & 7) == 0 && limitCpuUsage) {
-                auto sleepTime = xmrig::Platform::getThreadSleepTimeToLimitMaxCpuUsage(maxUsagePerThread);
-                std::this_thread::sleep_for(std::chrono::microseconds(sleepTime));
+            if ((m_count & 7) == 0) {
+                while (CpuThermal::isPaused(id()) && !Nonce::isOutdated(Nonce::CPU, m_job.sequence())) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+                }
+
+                const int usage = CpuThermal::maxCpuUsage(id(), limitCpuUsage ? maxUsagePerThread : 100);
+                if (usage > 0 && usage < 100) {
+                    auto sleepTime = xmrig::Platform::getThreadSleepTimeToLimitMaxCpuUsage(usage);
+                    std::this_thread::sleep_for(std::chrono::microseconds(sleepTime));
+                }
             }
 
             if (m_yield) {
@@ -361,6 +397,11 @@ void xmrig::CpuWorker<N>::start()
             }
         }
 
+        // an aborted hash means the next job is being published right now, wait for it instead of hashing the old one
+        while (m_abort.load(std::memory_order_relaxed) && !Nonce::isOutdated(Nonce::CPU, m_job.sequence()) && Nonce::sequence(Nonce::CPU) > 0) {
+            std::this_thread::yield();
+        }
+
         consumeJob();
     }
 }
@@ -492,16 +533,7 @@ template<size_t N>
 void xmrig::CpuWorker<N>::allocateCnCtx()
 {
     if (m_ctx[0] == nullptr) {
-        int shift = 0;
-
-#       ifdef XMRIG_ALGO_CN_HEAVY
-        // cn-heavy optimization for Zen3 CPUs
-        if (m_memory == cn_heavyZen3Memory) {
-            shift = (id() / 8) * m_algorithm.l3() * 8 + (id() % 8) * 64;
-        }
-#       endif
-
-        CnCtx::create(m_ctx, m_memory->scratchpad() + shift, m_algorithm.l3(), N);
+        CnCtx::create(m_ctx, m_memory->scratchpad() + m_scratchpad.offset, m_algorithm.l3(), N);
     }
 }
 
@@ -513,7 +545,9 @@ void xmrig::CpuWorker<N>::consumeJob()
         return;
     }
 
-    auto job = m_miner->job();
+    m_abort.store(false, std::memory_order_relaxed);
+
+    const auto job = m_shard ? m_shard->job(m_miner) : m_miner->jobSnapshot(Nonce::CPU);
 
     constexpr uint32_t count = kReserveCount;
 
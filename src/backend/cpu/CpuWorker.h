@@ -23,10 +23,15 @@
 #include "backend/common/Worker.h"
 #include "backend/common/WorkerJob.h"
 #include "backend/cpu/CpuLaunchData.h"
+#include "backend/cpu/CpuScratchpads.h"
+#include "backend/cpu/CpuShards.h"
 #include "base/tools/Object.h"
 #include "net/JobResult.h"
 
 
+#include <atomic>
+
+
 #ifdef XMRIG_ALGO_RANDOMX
 class randomx_vm;
 #endif
@@ -68,7 +73,7 @@ protected:
 
     inline const VirtualMemory *memory() const override     { return m_memory; }
     inline size_t intensity() const override                { return N; }
-    inline void jobEarlyNotification(const Job&) override   {}
+    inline void jobEarlyNotification(const Job&) override   { m_abort.store(true, std::memory_order_relaxed); }
 
 private:
     inline cn_hash_fun fn(const Algorithm &algorithm) const { return CnHash::fn(algorithm, m_av, m_assembly); }
@@ -84,6 +89,7 @@ private:
     void consumeJob();
 
     alignas(8) uint8_t m_hash[N * 32]{ 0 };
+    std::atomic<bool> m_abort{ false };
     const Algorithm m_algorithm;
     const Assembly m_assembly;
     const bool m_hwAES;
@@ -93,6 +99,8 @@ private:
     const Miner *m_miner;
     const size_t m_threads;
     cryptonight_ctx *m_ctx[N];
+    CpuScratchpads::Slot m_scratchpad;
+    CpuShards::Shard *m_shard = nullptr;
     VirtualMemory *m_memory = nullptr;
     WorkerJob<N> m_job;
 
@@ -3,7 +3,11 @@ set(HEADERS_BACKEND_CPU
     src/backend/cpu/CpuBackend.h
     src/backend/cpu/CpuConfig_gen.h
     src/backend/cpu/CpuConfig.h
+    src/backend/cpu/CpuEfficiency.h
     src/backend/cpu/CpuLaunchData.cpp
+    src/backend/cpu/CpuScratchpads.h
+    src/backend/cpu/CpuShards.h
+    src/backend/cpu/CpuThermal.h
     src/backend/cpu/CpuThread.h
     src/backend/cpu/CpuThreads.h
     src/backend/cpu/CpuWorker.h
@@ -15,7 +19,11 @@ set(SOURCES_BACKEND_CPU
     src/backend/cpu/Cpu.cpp
     src/backend/cpu/CpuBackend.cpp
     src/backend/cpu/CpuConfig.cpp
+    src/backend/cpu/CpuEfficiency.cpp
     src/backend/cpu/CpuLaunchData.h
+    src/backend/cpu/CpuScratchpads.cpp
+    src/backend/cpu/CpuShards.cpp
+    src/backend/cpu/CpuThermal.cpp
     src/backend/cpu/CpuThread.cpp
     src/backend/cpu/CpuThreads.cpp
     src/backend/cpu/CpuWorker.cpp
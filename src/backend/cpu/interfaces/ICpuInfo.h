@@ -111,7 +111,7 @@ public:
     virtual const char *backend() const                                             = 0;
     virtual const char *brand() const                                               = 0;
     virtual const std::vector<int32_t> &units() const                               = 0;
-    virtual CpuThreads threads(const Algorithm &algorithm, uint32_t limit) const    = 0;
+    virtual CpuThreads threads(const Algorithm &algorithm, uint32_t limit, bool eCores) const = 0;
     virtual MsrMod msrMod() const                                                   = 0;
     virtual rapidjson::Value toJSON(rapidjson::Document &doc) const                 = 0;
     virtual size_t cores() const                                                    = 0;
@@ -127,6 +127,7 @@ public:
     virtual bool membind(hwloc_const_bitmap_t nodeset)                              = 0;
     virtual const std::vector<uint32_t> &nodeset() const                            = 0;
     virtual hwloc_topology_t topology() const                                       = 0;
+    virtual size_t eCores() const                                                   = 0;
 #   endif
 };
 
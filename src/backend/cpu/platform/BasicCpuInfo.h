@@ -37,7 +37,7 @@ public:
 
 protected:
     const char *backend() const override;
-    CpuThreads threads(const Algorithm &algorithm, uint32_t limit) const override;
+    CpuThreads threads(const Algorithm &algorithm, uint32_t limit, bool eCores) const override;
     rapidjson::Value toJSON(rapidjson::Document &doc) const override;
 
     inline Arch arch() const override                           { return m_arch; }
@@ -99,7 +99,7 @@ const char *xmrig::BasicCpuInfo::backend() const
 }
 
 
-xmrig::CpuThreads xmrig::BasicCpuInfo::threads(const Algorithm &algorithm, uint32_t) const
+xmrig::CpuThreads xmrig::BasicCpuInfo::threads(const Algorithm &algorithm, uint32_t, bool) const
 {
 #   ifdef XMRIG_ALGO_GHOSTRIDER
     if (algorithm.family() == Algorithm::GHOSTRIDER) {
@@ -23,6 +23,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <hwloc.h>
 
 
@@ -111,6 +112,83 @@ static inline bool isCacheExclusive(hwloc_obj_t obj)
     const char *value = hwloc_obj_get_info_by_name(obj, "Inclusive");
     return value == nullptr || value[0] != '1';
 }
+
+
+static inline bool hasParentCache(hwloc_obj_t obj, unsigned depth)
+{
+    for (hwloc_obj_t parent = obj->parent; parent != nullptr; parent = parent->parent) {
+        if (hwloc_obj_type_is_cache(parent->type) && parent->attr->cache.depth == depth) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+static void processCores(std::vector<hwloc_obj_t> cores, size_t cacheHashes, uint32_t intensity, CpuThreads &threads)
+{
+    size_t PUs = 0;
+    for (hwloc_obj_t core : cores) {
+        PUs += countByType(core, HWLOC_OBJ_PU);
+    }
+
+    if (cacheHashes >= PUs) {
+        for (hwloc_obj_t core : cores) {
+            const std::vector<hwloc_obj_t> units = findByType(core, HWLOC_OBJ_PU);
+            for (hwloc_obj_t pu : units) {
+                threads.add(pu->os_index, intensity);
+            }
+        }
+
+        return;
+    }
+
+    std::vector<std::pair<int64_t, int32_t>> threads_data;
+    threads_data.reserve(cores.size());
+
+    size_t pu_id = 0;
+    while (cacheHashes > 0 && PUs > 0) {
+        bool allocated_pu = false;
+
+        threads_data.clear();
+        for (hwloc_obj_t core : cores) {
+            const std::vector<hwloc_obj_t> units = findByType(core, HWLOC_OBJ_PU);
+            if (units.size() <= pu_id) {
+                continue;
+            }
+
+            cacheHashes--;
+            PUs--;
+
+            allocated_pu = true;
+            threads_data.emplace_back(units[pu_id]->os_index, intensity);
+
+            if (cacheHashes == 0) {
+                break;
+            }
+        }
+
+        // Reversing of "threads_data" and "cores" is done to fill in virtual cores starting from the last one, but still in order
+        // For example, cn-heavy threads on 6-core Zen2/Zen3 will have affinity [0,2,4,6,8,10,9,11]
+        // This is important for Zen3 cn-heavy optimization
+
+        if (pu_id & 1) {
+            std::reverse(threads_data.begin(), threads_data.end());
+        }
+
+        for (const auto& t : threads_data) {
+            threads.add(t.first, t.second);
+        }
+
+        if (!allocated_pu) {
+            break;
+        }
+
+        pu_id++;
+        std::reverse(cores.begin(), cores.end());
+    }
+}
 #endif
 
 
@@ -165,6 +243,8 @@ xmrig::HwlocCpuInfo::HwlocCpuInfo()
     setThreads(countByType(m_topology, HWLOC_OBJ_PU));
 
     m_cores     = countByType(m_topology, HWLOC_OBJ_CORE);
+
+    setCoreKinds();
     m_nodes     = std::max(hwloc_bitmap_weight(hwloc_topology_get_complete_nodeset(m_topology)), 1);
     m_packages  = countByType(m_topology, HWLOC_OBJ_PACKAGE);
 
@@ -187,6 +267,7 @@ xmrig::HwlocCpuInfo::HwlocCpuInfo()
 
 xmrig::HwlocCpuInfo::~HwlocCpuInfo()
 {
+    hwloc_bitmap_free(m_eCoreSet);
     hwloc_topology_destroy(m_topology);
 }
 
@@ -205,11 +286,11 @@ bool xmrig::HwlocCpuInfo::membind(hwloc_const_bitmap_t nodeset)
 }
 
 
-xmrig::CpuThreads xmrig::HwlocCpuInfo::threads(const Algorithm &algorithm, uint32_t limit) const
+xmrig::CpuThreads xmrig::HwlocCpuInfo::threads(const Algorithm &algorithm, uint32_t limit, bool eCores) const
 {
 #   ifndef XMRIG_ARM
     if (L2() == 0 && L3() == 0) {
-        return BasicCpuInfo::threads(algorithm, limit);
+        return BasicCpuInfo::threads(algorithm, limit, eCores);
     }
 
     const unsigned depth = L3() > 0 ? 3 : 2;
@@ -222,13 +303,22 @@ xmrig::CpuThreads xmrig::HwlocCpuInfo::threads(const Algorithm &algorithm, uint3
 
     findCache(hwloc_get_root_obj(m_topology), depth, depth, [&caches](hwloc_obj_t found) { caches.emplace_back(found); });
 
+    if (depth == 3 && m_eCores > 0) {
+        // L2 clusters outside of any L3, for example low power E-cores on Meteor Lake
+        findCache(hwloc_get_root_obj(m_topology), 2, 2, [&caches](hwloc_obj_t found) {
+            if (!hasParentCache(found, 3)) {
+                caches.emplace_back(found);
+            }
+        });
+    }
+
     if (limit > 0 && limit < 100 && !caches.empty()) {
         const double maxTotalThreads = round(m_threads * (limit / 100.0));
         const auto maxPerCache       = std::max(static_cast<int>(round(maxTotalThreads / caches.size())), 1);
         int remaining                = std::max(static_cast<int>(maxTotalThreads), 1);
 
         for (hwloc_obj_t cache : caches) {
-            processTopLevelCache(cache, algorithm, threads, std::min(maxPerCache, remaining));
+            processTopLevelCache(cache, algorithm, threads, std::min(maxPerCache, remaining), eCores);
 
             remaining -= maxPerCache;
             if (remaining <= 0) {
@@ -238,36 +328,51 @@ xmrig::CpuThreads xmrig::HwlocCpuInfo::threads(const Algorithm &algorithm, uint3
     }
     else {
         for (hwloc_obj_t cache : caches) {
-            processTopLevelCache(cache, algorithm, threads, 0);
+            processTopLevelCache(cache, algorithm, threads, 0, eCores);
         }
     }
 
     if (threads.isEmpty()) {
         LOG_WARN("hwloc auto configuration for algorithm \"%s\" failed.", algorithm.name());
 
-        return BasicCpuInfo::threads(algorithm, limit);
+        return BasicCpuInfo::threads(algorithm, limit, eCores);
     }
 
     return threads;
 #   else
-    return allThreads(algorithm, limit);
+    return allThreads(algorithm, limit, eCores);
 #   endif
 }
 
 
-xmrig::CpuThreads xmrig::HwlocCpuInfo::allThreads(const Algorithm &algorithm, uint32_t limit) const
+bool xmrig::HwlocCpuInfo::isECore(hwloc_obj_t core) const
+{
+    return m_eCoreSet != nullptr && hwloc_bitmap_isincluded(core->cpuset, m_eCoreSet);
+}
+
+
+xmrig::CpuThreads xmrig::HwlocCpuInfo::allThreads(const Algorithm &algorithm, uint32_t limit, bool eCores) const
 {
     CpuThreads threads;
     threads.reserve(m_threads);
 
     const uint32_t intensity = (algorithm.family() == Algorithm::GHOSTRIDER) ? 8 : 0;
 
-    for (const int32_t pu : m_units) {
-        threads.add(pu, intensity);
+    // big cores first, so threads dropped from the end of the profile are the little ones
+    for (const bool efficient : { false, true }) {
+        if (efficient && !eCores) {
+            break;
+        }
+
+        for (const int32_t pu : m_units) {
+            if ((m_eCoreSet != nullptr && hwloc_bitmap_isset(m_eCoreSet, static_cast<unsigned>(pu))) == efficient) {
+                threads.add(pu, intensity);
+            }
+        }
     }
 
     if (threads.isEmpty()) {
-        return BasicCpuInfo::threads(algorithm, limit);
+        return BasicCpuInfo::threads(algorithm, limit, eCores);
     }
 
     return threads;
@@ -275,33 +380,42 @@ xmrig::CpuThreads xmrig::HwlocCpuInfo::allThreads(const Algorithm &algorithm, ui
 
 
 
-void xmrig::HwlocCpuInfo::processTopLevelCache(hwloc_obj_t cache, const Algorithm &algorithm, CpuThreads &threads, size_t limit) const
+void xmrig::HwlocCpuInfo::processTopLevelCache(hwloc_obj_t cache, const Algorithm &algorithm, CpuThreads &threads, size_t limit, bool eCores) const
 {
 #   ifndef XMRIG_ARM
     constexpr size_t oneMiB = 1024U * 1024U;
 
-    size_t PUs = countByType(cache, HWLOC_OBJ_PU);
-    if (PUs == 0) {
-        return;
-    }
+    struct Kind
+    {
+        std::vector<hwloc_obj_t> cores;
+        size_t PUs          = 0;
+        size_t L2           = 0;
+        size_t hashes       = 0;
+        uint32_t intensity  = 0;
+    };
 
-    std::vector<hwloc_obj_t> cores;
-    cores.reserve(m_cores);
-    findByType(cache, HWLOC_OBJ_CORE, [&cores](hwloc_obj_t found) { cores.emplace_back(found); });
+    // Performance cores first, so they get the cache and threads dropped from the end of a profile are E-cores
+    Kind kinds[2];
 
-    const bool L3_exclusive = isCacheExclusive(cache);
+    findByType(cache, HWLOC_OBJ_CORE, [this, &kinds](hwloc_obj_t found) { kinds[isECore(found)].cores.emplace_back(found); });
 
-#   ifdef XMRIG_ALGO_GHOSTRIDER
-    if ((algorithm == Algorithm::GHOSTRIDER_RTM || algorithm == Algorithm::GHOSTRIDER_MIKE) && L3_exclusive && (PUs > cores.size()) && (PUs < cores.size() * 2)) {
-        // Don't use E-cores on Alder Lake
-        cores.erase(std::remove_if(cores.begin(), cores.end(), [](hwloc_obj_t c) { return hwloc_bitmap_weight(c->cpuset) == 1; }), cores.end());
+    if (!eCores) {
+        kinds[1].cores.clear();
+    }
 
-        // This shouldn't happen, but check it anyway
-        if (cores.empty()) {
-            findByType(cache, HWLOC_OBJ_CORE, [&cores](hwloc_obj_t found) { cores.emplace_back(found); });
+    for (Kind &kind : kinds) {
+        for (hwloc_obj_t core : kind.cores) {
+            kind.PUs += countByType(core, HWLOC_OBJ_PU);
         }
     }
-#   endif
+
+    size_t PUs          = kinds[0].PUs + kinds[1].PUs;
+    const size_t cores  = kinds[0].cores.size() + kinds[1].cores.size();
+    if (PUs == 0) {
+        return;
+    }
+
+    const bool L3_exclusive = isCacheExclusive(cache);
 
     size_t L3               = cache->attr->cache.size;
     size_t L2               = 0;
@@ -317,6 +431,13 @@ void xmrig::HwlocCpuInfo::processTopLevelCache(hwloc_obj_t cache, const Algorith
                 continue;
             }
 
+            // E-cores share one L2 per cluster, skip clusters which are not used by this profile
+            Kind &kind = kinds[m_eCoreSet != nullptr && hwloc_bitmap_isincluded(l2->cpuset, m_eCoreSet)];
+            if (kind.cores.empty()) {
+                continue;
+            }
+
+            kind.L2 += l2->attr->cache.size;
             L2 += l2->attr->cache.size;
             L2_associativity = l2->attr->cache.associativity;
 
@@ -325,9 +446,13 @@ void xmrig::HwlocCpuInfo::processTopLevelCache(hwloc_obj_t cache, const Algorith
             }
         }
     }
+    else if (m_eCores > 0) {
+        // the top level cache is the L2 cluster itself
+        kinds[kinds[0].cores.empty()].L2 = L3;
+    }
 
     if (scratchpad == 2 * oneMiB) {
-        if (L2 && (cores.size() * oneMiB) == L2 && L2_associativity == 16 && L3 >= L2) {
+        if (L2 && (cores * oneMiB) == L2 && L2_associativity == 16 && L3 >= L2) {
             L3    = L2;
             extra = L2;
         }
@@ -347,84 +472,134 @@ void xmrig::HwlocCpuInfo::processTopLevelCache(hwloc_obj_t cache, const Algorith
 #   endif
 
 #   ifdef XMRIG_ALGO_RANDOMX
-    if ((algorithm.family() == Algorithm::RANDOM_X) && L3_exclusive && (PUs > cores.size()) && (PUs < cores.size() * 2)) {
+    if ((algorithm.family() == Algorithm::RANDOM_X) && L3_exclusive && m_eCores > 0 && cache->attr->cache.depth == 3) {
         // Use all L3+L2 on latest Intel CPUs with P-cores, E-cores and exclusive L3 cache
         cacheHashes = (L3 + L2) / scratchpad;
     }
-    if (extra == 0 && algorithm.l2() > 0) {
-        cacheHashes = std::min<size_t>(std::max<size_t>(L2 / algorithm.l2(), cores.size()), cacheHashes);
-    }
 #   endif
 
     if (limit > 0) {
         cacheHashes = std::min(cacheHashes, limit);
     }
 
+    // both kinds end up in the same profile, P-cores first, each kind with its own intensity
+    kinds[0].intensity = intensity;
+    kinds[1].intensity = std::min<uint32_t>(intensity, 1);
+
 #   ifdef XMRIG_ALGO_GHOSTRIDER
     if (algorithm == Algorithm::GHOSTRIDER_RTM || algorithm == Algorithm::GHOSTRIDER_MIKE) {
         // GhostRider implementation runs 8 hashes at a time
-        intensity = 8;
-        // Always 1 thread per core (it uses additional helper thread when possible)
-        cacheHashes = std::min(cacheHashes, cores.size());
+        kinds[0].intensity = kinds[1].intensity = 8;
     }
 #   endif
 
-    if (cacheHashes >= PUs) {
-        for (hwloc_obj_t core : cores) {
-            const std::vector<hwloc_obj_t> units = findByType(core, HWLOC_OBJ_PU);
-            for (hwloc_obj_t pu : units) {
-                threads.add(pu->os_index, intensity);
+    if (kinds[0].cores.empty() || kinds[1].cores.empty()) {
+        kinds[kinds[0].cores.empty()].hashes = cacheHashes;
+    }
+    else {
+        // Every kind keeps the scratchpads which fit into its own L2 clusters (exclusive L3 only),
+        // the rest of the cache is shared by the number of cores
+        size_t own[2] = {};
+        if (L3_exclusive && cache->attr->cache.depth == 3) {
+            own[0] = std::min(kinds[0].L2 / scratchpad, cacheHashes);
+            own[1] = std::min(kinds[1].L2 / scratchpad, cacheHashes - own[0]);
+        }
+
+        const size_t shared = cacheHashes - own[0] - own[1];
+
+        kinds[1].hashes = own[1] + shared * kinds[1].cores.size() / cores;
+        kinds[0].hashes = cacheHashes - kinds[1].hashes;
+
+        // a kind can't run more threads than it has PUs, give the rest to the other one
+        for (size_t i = 0; i < 2; ++i) {
+            Kind &kind  = kinds[i];
+            Kind &other = kinds[i ^ 1];
+
+            if (kind.hashes > kind.PUs) {
+                other.hashes += kind.hashes - kind.PUs;
+                kind.hashes   = kind.PUs;
             }
         }
+    }
 
-        return;
+    for (Kind &kind : kinds) {
+#       ifdef XMRIG_ALGO_RANDOMX
+        if (extra == 0 && algorithm.l2() > 0) {
+            kind.hashes = std::min<size_t>(std::max<size_t>(kind.L2 / algorithm.l2(), kind.cores.size()), kind.hashes);
+        }
+#       endif
+
+#       ifdef XMRIG_ALGO_GHOSTRIDER
+        if (algorithm == Algorithm::GHOSTRIDER_RTM || algorithm == Algorithm::GHOSTRIDER_MIKE) {
+            // Always 1 thread per core (it uses additional helper thread when possible)
+            kind.hashes = std::min(kind.hashes, kind.cores.size());
+        }
+#       endif
+
+        processCores(kind.cores, kind.hashes, kind.intensity, threads);
     }
+#   endif
+}
 
-    std::vector<std::pair<int64_t, int32_t>> threads_data;
-    threads_data.reserve(cores.size());
 
-    size_t pu_id = 0;
-    while (cacheHashes > 0 && PUs > 0) {
-        bool allocated_pu = false;
+void xmrig::HwlocCpuInfo::setCoreKinds()
+{
+    // PUs of the least performant kind of cores, only on hybrid CPUs
+    m_eCoreSet = hwloc_bitmap_alloc();
 
-        threads_data.clear();
-        for (hwloc_obj_t core : cores) {
-            const std::vector<hwloc_obj_t> units = findByType(core, HWLOC_OBJ_PU);
-            if (units.size() <= pu_id) {
+#   if HWLOC_API_VERSION >= 0x00020400
+    const int kinds = hwloc_cpukinds_get_nr(m_topology, 0);
+    if (kinds > 1) {
+        hwloc_bitmap_t cpuset = hwloc_bitmap_alloc();
+
+        for (int i = 0; i < kinds; ++i) {
+            int efficiency              = -1;
+            unsigned count              = 0;
+            struct hwloc_info_s *infos  = nullptr;
+
+            if (hwloc_cpukinds_get_info(m_topology, static_cast<unsigned>(i), cpuset, &efficiency, &count, &infos, 0) != 0) {
                 continue;
             }
 
-            cacheHashes--;
-            PUs--;
+            // Kinds are ranked by efficiency and 0 is the least performant one, if the ranking is unknown
+            // only the core type reported by Intel CPUs is left
+            bool efficient = efficiency == 0;
 
-            allocated_pu = true;
-            threads_data.emplace_back(units[pu_id]->os_index, intensity);
+            for (unsigned j = 0; efficiency < 0 && j < count; ++j) {
+                efficient |= strcmp(infos[j].name, "CoreType") == 0 && strcmp(infos[j].value, "IntelAtom") == 0;
+            }
 
-            if (cacheHashes == 0) {
-                break;
+            if (efficient) {
+                hwloc_bitmap_or(m_eCoreSet, m_eCoreSet, cpuset);
             }
         }
 
-        // Reversing of "threads_data" and "cores" is done to fill in virtual cores starting from the last one, but still in order
-        // For example, cn-heavy threads on 6-core Zen2/Zen3 will have affinity [0,2,4,6,8,10,9,11]
-        // This is important for Zen3 cn-heavy optimization
-
-        if (pu_id & 1) {
-            std::reverse(threads_data.begin(), threads_data.end());
-        }
+        hwloc_bitmap_free(cpuset);
+    }
+    else if (kinds == 0)
+#   endif
+    {
+#       ifndef XMRIG_ARM
+        // No information from the OS, on Intel hybrid CPUs with Hyper-Threading E-cores are the cores with a single PU
+        const std::vector<hwloc_obj_t> cores = findByType(hwloc_get_root_obj(m_topology), HWLOC_OBJ_CORE);
+        const bool smt = vendor() == VENDOR_INTEL && std::any_of(cores.begin(), cores.end(), [](hwloc_obj_t core) { return hwloc_bitmap_weight(core->cpuset) > 1; });
 
-        for (const auto& t : threads_data) {
-            threads.add(t.first, t.second);
+        for (hwloc_obj_t core : cores) {
+            if (smt && hwloc_bitmap_weight(core->cpuset) == 1) {
+                hwloc_bitmap_or(m_eCoreSet, m_eCoreSet, core->cpuset);
+            }
         }
+#       endif
+    }
 
-        if (!allocated_pu) {
-            break;
-        }
+    if (hwloc_bitmap_iszero(m_eCoreSet) || hwloc_bitmap_isincluded(hwloc_topology_get_topology_cpuset(m_topology), m_eCoreSet)) {
+        hwloc_bitmap_free(m_eCoreSet);
+        m_eCoreSet = nullptr;
 
-        pu_id++;
-        std::reverse(cores.begin(), cores.end());
+        return;
     }
-#   endif
+
+    findByType(hwloc_get_root_obj(m_topology), HWLOC_OBJ_CORE, [this](hwloc_obj_t found) { m_eCores += isECore(found); });
 }
 
 
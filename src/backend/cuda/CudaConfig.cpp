@@ -18,6 +18,7 @@
 
 #include "backend/cuda/CudaConfig.h"
 #include "3rdparty/rapidjson/document.h"
+#include "backend/common/GpuHostCores.h"
 #include "backend/common/Tags.h"
 #include "backend/cuda/CudaConfig_gen.h"
 #include "backend/cuda/wrappers/CudaLib.h"
@@ -92,6 +93,8 @@ std::vector<xmrig::CudaLaunchData> xmrig::CudaConfig::get(const Miner *miner, co
 
     out.reserve(threads.count());
 
+    size_t hostIndex = 0;
+
     for (const auto &thread : threads.data()) {
         const int index = deviceIndex(thread.index());
         if (index == -1) {
@@ -99,7 +102,9 @@ std::vector<xmrig::CudaLaunchData> xmrig::CudaConfig::get(const Miner *miner, co
             continue;
         }
 
-        out.emplace_back(miner, algorithm, thread, devices[static_cast<size_t>(index)]);
+        const int64_t affinity = thread.affinity() >= 0 ? thread.affinity() : GpuHostCores::affinity(hostIndex++);
+
+        out.emplace_back(miner, algorithm, thread, devices[static_cast<size_t>(index)], affinity);
     }
 
     return out;
@@ -21,11 +21,11 @@
 #include "backend/common/Tags.h"
 
 
-xmrig::CudaLaunchData::CudaLaunchData(const Miner *miner, const Algorithm &algorithm, const CudaThread &thread, const CudaDevice &device) :
+xmrig::CudaLaunchData::CudaLaunchData(const Miner *miner, const Algorithm &algorithm, const CudaThread &thread, const CudaDevice &device, int64_t affinity) :
     algorithm(algorithm),
     device(device),
     thread(thread),
-    affinity(thread.affinity()),
+    affinity(affinity),
     miner(miner)
 {
 }
@@ -35,7 +35,8 @@ bool xmrig::CudaLaunchData::isEqual(const CudaLaunchData &other) const
 {
     return (other.algorithm.family() == algorithm.family() &&
             other.algorithm.l3()     == algorithm.l3() &&
-            other.thread             == thread);
+            other.thread             == thread &&
+            other.affinity           == affinity);
 }
 
 
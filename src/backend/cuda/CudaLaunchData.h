@@ -35,7 +35,7 @@ class Miner;
 class CudaLaunchData
 {
 public:
-    CudaLaunchData(const Miner *miner, const Algorithm &algorithm, const CudaThread &thread, const CudaDevice &device);
+    CudaLaunchData(const Miner *miner, const Algorithm &algorithm, const CudaThread &thread, const CudaDevice &device, int64_t affinity);
 
     bool isEqual(const CudaLaunchData &other) const;
 
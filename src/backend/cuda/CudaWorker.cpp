@@ -57,7 +57,7 @@ static inline bool isReady()    { return !Nonce::isPaused() && CudaWorker::ready
 
 
 xmrig::CudaWorker::CudaWorker(size_t id, const CudaLaunchData &data) :
-    GpuWorker(id, data.thread.affinity(), -1, data.device.index()),
+    GpuWorker(id, data.affinity, -1, data.device.index()),
     m_algorithm(data.algorithm),
     m_miner(data.miner)
 {
@@ -171,7 +171,7 @@ bool xmrig::CudaWorker::consumeJob()
         return false;
     }
 
-    m_job.add(m_miner->job(), intensity(), Nonce::CUDA);
+    m_job.add(m_miner->jobSnapshot(Nonce::CUDA), intensity(), Nonce::CUDA);
 
     return m_runner->set(m_job.currentJob(), m_job.blob());
 }
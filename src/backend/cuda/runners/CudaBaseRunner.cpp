@@ -58,7 +58,7 @@ bool xmrig::CudaBaseRunner::init()
 bool xmrig::CudaBaseRunner::set(const Job &job, uint8_t *blob)
 {
     m_height = job.height();
-    m_target = job.target();
+    m_target = job.submitTarget();
 
     return callWrapper(CudaLib::setJob(m_ctx, blob, job.size(), job.algorithm()));
 }
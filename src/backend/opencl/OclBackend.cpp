@@ -28,6 +28,7 @@
 #include "backend/common/Workers.h"
 #include "backend/opencl/OclConfig.h"
 #include "backend/opencl/OclLaunchData.h"
+#include "backend/opencl/OclPrebuild.h"
 #include "backend/opencl/OclWorker.h"
 #include "backend/opencl/runners/tools/OclSharedState.h"
 #include "backend/opencl/wrappers/OclContext.h"
@@ -267,6 +268,7 @@ public:
     OclLaunchStatus status;
     OclPlatform platform;
     std::vector<OclDevice> devices;
+    OclPrebuild prebuild;
     std::vector<OclLaunchData> threads;
     String profileName;
     Workers<OclLaunchData> workers;
@@ -409,8 +411,17 @@ void xmrig::OclBackend::setJob(const Job &job)
         return stop();
     }
 
+    if (cl.isPrebuild()) {
+        d_ptr->prebuild.start(d_ptr->controller->miner(), cl, d_ptr->platform, d_ptr->devices);
+    }
+
     auto threads = cl.get(d_ptr->controller->miner(), job.algorithm(), d_ptr->platform, d_ptr->devices);
     if (!d_ptr->threads.empty() && d_ptr->threads.size() == threads.size() && std::equal(d_ptr->threads.begin(), d_ptr->threads.end(), threads.begin())) {
+#       ifdef XMRIG_ALGO_RANDOMX
+        // start copying the new dataset while the workers still finish their batches
+        OclSharedState::uploadDataset(job);
+#       endif
+
         return;
     }
 
@@ -504,6 +515,12 @@ rapidjson::Value xmrig::OclBackend::toJSON(rapidjson::Document &doc) const
         thread.AddMember("affinity", data.affinity, allocator);
         thread.AddMember("hashrate", hashrate()->toJSON(i, doc), allocator);
 
+        const auto stats = OclSharedState::get(data.device.index()).batchStats(i);
+        Value batch(kObjectType);
+        batch.AddMember("latency",  static_cast<uint64_t>(stats.latency), allocator);
+        batch.AddMember("wait",     static_cast<uint64_t>(stats.wait), allocator);
+        thread.AddMember("batch", batch, allocator);
+
         data.device.toJSON(thread, doc);
 
         i++;
@@ -16,19 +16,29 @@
  *   along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+#include <cinttypes>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
 #include <fstream>
 #include <map>
 #include <mutex>
+#include <set>
 #include <sstream>
+#include <uv.h>
 
 
 #include "backend/opencl/OclCache.h"
 #include "3rdparty/base32/base32.h"
+#include "3rdparty/rapidjson/document.h"
 #include "backend/common/Tags.h"
 #include "backend/opencl/interfaces/IOclRunner.h"
 #include "backend/opencl/OclLaunchData.h"
 #include "backend/opencl/wrappers/OclLib.h"
 #include "base/crypto/keccak.h"
+#include "base/io/json/Json.h"
 #include "base/io/log/Log.h"
 #include "base/tools/Chrono.h"
 
@@ -36,7 +46,33 @@
 namespace xmrig {
 
 
+static const char *kBinExt      = ".bin";
+static const char *kIndex       = "index.json";
+static const char *kSize        = "size";
+static const char *kUsed        = "used";
+
+
+struct CacheEntry
+{
+    uint64_t size   = 0;
+    int64_t used    = 0;
+};
+
+
+static bool indexLoaded = false;
+static std::condition_variable cv;
+static std::map<const char *, std::string> sources;
+static std::map<std::string, CacheEntry> entries;
 static std::mutex mutex;
+static std::set<std::string> building;
+
+
+static uint64_t fileSize(const std::string &fileName)
+{
+    std::ifstream file(fileName, std::ifstream::in | std::ifstream::binary | std::ifstream::ate);
+
+    return file.good() ? static_cast<uint64_t>(file.tellg()) : 0;
+}
 
 
 static cl_program createFromSource(const IOclRunner *runner)
@@ -103,31 +139,58 @@ static cl_program createFromBinary(const IOclRunner *runner, const std::string &
 
 cl_program xmrig::OclCache::build(const IOclRunner *runner)
 {
-    std::lock_guard<std::mutex> lock(mutex);
-
     if (Nonce::sequence(Nonce::OPENCL) == 0) {
         return nullptr;
     }
 
-    std::string fileName;
-    if (runner->data().cache) {
-#       ifdef _WIN32
-        fileName = prefix() + "\\xmrig\\.cache\\" + cacheKey(runner) + ".bin";
-#       else
-        fileName = prefix() + "/.cache/" + cacheKey(runner) + ".bin";
-#       endif
+    if (!runner->data().cache) {
+        return createFromSource(runner);
+    }
+
+    const std::string key       = cacheKey(runner);
+    const std::string fileName  = path(key + kBinExt);
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+
+        // the same program is already being compiled by another thread, its binary is loaded when it is done
+        cv.wait(lock, [&key] { return building.count(key) == 0; });
+
+        building.insert(key);
+        loadIndex();
+    }
+
+    cl_program program = createFromBinary(runner, fileName);
+    const bool loaded  = program != nullptr;
+
+    if (!loaded) {
+        program = createFromSource(runner);
 
-        cl_program program = createFromBinary(runner, fileName);
         if (program) {
-            return program;
+            save(program, fileName);
         }
     }
 
-    cl_program program = createFromSource(runner);
-    if (runner->data().cache && program) {
-        save(program, fileName);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        if (program) {
+            auto &entry = entries[key];
+            entry.used  = static_cast<int64_t>(time(nullptr));
+
+            if (!loaded || entry.size == 0) {
+                entry.size = fileSize(fileName);
+            }
+
+            evict(runner->data().cacheSize, key);
+            saveIndex();
+        }
+
+        building.erase(key);
     }
 
+    cv.notify_all();
+
     return program;
 }
 
@@ -150,7 +213,113 @@ std::string xmrig::OclCache::cacheKey(const char *deviceKey, const char *options
 
 std::string xmrig::OclCache::cacheKey(const IOclRunner *runner)
 {
-    return cacheKey(runner->deviceKey(), runner->buildOptions(), runner->source());
+    // sources are built into the binary, so each of them is hashed only once per process
+    std::string source;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        auto it = sources.find(runner->source());
+        if (it == sources.end()) {
+            it = sources.emplace(runner->source(), cacheKey("", "", runner->source())).first;
+        }
+
+        source = it->second;
+    }
+
+    return cacheKey(runner->deviceKey(), runner->buildOptions(), source.c_str());
+}
+
+
+std::string xmrig::OclCache::path(const std::string &name)
+{
+#   ifdef _WIN32
+    return prefix() + "\\xmrig\\.cache\\" + name;
+#   else
+    return prefix() + "/.cache/" + name;
+#   endif
+}
+
+
+void xmrig::OclCache::evict(size_t limit, const std::string &keep)
+{
+    if (limit == 0) {
+        return;
+    }
+
+    uint64_t total = 0;
+    for (const auto &kv : entries) {
+        total += kv.second.size;
+    }
+
+    while (total > limit) {
+        auto lru = entries.end();
+
+        for (auto it = entries.begin(); it != entries.end(); ++it) {
+            if (it->first != keep && building.count(it->first) == 0 && (lru == entries.end() || it->second.used < lru->second.used)) {
+                lru = it;
+            }
+        }
+
+        if (lru == entries.end()) {
+            break;
+        }
+
+        LOG_VERBOSE("%s " YELLOW("evict cached program ") WHITE_BOLD("%s") BLACK_BOLD(" (%" PRIu64 " KB)"), ocl_tag(), lru->first.c_str(), lru->second.size / 1024);
+
+        std::remove(path(lru->first + kBinExt).c_str());
+
+        total -= lru->second.size;
+        entries.erase(lru);
+    }
+}
+
+
+void xmrig::OclCache::loadIndex()
+{
+    if (indexLoaded) {
+        return;
+    }
+
+    indexLoaded = true;
+
+    using namespace rapidjson;
+
+    Document doc;
+    if (Json::get(path(kIndex).c_str(), doc) && doc.IsObject()) {
+        for (auto it = doc.MemberBegin(); it != doc.MemberEnd(); ++it) {
+            CacheEntry entry;
+            entry.size = Json::getUint64(it->value, kSize);
+            entry.used = Json::getInt64(it->value, kUsed);
+
+            entries.emplace(it->name.GetString(), entry);
+        }
+
+        return;
+    }
+
+    // no index yet, adopt binaries left by previous versions so they can be evicted too
+    uv_fs_t req;
+    const std::string dir = path("");
+
+    if (uv_fs_scandir(uv_default_loop(), &req, dir.c_str(), 0, nullptr) > 0) {
+        const size_t extSize = strlen(kBinExt);
+        uv_dirent_t ent;
+
+        while (uv_fs_scandir_next(&req, &ent) != UV_EOF) {
+            const std::string name = ent.name;
+            if (ent.type != UV_DIRENT_FILE || name.size() <= extSize || name.compare(name.size() - extSize, extSize, kBinExt) != 0) {
+                continue;
+            }
+
+            CacheEntry entry;
+            entry.size = fileSize(dir + name);
+
+            entries.emplace(name.substr(0, name.size() - extSize), entry);
+        }
+    }
+
+    uv_fs_req_cleanup(&req);
 }
 
 
@@ -170,8 +339,48 @@ void xmrig::OclCache::save(cl_program program, const std::string &fileName)
 
     createDirectory();
 
+    // write to a temporary file first, so a concurrent reader or a crash never sees a partial binary
+    const std::string tmp = fileName + ".tmp";
+
     std::ofstream file_stream;
-    file_stream.open(fileName, std::ofstream::out | std::ofstream::binary);
+    file_stream.open(tmp, std::ofstream::out | std::ofstream::binary);
     file_stream.write(binary.data(), static_cast<int64_t>(binary.size()));
     file_stream.close();
+
+    replace(tmp, fileName);
+}
+
+
+void xmrig::OclCache::saveIndex()
+{
+    using namespace rapidjson;
+
+    Document doc(kObjectType);
+    auto &allocator = doc.GetAllocator();
+
+    for (const auto &kv : entries) {
+        Value entry(kObjectType);
+        entry.AddMember(StringRef(kSize), kv.second.size, allocator);
+        entry.AddMember(StringRef(kUsed), kv.second.used, allocator);
+
+        doc.AddMember(Value(kv.first.c_str(), allocator), entry, allocator);
+    }
+
+    createDirectory();
+
+    const std::string fileName = path(kIndex);
+    const std::string tmp      = fileName + ".tmp";
+
+    if (Json::save(tmp.c_str(), doc)) {
+        replace(tmp, fileName);
+    }
+}
+
+
+void xmrig::OclCache::replace(const std::string &from, const std::string &to)
+{
+    if (std::rename(from.c_str(), to.c_str()) != 0) {
+        std::remove(to.c_str());
+        std::rename(from.c_str(), to.c_str());
+    }
 }
@@ -32,6 +32,13 @@ namespace xmrig {
 class IOclRunner;
 
 
+/**
+ * Program binaries are cached on disk, one file per device/options/source combination.
+ *
+ * Builds of different programs run in parallel, a thread which needs a program already being compiled elsewhere
+ * waits and loads the fresh binary instead. The cache directory is bounded by size, the least recently used
+ * binaries are evicted, usage is tracked in an index file next to them.
+ */
 class OclCache
 {
 public:
@@ -40,9 +47,14 @@ public:
     static std::string cacheKey(const IOclRunner *runner);
 
 private:
+    static std::string path(const std::string &name);
     static std::string prefix();
     static void createDirectory();
+    static void evict(size_t limit, const std::string &keep);
+    static void loadIndex();
+    static void replace(const std::string &from, const std::string &to);
     static void save(cl_program program, const std::string &fileName);
+    static void saveIndex();
 };
 
 
@@ -18,6 +18,7 @@
 
 #include "backend/opencl/OclConfig.h"
 #include "3rdparty/rapidjson/document.h"
+#include "backend/common/GpuHostCores.h"
 #include "backend/common/Tags.h"
 #include "backend/opencl/OclConfig_gen.h"
 #include "backend/opencl/wrappers/OclLib.h"
@@ -29,6 +30,8 @@ namespace xmrig {
 
 
 static const char *kCache       = "cache";
+static const char *kCacheSize   = "cache-size";
+static const char *kPrebuild    = "cache-prebuild";
 static const char *kDevicesHint = "devices-hint";
 static const char *kEnabled     = "enabled";
 static const char *kLoader      = "loader";
@@ -110,6 +113,8 @@ rapidjson::Value xmrig::OclConfig::toJSON(rapidjson::Document &doc) const
 
     obj.AddMember(StringRef(kEnabled),  m_enabled, allocator);
     obj.AddMember(StringRef(kCache),    m_cache, allocator);
+    obj.AddMember(StringRef(kCacheSize), m_cacheSize, allocator);
+    obj.AddMember(StringRef(kPrebuild), m_prebuild, allocator);
     obj.AddMember(StringRef(kLoader),   m_loader.toJSON(), allocator);
 
 #   ifndef XMRIG_OS_APPLE
@@ -137,6 +142,10 @@ std::vector<xmrig::OclLaunchData> xmrig::OclConfig::get(const Miner *miner, cons
 
     out.reserve(threads.count() * 2);
 
+    // host threads without an explicit affinity go to the cores reserved by the CPU backend
+    size_t index = 0;
+    auto hostAffinity = [&index](int64_t affinity) { return affinity >= 0 ? affinity : GpuHostCores::affinity(index++); };
+
     for (const auto &thread : threads.data()) {
         if (thread.index() >= devices.size()) {
             LOG_INFO("%s" YELLOW(" skip non-existing device with index ") YELLOW_BOLD("%u"), ocl_tag(), thread.index());
@@ -145,11 +154,11 @@ std::vector<xmrig::OclLaunchData> xmrig::OclConfig::get(const Miner *miner, cons
 
         if (thread.threads().size() > 1) {
             for (int64_t affinity : thread.threads()) {
-                out.emplace_back(miner, algorithm, *this, platform, thread, devices[thread.index()], affinity);
+                out.emplace_back(miner, algorithm, *this, platform, thread, devices[thread.index()], hostAffinity(affinity));
             }
         }
         else {
-            out.emplace_back(miner, algorithm, *this, platform, thread, devices[thread.index()], thread.threads().front());
+            out.emplace_back(miner, algorithm, *this, platform, thread, devices[thread.index()], hostAffinity(thread.threads().front()));
         }
     }
 
@@ -162,6 +171,8 @@ void xmrig::OclConfig::read(const rapidjson::Value &value)
     if (value.IsObject()) {
         m_enabled   = Json::getBool(value, kEnabled, m_enabled);
         m_cache     = Json::getBool(value, kCache, m_cache);
+        m_cacheSize = Json::getUint(value, kCacheSize, m_cacheSize);
+        m_prebuild  = Json::getBool(value, kPrebuild, m_prebuild);
         m_loader    = Json::getString(value, kLoader);
 
 #       ifndef XMRIG_OS_APPLE
@@ -41,9 +41,11 @@ public:
 
     inline bool isCacheEnabled() const                  { return m_cache; }
     inline bool isEnabled() const                       { return m_enabled; }
+    inline bool isPrebuild() const                      { return m_prebuild; }
     inline bool isShouldSave() const                    { return m_shouldSave; }
     inline const String &loader() const                 { return m_loader; }
     inline const Threads<OclThreads> &threads() const   { return m_threads; }
+    inline size_t cacheSize() const                     { return static_cast<size_t>(m_cacheSize) * 1024 * 1024; }
 
 #   ifdef XMRIG_FEATURE_ADL
     inline bool isAdlEnabled() const                    { return m_adl; }
@@ -55,9 +57,11 @@ private:
 
     bool m_cache         = true;
     bool m_enabled       = false;
+    bool m_prebuild      = false;
     bool m_shouldSave    = false;
     std::vector<uint32_t> m_devicesHint;
     String m_loader;
+    uint32_t m_cacheSize = 256;
     Threads<OclThreads> m_threads;
 
 #   ifndef XMRIG_OS_APPLE
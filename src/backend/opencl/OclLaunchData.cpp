@@ -32,6 +32,7 @@
 xmrig::OclLaunchData::OclLaunchData(const Miner *miner, const Algorithm &algorithm, const OclConfig &config, const OclPlatform &platform, const OclThread &thread, const OclDevice &device, int64_t affinity) :
     algorithm(algorithm),
     cache(config.isCacheEnabled()),
+    cacheSize(config.cacheSize()),
     affinity(affinity),
     miner(miner),
     device(device),
@@ -44,7 +45,8 @@ xmrig::OclLaunchData::OclLaunchData(const Miner *miner, const Algorithm &algorit
 bool xmrig::OclLaunchData::isEqual(const OclLaunchData &other) const
 {
     return (other.algorithm == algorithm &&
-            other.thread    == thread);
+            other.thread    == thread &&
+            other.affinity  == affinity);
 }
 
 
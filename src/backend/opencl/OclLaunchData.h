@@ -62,6 +62,7 @@ public:
     cl_context ctx = nullptr;
     const Algorithm algorithm;
     const bool cache;
+    const size_t cacheSize;     // upper limit of the program binary cache in bytes, 0 means no limit
     const int64_t affinity;
     const Miner *miner;
     const OclDevice device;
@@ -0,0 +1,110 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "backend/opencl/OclPrebuild.h"
+#include "backend/common/Tags.h"
+#include "backend/opencl/interfaces/IOclRunner.h"
+#include "backend/opencl/OclCache.h"
+#include "backend/opencl/OclConfig.h"
+#include "backend/opencl/OclWorker.h"
+#include "backend/opencl/wrappers/OclLib.h"
+#include "base/io/log/Log.h"
+#include "base/tools/Chrono.h"
+
+
+#include <algorithm>
+#include <cinttypes>
+#include <set>
+
+
+xmrig::OclPrebuild::~OclPrebuild()
+{
+    m_stop = true;
+
+    for (auto &thread : m_threads) {
+        thread.join();
+    }
+
+    for (auto runner : m_runners) {
+        delete runner;
+    }
+}
+
+
+void xmrig::OclPrebuild::start(const Miner *miner, const OclConfig &config, const OclPlatform &platform, const std::vector<OclDevice> &devices)
+{
+    if (isStarted() || !config.isCacheEnabled()) {
+        return;
+    }
+
+    // CN/R and KawPow programs depend on the block height and are compiled on demand, their runners also own global state
+    const auto algorithms = Algorithm::all([&config](const Algorithm &algorithm) {
+        return algorithm != Algorithm::CN_R && algorithm.family() != Algorithm::KAWPOW && algorithm.family() != Algorithm::ARGON2 && !config.threads().get(algorithm).isEmpty();
+    });
+
+    std::set<std::string> keys;
+
+    for (const auto &algorithm : algorithms) {
+        m_data.emplace_back(config.get(miner, algorithm, platform, devices));
+
+        auto &threads = m_data.back();
+        if (threads.empty() || !m_context.init(devices, threads)) {
+            continue;
+        }
+
+        for (const auto &data : threads) {
+            IOclRunner *runner = OclWorker::createRunner(m_runners.size(), data);
+            if (!runner) {
+                continue;
+            }
+
+            if (keys.insert(OclCache::cacheKey(runner)).second) {
+                m_runners.emplace_back(runner);
+            }
+            else {
+                delete runner;
+            }
+        }
+    }
+
+    if (m_runners.empty()) {
+        return;
+    }
+
+    const size_t count = std::min<size_t>(m_runners.size(), std::max(1U, std::thread::hardware_concurrency() / 2));
+    m_ts               = Chrono::steadyMSecs();
+
+    LOG_INFO("%s " WHITE_BOLD("prebuild ") CYAN_BOLD("%zu") WHITE_BOLD(" programs for ") CYAN_BOLD("%zu") WHITE_BOLD(" algorithms") BLACK_BOLD(" (%zu threads)"),
+             ocl_tag(), m_runners.size(), algorithms.size(), count);
+
+    for (size_t i = 0; i < count; ++i) {
+        m_threads.emplace_back(&OclPrebuild::onThread, this);
+    }
+}
+
+
+void xmrig::OclPrebuild::onThread()
+{
+    for (size_t i = m_next++; i < m_runners.size() && !m_stop; i = m_next++) {
+        OclLib::release(OclCache::build(m_runners[i]));
+
+        if (++m_done == m_runners.size()) {
+            LOG_INFO("%s " GREEN_BOLD("prebuild completed") BLACK_BOLD(" (%" PRIu64 " ms)"), ocl_tag(), Chrono::steadyMSecs() - m_ts);
+        }
+    }
+}
@@ -0,0 +1,74 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_OCLPREBUILD_H
+#define XMRIG_OCLPREBUILD_H
+
+
+#include "backend/opencl/OclLaunchData.h"
+#include "backend/opencl/wrappers/OclContext.h"
+#include "base/tools/Object.h"
+
+
+#include <atomic>
+#include <list>
+#include <thread>
+#include <vector>
+
+
+namespace xmrig {
+
+
+class IOclRunner;
+class OclConfig;
+
+
+/**
+ * Compiles the programs of all configured algorithms on a small thread pool in the background,
+ * so the binary cache is warm before the first switch to any of them.
+ */
+class OclPrebuild
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE(OclPrebuild)
+
+    OclPrebuild() = default;
+    ~OclPrebuild();
+
+    inline bool isStarted() const { return !m_threads.empty(); }
+
+    void start(const Miner *miner, const OclConfig &config, const OclPlatform &platform, const std::vector<OclDevice> &devices);
+
+private:
+    void onThread();
+
+    OclContext m_context;
+    std::atomic<bool> m_stop{false};
+    std::atomic<size_t> m_done{0};
+    std::atomic<size_t> m_next{0};
+    std::list<std::vector<OclLaunchData> > m_data;
+    std::vector<IOclRunner *> m_runners;
+    std::vector<std::thread> m_threads;
+    uint64_t m_ts = 0;
+};
+
+
+} // namespace xmrig
+
+
+#endif /* XMRIG_OCLPREBUILD_H */
@@ -42,7 +42,9 @@
 #   include "backend/opencl/runners/OclKawPowRunner.h"
 #endif
 
+#include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <thread>
 
 
@@ -55,6 +57,14 @@ std::atomic<bool> OclWorker::ready;
 static inline bool isReady()    { return !Nonce::isPaused() && OclWorker::ready; }
 
 
+static inline uint64_t steadyUSecs()
+{
+    using namespace std::chrono;
+
+    return static_cast<uint64_t>(time_point_cast<microseconds>(steady_clock::now()).time_since_epoch().count());
+}
+
+
 static inline void printError(size_t id, const char *error)
 {
     LOG_ERR("%s" RED_S " thread " RED_BOLD("#%zu") RED_S " failed with error " RED_BOLD("%s"), ocl_tag(), id, error);
@@ -71,40 +81,7 @@ xmrig::OclWorker::OclWorker(size_t id, const OclLaunchData &data) :
     m_miner(data.miner),
     m_sharedData(OclSharedState::get(data.device.index()))
 {
-    switch (m_algorithm.family()) {
-    case Algorithm::RANDOM_X:
-#       ifdef XMRIG_ALGO_RANDOMX
-        if (data.thread.isAsm() && data.device.vendorId() == OCL_VENDOR_AMD) {
-            m_runner = new OclRxJitRunner(id, data);
-        }
-        else {
-            m_runner = new OclRxVmRunner(id, data);
-        }
-#       endif
-        break;
-
-    case Algorithm::ARGON2:
-#       ifdef XMRIG_ALGO_ARGON2
-        m_runner = nullptr;
-#       endif
-        break;
-
-    case Algorithm::KAWPOW:
-#       ifdef XMRIG_ALGO_KAWPOW
-        m_runner = new OclKawPowRunner(id, data);
-#       endif
-        break;
-
-    default:
-#       ifdef XMRIG_ALGO_CN_GPU
-        if (m_algorithm == Algorithm::CN_GPU) {
-            m_runner = new OclCnGpuRunner(id, data);
-        }
-        else
-#       endif
-        m_runner = new OclCnRunner(id, data);
-        break;
-    }
+    m_runner = createRunner(id, data);
 
     if (!m_runner) {
         return;
@@ -129,6 +106,44 @@ xmrig::OclWorker::~OclWorker()
 }
 
 
+xmrig::IOclRunner *xmrig::OclWorker::createRunner(size_t id, const OclLaunchData &data)
+{
+    switch (data.algorithm.family()) {
+    case Algorithm::RANDOM_X:
+#       ifdef XMRIG_ALGO_RANDOMX
+        if (data.thread.isAsm() && data.device.vendorId() == OCL_VENDOR_AMD) {
+            return new OclRxJitRunner(id, data);
+        }
+
+        return new OclRxVmRunner(id, data);
+#       else
+        return nullptr;
+#       endif
+
+    case Algorithm::ARGON2:
+        return nullptr;
+
+    case Algorithm::KAWPOW:
+#       ifdef XMRIG_ALGO_KAWPOW
+        return new OclKawPowRunner(id, data);
+#       else
+        return nullptr;
+#       endif
+
+    default:
+        break;
+    }
+
+#   ifdef XMRIG_ALGO_CN_GPU
+    if (data.algorithm == Algorithm::CN_GPU) {
+        return new OclCnGpuRunner(id, data);
+    }
+#   endif
+
+    return new OclCnRunner(id, data);
+}
+
+
 void xmrig::OclWorker::jobEarlyNotification(const Job &job)
 {
     if (m_runner) {
@@ -151,8 +166,6 @@ size_t xmrig::OclWorker::intensity() const
 
 void xmrig::OclWorker::start()
 {
-    cl_uint results[0x100];
-
     while (Nonce::sequence(Nonce::OPENCL) > 0) {
         if (!isReady()) {
             m_sharedData.setResumeCounter(0);
@@ -173,13 +186,18 @@ void xmrig::OclWorker::start()
             }
         }
 
+        // Keep up to kMaxBatches rounds queued on the device, the next round is enqueued
+        // before the results of the previous one are read back, so the GPU never idles on the host.
         while (!Nonce::isOutdated(Nonce::OPENCL, m_job.sequence())) {
             m_sharedData.adjustDelay(id());
 
-            const uint64_t t = Chrono::steadyMSecs();
+            auto &slot  = m_inFlight[(m_inFlightHead + m_runner->pending()) % OclBaseRunner::kMaxBatches];
+            slot.ts     = Chrono::steadyMSecs();
+            slot.start  = steadyUSecs();
+            slot.job    = m_job.nonceSize() == sizeof(uint64_t) ? std::make_shared<const Job>(m_job.currentJob()) : nullptr;
 
             try {
-                m_runner->run(readUnaligned(m_job.nonce()), results);
+                m_runner->enqueue(readUnaligned(m_job.nonce()));
             }
             catch (std::exception &ex) {
                 printError(id(), ex.what());
@@ -187,15 +205,14 @@ void xmrig::OclWorker::start()
                 return;
             }
 
-            if (results[0xFF] > 0) {
-                JobResults::submit(m_job.currentJob(), results, results[0xFF], m_deviceIndex);
-            }
-
             if (!Nonce::isOutdated(Nonce::OPENCL, m_job.sequence()) && !m_job.nextRound(1, intensity())) {
                 JobResults::done(m_job.currentJob());
             }
 
-            storeStats(t);
+            if (m_runner->pending() == OclBaseRunner::kMaxBatches && !collect()) {
+                return;
+            }
+
             std::this_thread::yield();
         }
 
@@ -206,13 +223,75 @@ void xmrig::OclWorker::start()
 }
 
 
+bool xmrig::OclWorker::collect()
+{
+    cl_uint results[0x100];
+    InFlight &slot = m_inFlight[m_inFlightHead];
+    m_inFlightHead = (m_inFlightHead + 1) % OclBaseRunner::kMaxBatches;
+
+    const uint64_t waitStart = steadyUSecs();
+
+    try {
+        m_runner->read(results);
+    }
+    catch (std::exception &ex) {
+        printError(id(), ex.what());
+
+        return false;
+    }
+
+    // a queued batch only starts on the device once the previous one is done, not when it was enqueued
+    const uint64_t now   = steadyUSecs();
+    const uint64_t start = std::max(slot.start, m_doneUs);
+    const uint64_t ts    = std::max(slot.ts, m_doneTs);
+
+    m_doneUs = now;
+    m_doneTs = Chrono::steadyMSecs();
+    m_sharedData.setBatchTime(id(), now - start, now - waitStart);
+
+    if (results[0xFF] > 0) {
+        JobResults::submit(slot.job ? *slot.job : m_job.currentJob(), results, results[0xFF], m_deviceIndex);
+    }
+
+    slot.job.reset();
+    storeStats(ts);
+
+    return true;
+}
+
+
 bool xmrig::OclWorker::consumeJob()
 {
     if (Nonce::sequence(Nonce::OPENCL) == 0) {
         return false;
     }
 
-    m_job.add(m_miner->job(), intensity(), Nonce::OPENCL);
+    const auto job = m_miner->jobSnapshot(Nonce::OPENCL);
+
+    if (job && m_runner->pending() > 0 && !job->isEqualBlob(m_job.currentJob())) {
+        // a new blob makes the batches still in flight useless, they are cancelled and their results discarded
+        for (size_t i = 0; i < m_runner->pending(); ++i) {
+            m_inFlight[m_inFlightHead].job.reset();
+            m_inFlightHead = (m_inFlightHead + 1) % OclBaseRunner::kMaxBatches;
+        }
+
+        m_runner->cancel();
+
+        m_doneUs = steadyUSecs();
+        m_doneTs = Chrono::steadyMSecs();
+    }
+    else {
+        // same blob, e.g. only the difficulty has changed: the batches finish and their results are submitted
+        // for the job they were enqueued with when collected by the next rounds
+        for (size_t i = 0; i < m_runner->pending(); ++i) {
+            auto &slot = m_inFlight[(m_inFlightHead + i) % OclBaseRunner::kMaxBatches];
+            if (!slot.job) {
+                slot.job = std::make_shared<const Job>(m_job.currentJob());
+            }
+        }
+    }
+
+    m_job.add(job, intensity(), Nonce::OPENCL);
 
     try {
         m_runner->set(m_job.currentJob(), m_job.blob());
@@ -23,6 +23,7 @@
 #include "backend/common/GpuWorker.h"
 #include "backend/common/WorkerJob.h"
 #include "backend/opencl/OclLaunchData.h"
+#include "backend/opencl/runners/OclBaseRunner.h"
 #include "base/tools/Object.h"
 #include "net/JobResult.h"
 
@@ -45,6 +46,8 @@ public:
 
     void jobEarlyNotification(const Job &job) override;
 
+    static IOclRunner *createRunner(size_t id, const OclLaunchData &data);
+
     static std::atomic<bool> ready;
 
 protected:
@@ -53,9 +56,22 @@ protected:
     void start() override;
 
 private:
+    struct InFlight
+    {
+        std::shared_ptr<const Job> job;     // snapshot of jobs with 64-bit nonce, their upper half moves on every round
+        uint64_t ts     = 0;
+        uint64_t start  = 0;
+    };
+
+    bool collect();
     bool consumeJob();
     void storeStats(uint64_t ts);
 
+    InFlight m_inFlight[OclBaseRunner::kMaxBatches];
+    size_t m_inFlightHead = 0;
+    uint64_t m_doneTs     = 0;
+    uint64_t m_doneUs     = 0;
+
     const Algorithm m_algorithm;
     const Miner *m_miner;
     IOclRunner *m_runner = nullptr;
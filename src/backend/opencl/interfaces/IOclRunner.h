@@ -58,12 +58,16 @@ public:
     virtual const char *source() const                      = 0;
     virtual const OclLaunchData &data() const               = 0;
     virtual size_t intensity() const                        = 0;
+    virtual size_t pending() const                          = 0;
     virtual size_t threadId() const                         = 0;
     virtual uint32_t roundSize() const                      = 0;
     virtual uint32_t processedHashes() const                = 0;
     virtual uint32_t deviceIndex() const                    = 0;
     virtual void build()                                    = 0;
+    virtual void cancel()                                   = 0;
+    virtual void enqueue(uint32_t nonce)                    = 0;
     virtual void init()                                     = 0;
+    virtual void read(uint32_t *hashOutput)                 = 0;
     virtual void run(uint32_t nonce, uint32_t *hashOutput)  = 0;
     virtual void set(const Job &job, uint8_t *blob)         = 0;
     virtual void jobEarlyNotification(const Job&)           = 0;
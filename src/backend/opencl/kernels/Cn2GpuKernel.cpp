@@ -47,6 +47,12 @@ void xmrig::Cn2GpuKernel::setArgs(cl_mem scratchpads, cl_mem states, cl_mem outp
 }
 
 
+void xmrig::Cn2GpuKernel::setOutput(cl_mem output)
+{
+    setArg(2, sizeof(cl_mem), &output);
+}
+
+
 void xmrig::Cn2GpuKernel::setTarget(uint64_t target)
 {
     setArg(3, sizeof(cl_ulong), &target);
@@ -39,6 +39,7 @@ public:
 
     void enqueue(cl_command_queue queue, uint32_t nonce, size_t threads);
     void setArgs(cl_mem scratchpads, cl_mem states, cl_mem output, uint32_t threads);
+    void setOutput(cl_mem output);
     void setTarget(uint64_t target);
 };
 
@@ -61,6 +61,12 @@ void xmrig::CnBranchKernel::setArgs(cl_mem states, cl_mem branch, cl_mem output,
 }
 
 
+void xmrig::CnBranchKernel::setOutput(cl_mem output)
+{
+    setArg(2, sizeof(cl_mem), &output);
+}
+
+
 void xmrig::CnBranchKernel::setTarget(uint64_t target)
 {
     setArg(3, sizeof(cl_ulong), &target);
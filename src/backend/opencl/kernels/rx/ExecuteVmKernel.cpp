@@ -47,6 +47,12 @@ void xmrig::ExecuteVmKernel::setArgs(cl_mem vm_states, cl_mem rounding, cl_mem s
 }
 
 
+void xmrig::ExecuteVmKernel::setDataset(cl_mem dataset_ptr)
+{
+    setArg(3, sizeof(cl_mem), &dataset_ptr);
+}
+
+
 void xmrig::ExecuteVmKernel::setFirst(uint32_t first)
 {
     setArg(6, sizeof(uint32_t), &first);
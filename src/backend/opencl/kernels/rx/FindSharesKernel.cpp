@@ -44,6 +44,12 @@ void xmrig::FindSharesKernel::setArgs(cl_mem hashes, cl_mem shares)
 }
 
 
+void xmrig::FindSharesKernel::setOutput(cl_mem output)
+{
+    setArg(3, sizeof(cl_mem), &output);
+}
+
+
 void xmrig::FindSharesKernel::setTarget(uint64_t target)
 {
     setArg(1, sizeof(uint64_t), &target);
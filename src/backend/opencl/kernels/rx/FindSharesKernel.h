@@ -39,6 +39,7 @@ public:
 
     void enqueue(cl_command_queue queue, size_t threads);
     void setArgs(cl_mem hashes, cl_mem shares);
+    void setOutput(cl_mem output);
     void setTarget(uint64_t target);
     void setNonce(uint32_t nonce);
 };
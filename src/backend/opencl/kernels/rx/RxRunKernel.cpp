@@ -66,3 +66,9 @@ void xmrig::RxRunKernel::setArgs(cl_mem dataset, cl_mem scratchpads, cl_mem regi
 
     setArg(6, sizeof(uint32_t), &rx_parameters);
 }
+
+
+void xmrig::RxRunKernel::setDataset(cl_mem dataset)
+{
+    setArg(0, sizeof(cl_mem), &dataset);
+}
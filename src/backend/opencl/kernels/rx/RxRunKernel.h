@@ -42,6 +42,7 @@ public:
 
     void enqueue(cl_command_queue queue, size_t threads, size_t workgroup_size);
     void setArgs(cl_mem dataset, cl_mem scratchpads, cl_mem registers, cl_mem rounding, cl_mem programs, uint32_t batch_size, const Algorithm &algorithm);
+    void setDataset(cl_mem dataset);
 };
 
 
@@ -26,6 +26,7 @@ if (WITH_OPENCL)
         src/backend/opencl/OclConfig_gen.h
         src/backend/opencl/OclGenerator.h
         src/backend/opencl/OclLaunchData.h
+        src/backend/opencl/OclPrebuild.h
         src/backend/opencl/OclThread.h
         src/backend/opencl/OclThreads.h
         src/backend/opencl/OclWorker.h
@@ -55,6 +56,7 @@ if (WITH_OPENCL)
         src/backend/opencl/OclCache.cpp
         src/backend/opencl/OclConfig.cpp
         src/backend/opencl/OclLaunchData.cpp
+        src/backend/opencl/OclPrebuild.cpp
         src/backend/opencl/OclThread.cpp
         src/backend/opencl/OclThreads.cpp
         src/backend/opencl/OclWorker.cpp
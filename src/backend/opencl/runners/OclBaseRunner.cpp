@@ -23,6 +23,7 @@
  */
 
 
+#include <cstring>
 #include <stdexcept>
 
 
@@ -68,9 +69,15 @@ xmrig::OclBaseRunner::OclBaseRunner(size_t id, const OclLaunchData &data) :
 
 xmrig::OclBaseRunner::~OclBaseRunner()
 {
+    cancel();
+
     OclLib::release(m_program);
     OclLib::release(m_input);
-    OclLib::release(m_output);
+
+    for (auto &batch : m_batches) {
+        OclLib::release(batch.output);
+    }
+
     OclLib::release(m_buffer);
     OclLib::release(m_queue);
 }
@@ -78,7 +85,7 @@ xmrig::OclBaseRunner::~OclBaseRunner()
 
 size_t xmrig::OclBaseRunner::bufferSize() const
 {
-    return align(Job::kMaxBlobSize) + align(sizeof(cl_uint) * 0x100);
+    return align(Job::kMaxBlobSize) + align(sizeof(cl_uint) * 0x100) * kMaxBatches;
 }
 
 
@@ -98,6 +105,42 @@ void xmrig::OclBaseRunner::build()
 }
 
 
+void xmrig::OclBaseRunner::cancel()
+{
+    if (m_pending == 0) {
+        return;
+    }
+
+    OclLib::finish(m_queue);
+
+    for (; m_pending > 0; --m_pending) {
+        Batch &batch = m_batches[m_head];
+        m_head       = (m_head + 1) % kMaxBatches;
+
+        OclLib::release(batch.event);
+        batch.event = nullptr;
+    }
+}
+
+
+void xmrig::OclBaseRunner::enqueue(uint32_t nonce)
+{
+    if (m_pending == kMaxBatches) {
+        throw std::logic_error("too many batches in flight");
+    }
+
+    Batch &batch = m_batches[(m_head + m_pending) % kMaxBatches];
+    m_output     = batch.output;
+
+    enqueueBatch(nonce, batch);
+
+    ++m_pending;
+
+    // make sure the device starts on this batch while the host waits for the previous one
+    OclLib::flush(m_queue);
+}
+
+
 void xmrig::OclBaseRunner::init()
 {
     m_queue = OclLib::createCommandQueue(m_ctx, data().device.id());
@@ -114,7 +157,54 @@ void xmrig::OclBaseRunner::init()
     }
 
     m_input  = createSubBuffer(CL_MEM_READ_ONLY | CL_MEM_HOST_WRITE_ONLY, Job::kMaxBlobSize);
-    m_output = createSubBuffer(CL_MEM_READ_WRITE, sizeof(cl_uint) * 0x100);
+
+    for (size_t i = 0; i < kMaxBatches; ++i) {
+        m_batches[i].index  = i;
+        m_batches[i].output = createSubBuffer(CL_MEM_READ_WRITE, sizeof(cl_uint) * 0x100);
+    }
+
+    m_output = m_batches[0].output;
+}
+
+
+void xmrig::OclBaseRunner::read(uint32_t *hashOutput)
+{
+    if (m_pending == 0) {
+        throw std::logic_error("no batches in flight");
+    }
+
+    Batch &batch = m_batches[m_head];
+    m_head       = (m_head + 1) % kMaxBatches;
+    --m_pending;
+
+    const cl_int ret = OclLib::waitForEvents(1, &batch.event);
+
+    OclLib::release(batch.event);
+    batch.event = nullptr;
+
+    if (ret != CL_SUCCESS) {
+        throw std::runtime_error(OclError::toString(ret));
+    }
+
+    collect(batch, hashOutput);
+}
+
+
+void xmrig::OclBaseRunner::run(uint32_t nonce, uint32_t *hashOutput)
+{
+    enqueue(nonce);
+    read(hashOutput);
+}
+
+
+void xmrig::OclBaseRunner::collect(const Batch &batch, uint32_t *hashOutput)
+{
+    memcpy(hashOutput, batch.results, sizeof(batch.results));
+
+    uint32_t &results = hashOutput[0xFF];
+    if (results > 0xFF) {
+        results = 0xFF;
+    }
 }
 
 
@@ -152,12 +242,10 @@ void xmrig::OclBaseRunner::enqueueWriteBuffer(cl_mem buffer, cl_bool blocking_wr
 }
 
 
-void xmrig::OclBaseRunner::finalize(uint32_t *hashOutput)
+void xmrig::OclBaseRunner::readBatch(Batch &batch, size_t size)
 {
-    enqueueReadBuffer(m_output, CL_TRUE, 0, sizeof(cl_uint) * 0x100, hashOutput);
-
-    uint32_t &results = hashOutput[0xFF];
-    if (results > 0xFF) {
-        results = 0xFF;
+    const cl_int ret = OclLib::enqueueReadBuffer(m_queue, batch.output, CL_FALSE, 0, size, batch.results, 0, nullptr, &batch.event);
+    if (ret != CL_SUCCESS) {
+        throw std::runtime_error(OclError::toString(ret));
     }
 }
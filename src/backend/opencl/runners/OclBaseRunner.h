@@ -45,10 +45,22 @@ class OclBaseRunner : public IOclRunner
 public:
     XMRIG_DISABLE_COPY_MOVE_DEFAULT(OclBaseRunner)
 
+    // number of batches which can be in flight at the same time, each of them has own output buffer
+    constexpr static size_t kMaxBatches = 2;
+
     OclBaseRunner(size_t id, const OclLaunchData &data);
     ~OclBaseRunner() override;
 
 protected:
+    struct Batch
+    {
+        cl_event event              = nullptr;
+        cl_mem output               = nullptr;
+        size_t index                = 0;
+        uint32_t aux[2]             = {};
+        uint32_t results[0x100]     = {};
+    };
+
     inline cl_context ctx() const override                { return m_ctx; }
     inline const Algorithm &algorithm() const override    { return m_algorithm; }
     inline const char *buildOptions() const override      { return m_options.c_str(); }
@@ -56,6 +68,7 @@ protected:
     inline const char *source() const override            { return m_source; }
     inline const OclLaunchData &data() const override     { return m_data; }
     inline size_t intensity() const override              { return m_intensity; }
+    inline size_t pending() const override                { return m_pending; }
     inline size_t threadId() const override               { return m_threadId; }
     inline uint32_t roundSize() const override            { return m_intensity; }
     inline uint32_t processedHashes() const override      { return m_intensity; }
@@ -64,15 +77,23 @@ protected:
     size_t bufferSize() const override;
     uint32_t deviceIndex() const override;
     void build() override;
+    void cancel() override;
+    void enqueue(uint32_t nonce) override;
     void init() override;
+    void read(uint32_t *hashOutput) override;
+    void run(uint32_t nonce, uint32_t *hashOutput) override;
 
 protected:
+    virtual void collect(const Batch &batch, uint32_t *hashOutput);
+    virtual void enqueueBatch(uint32_t nonce, Batch &batch) = 0;
+
     cl_mem createSubBuffer(cl_mem_flags flags, size_t size);
     size_t align(size_t size) const;
     void enqueueReadBuffer(cl_mem buffer, cl_bool blocking_read, size_t offset, size_t size, void *ptr);
     void enqueueWriteBuffer(cl_mem buffer, cl_bool blocking_write, size_t offset, size_t size, const void *ptr);
-    void finalize(uint32_t *hashOutput);
+    void readBatch(Batch &batch, size_t size = sizeof(cl_uint) * 0x100);
 
+    Batch m_batches[kMaxBatches];
     cl_command_queue m_queue    = nullptr;
     cl_context m_ctx;
     cl_mem m_buffer             = nullptr;
@@ -85,7 +106,9 @@ protected:
     const size_t m_align;
     const size_t m_threadId;
     const uint32_t m_intensity;
+    size_t m_head               = 0;
     size_t m_offset             = 0;
+    size_t m_pending            = 0;
     std::string m_deviceKey;
     std::string m_options;
 };
@@ -67,7 +67,7 @@ size_t xmrig::OclCnGpuRunner::bufferSize() const
 }
 
 
-void xmrig::OclCnGpuRunner::run(uint32_t nonce, uint32_t *hashOutput)
+void xmrig::OclCnGpuRunner::enqueueBatch(uint32_t nonce, Batch &batch)
 {
     static const cl_uint zero = 0;
 
@@ -81,9 +81,10 @@ void xmrig::OclCnGpuRunner::run(uint32_t nonce, uint32_t *hashOutput)
     m_cn0->enqueue(m_queue, nonce, g_thd);
     m_cn00->enqueue(m_queue, g_thd);
     m_cn1->enqueue(m_queue, g_thd, w_size);
+    m_cn2->setOutput(m_output);
     m_cn2->enqueue(m_queue, nonce, g_thd);
 
-    finalize(hashOutput);
+    readBatch(batch);
 }
 
 
@@ -98,7 +99,7 @@ void xmrig::OclCnGpuRunner::set(const Job &job, uint8_t *blob)
 
     enqueueWriteBuffer(m_input, CL_TRUE, 0, Job::kMaxBlobSize, blob);
 
-    m_cn2->setTarget(job.target());
+    m_cn2->setTarget(job.submitTarget());
 }
 
 
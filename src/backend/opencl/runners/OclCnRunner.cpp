@@ -87,7 +87,7 @@ size_t xmrig::OclCnRunner::bufferSize() const
 }
 
 
-void xmrig::OclCnRunner::run(uint32_t nonce, uint32_t *hashOutput)
+void xmrig::OclCnRunner::enqueueBatch(uint32_t nonce, Batch &batch)
 {
     static const cl_uint zero = 0;
 
@@ -107,10 +107,11 @@ void xmrig::OclCnRunner::run(uint32_t nonce, uint32_t *hashOutput)
     m_cn2->enqueue(m_queue, nonce, g_thd);
 
     for (auto kernel : m_branchKernels) {
+        kernel->setOutput(m_output);
         kernel->enqueue(m_queue, nonce, g_thd, w_size);
     }
 
-    finalize(hashOutput);
+    readBatch(batch);
 }
 
 
@@ -146,7 +147,7 @@ void xmrig::OclCnRunner::set(const Job &job, uint8_t *blob)
     }
 
     for (auto kernel : m_branchKernels) {
-        kernel->setTarget(job.target());
+        kernel->setTarget(job.submitTarget());
     }
 }
 
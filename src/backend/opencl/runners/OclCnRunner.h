@@ -42,7 +42,7 @@ public:
 
 protected:
     size_t bufferSize() const override;
-    void run(uint32_t nonce, uint32_t *hashOutput) override;
+    void enqueueBatch(uint32_t nonce, Batch &batch) override;
     void set(const Job &job, uint8_t *blob) override;
     void build() override;
     void init() override;
@@ -16,6 +16,8 @@
  *   along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+#include <cstring>
 #include <stdexcept>
 
 
@@ -75,19 +77,34 @@ OclKawPowRunner::~OclKawPowRunner()
 }
 
 
-void OclKawPowRunner::run(uint32_t nonce, uint32_t *hashOutput)
+void OclKawPowRunner::collect(const Batch &batch, uint32_t *hashOutput)
+{
+    const uint32_t count = std::min<uint32_t>(batch.results[0], 15);
+
+    m_skippedHashes = batch.aux[1] * m_workGroupSize;
+
+    hashOutput[0xFF] = count;
+    memcpy(hashOutput, batch.results + 1, count * sizeof(uint32_t));
+}
+
+
+void OclKawPowRunner::enqueueBatch(uint32_t nonce, Batch &batch)
 {
     const size_t local_work_size = m_workGroupSize;
     const size_t global_work_offset = nonce;
     const size_t global_work_size = m_intensity - (m_intensity % m_workGroupSize);
 
-    enqueueWriteBuffer(m_input, CL_FALSE, 0, BLOB_SIZE, m_blob);
+    // the worker may change the blob before this batch is executed, so each batch has own copy
+    uint8_t *blob = m_blobs[batch.index];
+    memcpy(blob, m_blob, BLOB_SIZE);
+
+    enqueueWriteBuffer(m_input, CL_FALSE, 0, BLOB_SIZE, blob);
 
-    const uint32_t zero[2] = {};
+    static const uint32_t zero[2] = {};
     enqueueWriteBuffer(m_output, CL_FALSE, 0, sizeof(uint32_t), zero);
     enqueueWriteBuffer(m_stop, CL_FALSE, 0, sizeof(uint32_t) * 2, zero);
 
-    m_skippedHashes = 0;
+    OclLib::setKernelArg(m_searchKernel, 4, sizeof(cl_mem), &m_output);
 
     const cl_int ret = OclLib::enqueueNDRangeKernel(m_queue, m_searchKernel, 1, &global_work_offset, &global_work_size, &local_work_size, 0, nullptr, nullptr);
     if (ret != CL_SUCCESS) {
@@ -97,20 +114,8 @@ void OclKawPowRunner::run(uint32_t nonce, uint32_t *hashOutput)
         throw std::runtime_error(OclError::toString(ret));
     }
 
-    uint32_t stop[2] = {};
-    enqueueReadBuffer(m_stop, CL_FALSE, 0, sizeof(stop), stop);
-
-    uint32_t output[16] = {};
-    enqueueReadBuffer(m_output, CL_TRUE, 0, sizeof(output), output);
-
-    m_skippedHashes = stop[1] * m_workGroupSize;
-
-    if (output[0] > 15) {
-        output[0] = 15;
-    }
-
-    hashOutput[0xFF] = output[0];
-    memcpy(hashOutput, output + 1, output[0] * sizeof(uint32_t));
+    enqueueReadBuffer(m_stop, CL_FALSE, 0, sizeof(batch.aux), batch.aux);
+    readBatch(batch, sizeof(uint32_t) * 16);
 }
 
 
@@ -165,7 +170,7 @@ void OclKawPowRunner::set(const Job &job, uint8_t *blob)
         LOG_INFO("%s " YELLOW("KawPow") " DAG for epoch " WHITE_BOLD("%u") " calculated " BLACK_BOLD("(%" PRIu64 "ms)"), Tags::opencl(), epoch, Chrono::steadyMSecs() - start_ms);
     }
 
-    const uint64_t target = job.target();
+    const uint64_t target = job.submitTarget();
     const uint32_t hack_false = 0;
 
     OclLib::setKernelArg(m_searchKernel, 0, sizeof(cl_mem), &m_dag);
@@ -40,7 +40,8 @@ public:
     ~OclKawPowRunner() override;
 
 protected:
-    void run(uint32_t nonce, uint32_t *hashOutput) override;
+    void collect(const Batch &batch, uint32_t *hashOutput) override;
+    void enqueueBatch(uint32_t nonce, Batch &batch) override;
     void set(const Job &job, uint8_t *blob) override;
     void build() override;
     void init() override;
@@ -49,6 +50,7 @@ protected:
 
 private:
     uint8_t* m_blob = nullptr;
+    uint8_t m_blobs[kMaxBatches][40]{};
     uint32_t m_skippedHashes = 0;
 
     uint32_t m_blockHeight = 0;
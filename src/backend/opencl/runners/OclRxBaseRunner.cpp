@@ -81,14 +81,19 @@ xmrig::OclRxBaseRunner::~OclRxBaseRunner()
     OclLib::release(m_hashes);
     OclLib::release(m_rounding);
     OclLib::release(m_scratchpads);
-    OclLib::release(m_dataset);
+
+    if (m_dataset) {
+        OclSharedState::get(data().device.index()).releaseDataset(m_dataset);
+    }
 }
 
 
-void xmrig::OclRxBaseRunner::run(uint32_t nonce, uint32_t *hashOutput)
+void xmrig::OclRxBaseRunner::enqueueBatch(uint32_t nonce, Batch &batch)
 {
     static const uint32_t zero = 0;
 
+    enqueueWriteBuffer(m_output, CL_FALSE, sizeof(cl_uint) * 0xFF, sizeof(uint32_t), &zero);
+
     if (m_jobSize <= 128) {
         m_blake2b_initial_hash->setNonce(nonce);
     }
@@ -96,13 +101,11 @@ void xmrig::OclRxBaseRunner::run(uint32_t nonce, uint32_t *hashOutput)
         m_blake2b_initial_hash_double->setNonce(nonce);
     }
     else {
-        hashOutput[0xFF] = 0;
-        return;
+        return readBatch(batch);
     }
 
     m_find_shares->setNonce(nonce);
-
-    enqueueWriteBuffer(m_output, CL_FALSE, sizeof(cl_uint) * 0xFF, sizeof(uint32_t), &zero);
+    m_find_shares->setOutput(m_output);
 
     if (m_jobSize <= 128) {
         m_blake2b_initial_hash->enqueue(m_queue, m_intensity);
@@ -131,19 +134,29 @@ void xmrig::OclRxBaseRunner::run(uint32_t nonce, uint32_t *hashOutput)
 
     m_find_shares->enqueue(m_queue, m_intensity);
 
-    finalize(hashOutput);
-
-    OclLib::finish(m_queue);
+    readBatch(batch);
 }
 
 
 void xmrig::OclRxBaseRunner::set(const Job &job, uint8_t *blob)
 {
-    if (!data().thread.isDatasetHost() && m_seed != job.seed()) {
+    if (m_seed != job.seed()) {
         m_seed = job.seed();
 
-        auto dataset = Rx::dataset(job, 0);
-        enqueueWriteBuffer(m_dataset, CL_TRUE, 0, RxDataset::maxSize(), dataset->raw());
+        // the batches of the old seed must not run while the only dataset buffer is exchanged
+        OclLib::finish(m_queue);
+
+        // uploaded once per device by the shared data, it may already be in the second buffer
+        cl_mem dataset = OclSharedState::get(data().device.index()).dataset(job);
+        if (dataset != m_dataset) {
+            OclLib::release(m_dataset);
+            m_dataset = dataset;
+
+            setDataset(m_dataset);
+        }
+        else {
+            OclLib::release(dataset);
+        }
     }
 
     if (job.size() < Job::kMaxBlobSize) {
@@ -157,7 +170,7 @@ void xmrig::OclRxBaseRunner::set(const Job &job, uint8_t *blob)
     m_blake2b_initial_hash->setBlobSize(job.size());
     m_blake2b_initial_hash_double->setBlobSize(job.size());
 
-    m_find_shares->setTarget(job.target());
+    m_find_shares->setTarget(job.submitTarget());
 }
 
 
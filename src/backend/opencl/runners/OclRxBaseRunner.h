@@ -53,11 +53,12 @@ protected:
     size_t bufferSize() const override;
     void build() override;
     void init() override;
-    void run(uint32_t nonce, uint32_t *hashOutput) override;
+    void enqueueBatch(uint32_t nonce, Batch &batch) override;
     void set(const Job &job, uint8_t *blob) override;
 
 protected:
     virtual void execute(uint32_t iteration) = 0;
+    virtual void setDataset(cl_mem dataset) = 0;
 
     Blake2bHashRegistersKernel *m_blake2b_hash_registers_32       = nullptr;
     Blake2bHashRegistersKernel *m_blake2b_hash_registers_64       = nullptr;
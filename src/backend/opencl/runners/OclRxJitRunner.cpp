@@ -95,6 +95,12 @@ void xmrig::OclRxJitRunner::init()
 }
 
 
+void xmrig::OclRxJitRunner::setDataset(cl_mem dataset)
+{
+    m_randomx_run->setDataset(dataset);
+}
+
+
 bool xmrig::OclRxJitRunner::loadAsmProgram()
 {
     // Adrenaline drivers on Windows and amdgpu-pro drivers on Linux use ELF header's flags (offset 0x30) to store internal device ID
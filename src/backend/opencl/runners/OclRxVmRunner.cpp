@@ -96,3 +96,9 @@ void xmrig::OclRxVmRunner::init()
 
     m_vm_states = createSubBuffer(CL_MEM_READ_WRITE, 2560 * m_intensity);
 }
+
+
+void xmrig::OclRxVmRunner::setDataset(cl_mem dataset)
+{
+    m_execute_vm->setDataset(dataset);
+}
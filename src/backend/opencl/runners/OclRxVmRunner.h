@@ -43,6 +43,7 @@ protected:
     void build() override;
     void execute(uint32_t iteration) override;
     void init() override;
+    void setDataset(cl_mem dataset) override;
 
 private:
     cl_mem m_vm_states              = nullptr;
@@ -17,14 +17,19 @@
  */
 
 #include "backend/opencl/runners/tools/OclSharedData.h"
+#include "backend/common/Tags.h"
+#include "backend/opencl/OclLaunchData.h"
+#include "backend/opencl/wrappers/OclError.h"
 #include "backend/opencl/wrappers/OclLib.h"
 #include "base/io/log/Log.h"
+#include "base/net/stratum/Job.h"
 #include "base/tools/Chrono.h"
 #include "crypto/rx/Rx.h"
 #include "crypto/rx/RxDataset.h"
 
 
 #include <algorithm>
+#include <chrono>
 #include <cinttypes>
 #include <stdexcept>
 #include <thread>
@@ -33,6 +38,107 @@
 constexpr size_t oneGiB = 1024 * 1024 * 1024;
 
 
+#ifdef XMRIG_ALGO_RANDOMX
+namespace xmrig {
+
+
+constexpr size_t kDatasetChunk  = 64 * 1024 * 1024;
+constexpr size_t kProbeSize     = 256 * 1024 * 1024;
+constexpr size_t kProbeReserve  = 256 * 1024 * 1024;
+
+
+// Random 64 byte reads, the same access pattern RandomX programs have to the dataset.
+static const char *kProbeSource = R"==(
+__kernel void probe(__global const ulong *data, __global ulong *out, uint mask)
+{
+    uint idx = get_global_id(0) * 2654435761u;
+    ulong acc = 0;
+
+    for (uint i = 0; i < 64; ++i) {
+        idx = idx * 1664525u + 1013904223u;
+        const uint line = (idx & mask) << 3;
+
+        for (uint j = 0; j < 8; ++j) {
+            acc ^= data[line + j];
+        }
+    }
+
+    out[get_global_id(0)] = acc;
+}
+)==";
+
+
+static double probeBandwidth(cl_context ctx, cl_device_id device, cl_command_queue queue, cl_mem data)
+{
+    constexpr size_t threads    = 64 * 1024;
+    constexpr size_t reads      = 64 * 64;
+    const cl_uint mask          = kProbeSize / 64 - 1;
+
+    cl_int ret              = CL_SUCCESS;
+    cl_program program      = OclLib::createProgramWithSource(ctx, 1, &kProbeSource, nullptr, &ret);
+    cl_kernel kernel        = nullptr;
+    cl_mem out              = nullptr;
+    double bandwidth        = 0.0;
+
+    if (ret == CL_SUCCESS && OclLib::buildProgram(program, 1, &device) == CL_SUCCESS) {
+        kernel = OclLib::createKernel(program, "probe", &ret);
+        out    = OclLib::createBuffer(ctx, CL_MEM_WRITE_ONLY, threads * sizeof(cl_ulong), nullptr, &ret);
+    }
+
+    if (kernel && out &&
+        OclLib::setKernelArg(kernel, 0, sizeof(cl_mem), &data) == CL_SUCCESS &&
+        OclLib::setKernelArg(kernel, 1, sizeof(cl_mem), &out) == CL_SUCCESS &&
+        OclLib::setKernelArg(kernel, 2, sizeof(cl_uint), &mask) == CL_SUCCESS
+    ) {
+        using namespace std::chrono;
+
+        // first run warms up caches and host pointer mappings, the best of the rest is taken
+        for (size_t i = 0; i < 4; ++i) {
+            const auto start = steady_clock::now();
+
+            if (OclLib::enqueueNDRangeKernel(queue, kernel, 1, nullptr, &threads, nullptr, 0, nullptr, nullptr) != CL_SUCCESS || OclLib::finish(queue) != CL_SUCCESS) {
+                bandwidth = 0.0;
+                break;
+            }
+
+            const double elapsed = duration_cast<duration<double>>(steady_clock::now() - start).count();
+            if (i > 0 && elapsed > 0.0) {
+                bandwidth = std::max(bandwidth, threads * reads / elapsed);
+            }
+        }
+    }
+
+    OclLib::release(out);
+    OclLib::release(kernel);
+    OclLib::release(program);
+
+    return bandwidth;
+}
+
+
+static bool isHostFaster(cl_context ctx, cl_device_id device, cl_command_queue queue, void *raw)
+{
+    cl_int ret          = CL_SUCCESS;
+    cl_mem hostMem      = OclLib::createBuffer(ctx, CL_MEM_READ_ONLY | CL_MEM_USE_HOST_PTR, kProbeSize, raw, &ret);
+    cl_mem deviceMem    = OclLib::createBuffer(ctx, CL_MEM_READ_ONLY, kProbeSize, nullptr, &ret);
+
+    const double host   = hostMem ? probeBandwidth(ctx, device, queue, hostMem) : 0.0;
+    const double dev    = deviceMem ? probeBandwidth(ctx, device, queue, deviceMem) : 0.0;
+
+    OclLib::release(hostMem);
+    OclLib::release(deviceMem);
+
+    LOG_VERBOSE("%s" CYAN_BOLD(" RandomX dataset probe:") " host " WHITE_BOLD("%.1f") " GB/s, device " WHITE_BOLD("%.1f") " GB/s", ocl_tag(), host / 1e9, dev / 1e9);
+
+    // device memory shared with the host (APU, CPU devices), the copy is only wasting memory
+    return host > 0.0 && host >= dev * 0.9;
+}
+
+
+} // namespace xmrig
+#endif
+
+
 cl_mem xmrig::OclSharedData::createBuffer(cl_context context, size_t size, size_t &offset, size_t limit)
 {
     std::lock_guard<std::mutex> lock(m_mutex);
@@ -48,7 +154,8 @@ cl_mem xmrig::OclSharedData::createBuffer(cl_context context, size_t size, size_
     ++m_offset;
 
     if (!m_buffer) {
-        m_buffer = OclLib::createBuffer(context, CL_MEM_READ_WRITE, size);
+        m_buffer     = OclLib::createBuffer(context, CL_MEM_READ_WRITE, size);
+        m_bufferSize = size;
     }
 
     return OclLib::retain(m_buffer);
@@ -135,7 +242,16 @@ void xmrig::OclSharedData::release()
     OclLib::release(m_buffer);
 
 #   ifdef XMRIG_ALGO_RANDOMX
-    OclLib::release(m_dataset);
+    if (m_queue) {
+        OclLib::finish(m_queue);
+    }
+
+    for (auto &dataset : m_datasets) {
+        OclLib::release(dataset.ready);
+        OclLib::release(dataset.mem);
+    }
+
+    OclLib::release(m_queue);
 #   endif
 }
 
@@ -151,6 +267,31 @@ void xmrig::OclSharedData::setResumeCounter(uint32_t value)
 }
 
 
+xmrig::OclSharedData::BatchStats xmrig::OclSharedData::batchStats(size_t id) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    const auto it = m_batches.find(id);
+
+    return it != m_batches.end() ? it->second : BatchStats();
+}
+
+
+void xmrig::OclSharedData::setBatchTime(size_t id, uint64_t latency, uint64_t wait)
+{
+    constexpr double averagingBias = 0.1;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    BatchStats &stats = m_batches[id];
+    const double bias = stats.count > 0 ? averagingBias : 1.0;
+
+    stats.latency = stats.latency * (1.0 - bias) + latency * bias;
+    stats.wait    = stats.wait * (1.0 - bias) + wait * bias;
+    stats.count++;
+}
+
+
 void xmrig::OclSharedData::setRunTime(uint64_t time)
 {
     // averagingBias = 1.0 - only the last delta time is taken into account
@@ -164,31 +305,241 @@ void xmrig::OclSharedData::setRunTime(uint64_t time)
 
 
 #ifdef XMRIG_ALGO_RANDOMX
-cl_mem xmrig::OclSharedData::dataset() const
+cl_mem xmrig::OclSharedData::dataset()
 {
-    if (!m_dataset) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (!m_datasets[m_current].mem) {
         throw std::runtime_error("RandomX dataset is not available");
     }
 
-    return OclLib::retain(m_dataset);
+    ++m_users;
+
+    return OclLib::retain(m_datasets[m_current].mem);
+}
+
+
+cl_mem xmrig::OclSharedData::dataset(const Job &job)
+{
+    cl_event ready = nullptr;
+    cl_mem mem     = nullptr;
+
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        if (m_datasetHost) {
+            return OclLib::retain(m_datasets[m_current].mem);
+        }
+
+        auto it = std::find_if(std::begin(m_datasets), std::end(m_datasets), [&job](const Dataset &dataset) { return dataset.mem && dataset.seed == job.seed(); });
+        if (it == std::end(m_datasets)) {
+            // upload was not started by the backend yet, the runner will wait for it
+            if (isSpareAllowed() && upload(m_datasets[m_current ^ 1], job)) {
+                it = m_datasets + (m_current ^ 1);
+            }
+            else {
+                exchange(lock, job);
+
+                it = m_datasets + m_current;
+            }
+        }
+
+        m_current = static_cast<size_t>(it - m_datasets);
+        ready     = it->ready;
+        mem       = OclLib::retain(it->mem);
+
+        if (ready) {
+            OclLib::retain(ready);
+        }
+    }
+
+    // only what is left of the upload is waited for, usually nothing
+    if (ready) {
+        const cl_int ret = OclLib::waitForEvents(1, &ready);
+        OclLib::release(ready);
+
+        if (ret != CL_SUCCESS) {
+            OclLib::release(mem);
+
+            throw std::runtime_error(OclError::toString(ret));
+        }
+    }
+
+    return mem;
 }
 
 
-void xmrig::OclSharedData::createDataset(cl_context ctx, const Job &job, bool host)
+void xmrig::OclSharedData::createDataset(const OclLaunchData &data, const Job &job)
 {
-    if (m_dataset) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_datasets[0].mem) {
         return;
     }
 
-    cl_int ret = 0;
+    m_ctx           = data.ctx;
+    m_globalMemory  = data.device.globalMemSize();
+    m_maxMemAlloc   = data.device.maxMemAllocSize();
+    m_queue         = OclLib::createCommandQueue(data.ctx, data.device.id());
+    m_datasetHost   = data.thread.isDatasetHost();
+    m_target        = job;
+
+    auto dataset = Rx::dataset(job, 0);
+    cl_int ret   = 0;
 
-    if (host) {
-        auto dataset = Rx::dataset(job, 0);
+    if (!m_datasetHost && dataset->raw() && isHostFaster(data.ctx, data.device.id(), m_queue, dataset->raw())) {
+        LOG_INFO("%s" YELLOW(" GPU #%u RandomX dataset is used from host memory, the device has no faster memory"), ocl_tag(), data.device.index());
+
+        m_datasetHost = true;
+    }
 
-        m_dataset = OclLib::createBuffer(ctx, CL_MEM_READ_ONLY | CL_MEM_USE_HOST_PTR, RxDataset::maxSize(), dataset->raw(), &ret);
+    if (m_datasetHost) {
+        m_datasets[0].mem = OclLib::createBuffer(data.ctx, CL_MEM_READ_ONLY | CL_MEM_USE_HOST_PTR, RxDataset::maxSize(), dataset->raw(), &ret);
     }
     else {
-        m_dataset = OclLib::createBuffer(ctx, CL_MEM_READ_ONLY, RxDataset::maxSize(), nullptr, &ret);
+        m_datasets[0].mem = OclLib::createBuffer(data.ctx, CL_MEM_READ_ONLY, RxDataset::maxSize(), nullptr, &ret);
+
+        upload(m_datasets[0], job);
     }
 }
-#endif
+
+
+void xmrig::OclSharedData::releaseDataset(cl_mem mem)
+{
+    OclLib::release(mem);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    --m_users;
+
+    // runners parked in exchange() may be waiting only for this one
+    m_cv.notify_all();
+}
+
+
+void xmrig::OclSharedData::uploadDataset(const Job &job)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_target = job;
+
+    if (m_datasetHost || !m_datasets[m_current].mem || !Rx::isReady(job)) {
+        return;
+    }
+
+    for (const auto &dataset : m_datasets) {
+        if (dataset.mem && dataset.seed == job.seed()) {
+            return;
+        }
+    }
+
+    // with only one buffer the runners exchange the dataset together when they take the new job
+    if (isSpareAllowed()) {
+        upload(m_datasets[m_current ^ 1], job);
+    }
+}
+
+
+bool xmrig::OclSharedData::isSpareAllowed() const
+{
+    if (!m_spare) {
+        return false;
+    }
+
+    const size_t size = RxDataset::maxSize();
+
+    return m_datasets[m_current ^ 1].mem || (m_maxMemAlloc >= size && m_globalMemory >= size * 2 + m_bufferSize + kProbeReserve);
+}
+
+
+bool xmrig::OclSharedData::upload(Dataset &dataset, const Job &job)
+{
+    cl_int ret = CL_SUCCESS;
+
+    if (!dataset.mem) {
+        dataset.mem = OclLib::createBuffer(m_ctx, CL_MEM_READ_ONLY, RxDataset::maxSize(), nullptr, &ret);
+    }
+
+    OclLib::release(dataset.ready);
+    dataset.ready = nullptr;
+    dataset.seed  = job.seed();
+
+    const auto *raw   = static_cast<const uint8_t *>(Rx::dataset(job, 0)->raw());
+    const size_t size = RxDataset::maxSize();
+
+    for (size_t offset = 0; ret == CL_SUCCESS && offset < size; offset += kDatasetChunk) {
+        const size_t chunk = std::min(kDatasetChunk, size - offset);
+
+        ret = OclLib::enqueueWriteBuffer(m_queue, dataset.mem, CL_FALSE, offset, chunk, raw + offset, 0, nullptr, offset + chunk == size ? &dataset.ready : nullptr);
+    }
+
+    if (ret != CL_SUCCESS) {
+        dataset.seed.clear();
+
+        if (&dataset != &m_datasets[m_current]) {
+            LOG_WARN("%s" YELLOW(" RandomX dataset spare buffer is not available (%s), mining will pause for dataset uploads"), ocl_tag(), OclError::toString(ret));
+
+            OclLib::release(dataset.mem);
+            dataset.mem = nullptr;
+            m_spare     = false;
+
+            return false;
+        }
+
+        throw std::runtime_error(OclError::toString(ret));
+    }
+
+    OclLib::flush(m_queue);
+
+    return true;
+}
+
+
+// Overwrites the only dataset buffer, which is safe only when no runner reads it. Every runner parks here with its own
+// queue finished, the last one to arrive uploads the dataset of the latest job and releases the others. A runner that
+// still holds an older job gets the new dataset too, it takes the new job right after.
+void xmrig::OclSharedData::exchange(std::unique_lock<std::mutex> &lock, const Job &job)
+{
+    Dataset &dataset = m_datasets[m_current];
+
+    while (dataset.seed != job.seed()) {
+        const uint64_t generation = m_generation;
+
+        if (++m_parked < m_users) {
+            m_cv.wait(lock, [this, generation] { return m_generation != generation || m_parked >= m_users; });
+
+            if (m_generation != generation) {
+                return;
+            }
+
+            // a runner has left while the others were parked, arrive again and become the one that uploads
+            --m_parked;
+
+            continue;
+        }
+
+        m_parked = 0;
+        ++m_generation;
+
+        try {
+            upload(dataset, m_target.seed() == job.seed() || !Rx::isReady(m_target) ? job : m_target);
+
+            const cl_int ret = OclLib::finish(m_queue);
+            if (ret != CL_SUCCESS) {
+                dataset.seed.clear();
+
+                throw std::runtime_error(OclError::toString(ret));
+            }
+        }
+        catch (...) {
+            m_cv.notify_all();
+
+            throw;
+        }
+
+        m_cv.notify_all();
+
+        return;
+    }
+}
+#endif
\ No newline at end of file
@@ -20,29 +20,47 @@
 #define XMRIG_OCLSHAREDDATA_H
 
 
+#include "base/net/stratum/Job.h"
+#include "base/tools/Buffer.h"
+
+
+#include <condition_variable>
+#include <map>
 #include <memory>
 #include <mutex>
 
 
-using cl_context = struct _cl_context *;
-using cl_mem     = struct _cl_mem *;
+using cl_command_queue  = struct _cl_command_queue *;
+using cl_context        = struct _cl_context *;
+using cl_event          = struct _cl_event *;
+using cl_mem            = struct _cl_mem *;
 
 
 namespace xmrig {
 
 
-class Job;
+class OclLaunchData;
 
 
 class OclSharedData
 {
 public:
+    struct BatchStats
+    {
+        double latency  = 0.0;  // microseconds from enqueue to results available on the host
+        double wait     = 0.0;  // microseconds the host was blocked waiting for results
+        uint64_t count  = 0;
+    };
+
     OclSharedData() = default;
 
+    BatchStats batchStats(size_t id) const;
+
     cl_mem createBuffer(cl_context context, size_t size, size_t &offset, size_t limit);
     uint64_t adjustDelay(size_t id);
     uint64_t resumeDelay(size_t id);
     void release();
+    void setBatchTime(size_t id, uint64_t latency, uint64_t wait);
     void setResumeCounter(uint32_t value);
     void setRunTime(uint64_t time);
 
@@ -51,22 +69,52 @@ public:
     inline OclSharedData &operator++()  { ++m_threads; return *this; }
 
 #   ifdef XMRIG_ALGO_RANDOMX
-    cl_mem dataset() const;
-    void createDataset(cl_context ctx, const Job &job, bool host);
+    inline bool isDatasetHost() const   { return m_datasetHost; }
+
+    cl_mem dataset();
+    cl_mem dataset(const Job &job);
+    void createDataset(const OclLaunchData &data, const Job &job);
+    void releaseDataset(cl_mem mem);
+    void uploadDataset(const Job &job);
 #   endif
 
 private:
     cl_mem m_buffer           = nullptr;
     double m_averageRunTime   = 0.0;
+    size_t m_bufferSize       = 0;
     double m_threshold        = 0.95;
     size_t m_offset           = 0;
     size_t m_threads          = 0;
-    std::mutex m_mutex;
+    mutable std::mutex m_mutex;
+    std::map<size_t, BatchStats> m_batches;
     uint32_t m_resumeCounter  = 0;
     uint64_t m_timestamp      = 0;
 
 #   ifdef XMRIG_ALGO_RANDOMX
-    cl_mem m_dataset          = nullptr;
+    struct Dataset
+    {
+        Buffer seed;
+        cl_event ready  = nullptr;  // completion of the last chunk, the whole upload is done when it fires
+        cl_mem mem      = nullptr;
+    };
+
+    bool isSpareAllowed() const;
+    bool upload(Dataset &dataset, const Job &job);
+    void exchange(std::unique_lock<std::mutex> &lock, const Job &job);
+
+    bool m_datasetHost          = false;
+    bool m_spare                = true;
+    cl_command_queue m_queue    = nullptr;
+    cl_context m_ctx            = nullptr;
+    Dataset m_datasets[2];
+    size_t m_current            = 0;
+    size_t m_globalMemory       = 0;
+    size_t m_maxMemAlloc        = 0;
+    size_t m_parked             = 0;    // runners waiting in exchange() with their queues finished
+    size_t m_users              = 0;    // runners holding a dataset buffer
+    std::condition_variable m_cv;
+    uint64_t m_generation       = 0;
+    Job m_target;                       // the latest job of the backend, exchange() always uploads its dataset
 #   endif
 };
 
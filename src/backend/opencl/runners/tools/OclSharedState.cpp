@@ -25,6 +25,7 @@
 
 #include "backend/opencl/runners/tools/OclSharedState.h"
 #include "backend/opencl/runners/tools/OclSharedData.h"
+#include "base/net/stratum/Job.h"
 
 
 #include <cassert>
@@ -67,8 +68,22 @@ void xmrig::OclSharedState::start(const std::vector<OclLaunchData> &threads, con
 
 #       ifdef XMRIG_ALGO_RANDOMX
         if (data.algorithm.family() == Algorithm::RANDOM_X) {
-            sharedData.createDataset(data.ctx, job, data.thread.isDatasetHost());
+            sharedData.createDataset(data, job);
         }
 #       endif
     }
 }
+
+
+#ifdef XMRIG_ALGO_RANDOMX
+void xmrig::OclSharedState::uploadDataset(const Job &job)
+{
+    if (job.algorithm().family() != Algorithm::RANDOM_X) {
+        return;
+    }
+
+    for (auto &kv : map) {
+        kv.second.uploadDataset(job);
+    }
+}
+#endif
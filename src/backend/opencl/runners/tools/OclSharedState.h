@@ -38,6 +38,10 @@ public:
     static OclSharedData &get(uint32_t index);
     static void release();
     static void start(const std::vector<OclLaunchData> &threads, const Job &job);
+
+#   ifdef XMRIG_ALGO_RANDOMX
+    static void uploadDataset(const Job &job);
+#   endif
 };
 
 
@@ -50,6 +50,7 @@ static const char *kEnqueueNDRangeKernel             = "clEnqueueNDRangeKernel";
 static const char *kEnqueueReadBuffer                = "clEnqueueReadBuffer";
 static const char *kEnqueueWriteBuffer               = "clEnqueueWriteBuffer";
 static const char *kFinish                           = "clFinish";
+static const char *kFlush                            = "clFlush";
 static const char *kGetCommandQueueInfo              = "clGetCommandQueueInfo";
 static const char *kGetContextInfo                   = "clGetContextInfo";
 static const char *kGetDeviceIDs                     = "clGetDeviceIDs";
@@ -63,15 +64,18 @@ static const char *kGetProgramInfo                   = "clGetProgramInfo";
 static const char *kReleaseCommandQueue              = "clReleaseCommandQueue";
 static const char *kReleaseContext                   = "clReleaseContext";
 static const char *kReleaseDevice                    = "clReleaseDevice";
+static const char *kReleaseEvent                     = "clReleaseEvent";
 static const char *kReleaseKernel                    = "clReleaseKernel";
 static const char *kReleaseMemObject                 = "clReleaseMemObject";
 static const char *kReleaseProgram                   = "clReleaseProgram";
+static const char *kRetainEvent                      = "clRetainEvent";
 static const char *kRetainMemObject                  = "clRetainMemObject";
 static const char *kRetainProgram                    = "clRetainProgram";
 static const char *kSetKernelArg                     = "clSetKernelArg";
 static const char *kSetMemObjectDestructorCallback   = "clSetMemObjectDestructorCallback";
 static const char *kSymbolNotFound                   = "symbol not found";
 static const char *kUnloadPlatformCompiler           = "clUnloadPlatformCompiler";
+static const char *kWaitForEvents                    = "clWaitForEvents";
 
 
 #if defined(CL_VERSION_2_0)
@@ -85,6 +89,7 @@ typedef cl_int (CL_API_CALL *enqueueNDRangeKernel_t)(cl_command_queue, cl_kernel
 typedef cl_int (CL_API_CALL *enqueueReadBuffer_t)(cl_command_queue, cl_mem, cl_bool, size_t, size_t, void *, cl_uint, const cl_event *, cl_event *);
 typedef cl_int (CL_API_CALL *enqueueWriteBuffer_t)(cl_command_queue, cl_mem, cl_bool, size_t, size_t, const void *, cl_uint, const cl_event *, cl_event *);
 typedef cl_int (CL_API_CALL *finish_t)(cl_command_queue);
+typedef cl_int (CL_API_CALL *flush_t)(cl_command_queue);
 typedef cl_int (CL_API_CALL *getCommandQueueInfo_t)(cl_command_queue, cl_command_queue_info, size_t, void *, size_t *);
 typedef cl_int (CL_API_CALL *getContextInfo_t)(cl_context, cl_context_info, size_t, void *, size_t *);
 typedef cl_int (CL_API_CALL *getDeviceIDs_t)(cl_platform_id, cl_device_type, cl_uint, cl_device_id *, cl_uint *);
@@ -98,14 +103,17 @@ typedef cl_int (CL_API_CALL *getProgramInfo_t)(cl_program, cl_program_info, size
 typedef cl_int (CL_API_CALL *releaseCommandQueue_t)(cl_command_queue);
 typedef cl_int (CL_API_CALL *releaseContext_t)(cl_context);
 typedef cl_int (CL_API_CALL *releaseDevice_t)(cl_device_id device);
+typedef cl_int (CL_API_CALL *releaseEvent_t)(cl_event);
 typedef cl_int (CL_API_CALL *releaseKernel_t)(cl_kernel);
 typedef cl_int (CL_API_CALL *releaseMemObject_t)(cl_mem);
 typedef cl_int (CL_API_CALL *releaseProgram_t)(cl_program);
+typedef cl_int (CL_API_CALL *retainEvent_t)(cl_event);
 typedef cl_int (CL_API_CALL *retainMemObject_t)(cl_mem);
 typedef cl_int (CL_API_CALL *retainProgram_t)(cl_program);
 typedef cl_int (CL_API_CALL *setKernelArg_t)(cl_kernel, cl_uint, size_t, const void *);
 typedef cl_int (CL_API_CALL *setMemObjectDestructorCallback_t)(cl_mem, void (CL_CALLBACK *)(cl_mem, void *), void *);
 typedef cl_int (CL_API_CALL *unloadPlatformCompiler_t)(cl_platform_id);
+typedef cl_int (CL_API_CALL *waitForEvents_t)(cl_uint, const cl_event *);
 typedef cl_kernel (CL_API_CALL *createKernel_t)(cl_program, const char *, cl_int *);
 typedef cl_mem (CL_API_CALL *createBuffer_t)(cl_context, cl_mem_flags, size_t, void *, cl_int *);
 typedef cl_mem (CL_API_CALL *createSubBuffer_t)(cl_mem, cl_mem_flags, cl_buffer_create_type, const void *, cl_int *);
@@ -128,6 +136,7 @@ static enqueueNDRangeKernel_t pEnqueueNDRangeKernel                         = nu
 static enqueueReadBuffer_t pEnqueueReadBuffer                               = nullptr;
 static enqueueWriteBuffer_t pEnqueueWriteBuffer                             = nullptr;
 static finish_t pFinish                                                     = nullptr;
+static flush_t pFlush                                                       = nullptr;
 static getCommandQueueInfo_t pGetCommandQueueInfo                           = nullptr;
 static getContextInfo_t pGetContextInfo                                     = nullptr;
 static getDeviceIDs_t pGetDeviceIDs                                         = nullptr;
@@ -141,14 +150,17 @@ static getProgramInfo_t pGetProgramInfo                                     = nu
 static releaseCommandQueue_t pReleaseCommandQueue                           = nullptr;
 static releaseContext_t pReleaseContext                                     = nullptr;
 static releaseDevice_t pReleaseDevice                                       = nullptr;
+static releaseEvent_t pReleaseEvent                                         = nullptr;
 static releaseKernel_t pReleaseKernel                                       = nullptr;
 static releaseMemObject_t pReleaseMemObject                                 = nullptr;
 static releaseProgram_t pReleaseProgram                                     = nullptr;
+static retainEvent_t pRetainEvent                                           = nullptr;
 static retainMemObject_t pRetainMemObject                                   = nullptr;
 static retainProgram_t pRetainProgram                                       = nullptr;
 static setKernelArg_t pSetKernelArg                                         = nullptr;
 static setMemObjectDestructorCallback_t pSetMemObjectDestructorCallback     = nullptr;
 static unloadPlatformCompiler_t pUnloadPlatformCompiler                     = nullptr;
+static waitForEvents_t pWaitForEvents                                       = nullptr;
 
 #define DLSYM(x) if (uv_dlsym(&oclLib, k##x, reinterpret_cast<void**>(&p##x)) == -1) { throw std::runtime_error(kSymbolNotFound); }
 
@@ -238,6 +250,10 @@ bool xmrig::OclLib::load()
         DLSYM(CreateSubBuffer);
         DLSYM(RetainProgram);
         DLSYM(RetainMemObject);
+        DLSYM(RetainEvent);
+        DLSYM(Flush);
+        DLSYM(ReleaseEvent);
+        DLSYM(WaitForEvents);
     } catch (std::exception &ex) {
         return false;
     }
@@ -378,6 +394,14 @@ cl_int xmrig::OclLib::finish(cl_command_queue command_queue) noexcept
 }
 
 
+cl_int xmrig::OclLib::flush(cl_command_queue command_queue) noexcept
+{
+    assert(pFlush != nullptr);
+
+    return pFlush(command_queue);
+}
+
+
 cl_int xmrig::OclLib::getCommandQueueInfo(cl_command_queue command_queue, cl_command_queue_info param_name, size_t param_value_size, void *param_value, size_t *param_value_size_ret) noexcept
 {
     return pGetCommandQueueInfo(command_queue, param_name, param_value_size, param_value, param_value_size_ret);
@@ -586,6 +610,23 @@ cl_int xmrig::OclLib::release(cl_program program) noexcept
 }
 
 
+cl_int xmrig::OclLib::release(cl_event event) noexcept
+{
+    assert(pReleaseEvent != nullptr);
+
+    if (event == nullptr) {
+        return CL_SUCCESS;
+    }
+
+    const cl_int ret = pReleaseEvent(event);
+    if (ret != CL_SUCCESS) {
+        LOG_ERR(kErrorTemplate, OclError::toString(ret), kReleaseEvent);
+    }
+
+    return ret;
+}
+
+
 cl_int xmrig::OclLib::setKernelArg(cl_kernel kernel, cl_uint arg_index, size_t arg_size, const void *arg_value) noexcept
 {
     assert(pSetKernelArg != nullptr);
@@ -600,6 +641,14 @@ cl_int xmrig::OclLib::unloadPlatformCompiler(cl_platform_id platform) noexcept
 }
 
 
+cl_int xmrig::OclLib::waitForEvents(cl_uint num_events, const cl_event *event_list) noexcept
+{
+    assert(pWaitForEvents != nullptr);
+
+    return pWaitForEvents(num_events, event_list);
+}
+
+
 cl_kernel xmrig::OclLib::createKernel(cl_program program, const char *kernel_name, cl_int *errcode_ret) noexcept
 {
     assert(pCreateKernel != nullptr);
@@ -684,6 +733,18 @@ cl_mem xmrig::OclLib::createSubBuffer(cl_mem buffer, cl_mem_flags flags, size_t
 }
 
 
+cl_event xmrig::OclLib::retain(cl_event event) noexcept
+{
+    assert(pRetainEvent != nullptr);
+
+    if (event != nullptr) {
+        pRetainEvent(event);
+    }
+
+    return event;
+}
+
+
 cl_mem xmrig::OclLib::retain(cl_mem memobj) noexcept
 {
     assert(pRetainMemObject != nullptr);
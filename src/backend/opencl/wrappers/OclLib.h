@@ -65,6 +65,7 @@ public:
     static cl_int enqueueReadBuffer(cl_command_queue command_queue, cl_mem buffer, cl_bool blocking_read, size_t offset, size_t size, void *ptr, cl_uint num_events_in_wait_list, const cl_event *event_wait_list, cl_event *event) noexcept;
     static cl_int enqueueWriteBuffer(cl_command_queue command_queue, cl_mem buffer, cl_bool blocking_write, size_t offset, size_t size, const void *ptr, cl_uint num_events_in_wait_list, const cl_event *event_wait_list, cl_event *event) noexcept;
     static cl_int finish(cl_command_queue command_queue) noexcept;
+    static cl_int flush(cl_command_queue command_queue) noexcept;
     static cl_int getCommandQueueInfo(cl_command_queue command_queue, cl_command_queue_info param_name, size_t param_value_size, void *param_value, size_t *param_value_size_ret = nullptr) noexcept;
     static cl_int getContextInfo(cl_context context, cl_context_info param_name, size_t param_value_size, void *param_value, size_t *param_value_size_ret = nullptr) noexcept;
     static cl_int getDeviceIDs(cl_platform_id platform, cl_device_type device_type, cl_uint num_entries, cl_device_id *devices, cl_uint *num_devices) noexcept;
@@ -78,17 +79,20 @@ public:
     static cl_int release(cl_command_queue command_queue) noexcept;
     static cl_int release(cl_context context) noexcept;
     static cl_int release(cl_device_id id) noexcept;
+    static cl_int release(cl_event event) noexcept;
     static cl_int release(cl_kernel kernel) noexcept;
     static cl_int release(cl_mem mem_obj) noexcept;
     static cl_int release(cl_program program) noexcept;
     static cl_int setKernelArg(cl_kernel kernel, cl_uint arg_index, size_t arg_size, const void *arg_value) noexcept;
     static cl_int unloadPlatformCompiler(cl_platform_id platform) noexcept;
+    static cl_int waitForEvents(cl_uint num_events, const cl_event *event_list) noexcept;
     static cl_kernel createKernel(cl_program program, const char *kernel_name, cl_int *errcode_ret) noexcept;
     static cl_kernel createKernel(cl_program program, const char *kernel_name);
     static cl_mem createBuffer(cl_context context, cl_mem_flags flags, size_t size, void *host_ptr = nullptr);
     static cl_mem createBuffer(cl_context context, cl_mem_flags flags, size_t size, void *host_ptr, cl_int *errcode_ret) noexcept;
     static cl_mem createSubBuffer(cl_mem buffer, cl_mem_flags flags, size_t offset, size_t size, cl_int *errcode_ret) noexcept;
     static cl_mem createSubBuffer(cl_mem buffer, cl_mem_flags flags, size_t offset, size_t size);
+    static cl_event retain(cl_event event) noexcept;
     static cl_mem retain(cl_mem memobj) noexcept;
     static cl_program createProgramWithBinary(cl_context context, cl_uint num_devices, const cl_device_id *device_list, const size_t *lengths, const unsigned char **binaries, cl_int *binary_status, cl_int *errcode_ret) noexcept;
     static cl_program createProgramWithSource(cl_context context, cl_uint count, const char **strings, const size_t *lengths, cl_int *errcode_ret) noexcept;
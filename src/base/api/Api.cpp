@@ -28,6 +28,7 @@
 #include "base/io/log/Log.h"
 #include "base/io/log/Tags.h"
 #include "base/kernel/Base.h"
+#include "base/kernel/ResourceLimits.h"
 #include "base/tools/Chrono.h"
 #include "base/tools/Cvt.h"
 #include "core/config/Config.h"
@@ -72,6 +73,7 @@ static rapidjson::Value getResources(rapidjson::Document &doc)
     out.AddMember("memory",               memory, allocator);
     out.AddMember("load_average",         load_average, allocator);
     out.AddMember("hardware_concurrency", std::thread::hardware_concurrency(), allocator);
+    out.AddMember("limits",               ResourceLimits::toJSON(doc), allocator);
 
     return out;
 }
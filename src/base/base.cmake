@@ -43,6 +43,7 @@ set(HEADERS_BASE
     src/base/kernel/interfaces/IWatcherListener.h
     src/base/kernel/Platform.h
     src/base/kernel/Process.h
+    src/base/kernel/ResourceLimits.h
     src/base/net/dns/Dns.h
     src/base/net/dns/DnsConfig.h
     src/base/net/dns/DnsRecord.h
@@ -58,9 +59,11 @@ set(HEADERS_BASE
     src/base/net/stratum/Pool.h
     src/base/net/stratum/Pools.h
     src/base/net/stratum/ProxyUrl.h
+    src/base/net/stratum/Recorder.h
     src/base/net/stratum/Socks5.h
     src/base/net/stratum/strategies/FailoverStrategy.h
     src/base/net/stratum/strategies/SinglePoolStrategy.h
+    src/base/net/stratum/strategies/SplitStrategy.h
     src/base/net/stratum/strategies/StrategyProxy.h
     src/base/net/stratum/SubmitResult.h
     src/base/net/stratum/Url.h
@@ -113,6 +116,7 @@ set(SOURCES_BASE
     src/base/kernel/Entry.cpp
     src/base/kernel/Platform.cpp
     src/base/kernel/Process.cpp
+    src/base/kernel/ResourceLimits.cpp
     src/base/net/dns/Dns.cpp
     src/base/net/dns/DnsConfig.cpp
     src/base/net/dns/DnsRecord.cpp
@@ -126,9 +130,11 @@ set(SOURCES_BASE
     src/base/net/stratum/Pool.cpp
     src/base/net/stratum/Pools.cpp
     src/base/net/stratum/ProxyUrl.cpp
+    src/base/net/stratum/Recorder.cpp
     src/base/net/stratum/Socks5.cpp
     src/base/net/stratum/strategies/FailoverStrategy.cpp
     src/base/net/stratum/strategies/SinglePoolStrategy.cpp
+    src/base/net/stratum/strategies/SplitStrategy.cpp
     src/base/net/stratum/Url.cpp
     src/base/net/tools/LineReader.cpp
     src/base/net/tools/NetBuffer.cpp
@@ -257,3 +263,22 @@ if (WITH_KAWPOW OR WITH_GHOSTRIDER)
         src/base/net/stratum/EthStratumClient.cpp
         )
 endif()
+
+
+if (WITH_STRATUM_REPLAY)
+    set(SOURCES_REPLAY
+        src/3rdparty/fmt/format.cc
+        src/base/io/json/Json.cpp
+        src/base/io/log/backends/ConsoleLog.cpp
+        src/base/io/log/Log.cpp
+        src/base/io/log/Tags.cpp
+        src/base/io/Signals.cpp
+        src/base/net/stratum/ReplayServer.cpp
+        src/base/net/tools/LineReader.cpp
+        src/base/net/tools/NetBuffer.cpp
+        src/base/net/tools/TcpServer.cpp
+        src/base/tools/String.cpp
+        src/base/tools/Timer.cpp
+        src/xmrig_replay.cpp
+        )
+endif()
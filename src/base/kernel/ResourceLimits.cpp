@@ -0,0 +1,359 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "base/kernel/ResourceLimits.h"
+#include "3rdparty/rapidjson/document.h"
+
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <uv.h>
+
+
+namespace xmrig {
+
+
+const char *ResourceLimits::kCgroupRoot     = "cgroup-root";
+const char *ResourceLimits::kDefaultRoot    = "/sys/fs/cgroup";
+
+
+double ResourceLimits::m_cpus               = 0.0;
+int ResourceLimits::m_version               = 0;
+String ResourceLimits::m_root;
+std::vector<int64_t> ResourceLimits::m_cpuset;
+uint64_t ResourceLimits::m_hugePages[2]     = { kUnlimited, kUnlimited };
+uint64_t ResourceLimits::m_memory           = kUnlimited;
+
+
+static const char *hugeTlbNames[2]          = { "2MB", "1GB" };
+static std::atomic<uint64_t> reserved[2];
+
+
+static inline size_t pageIndex(size_t pageSize)
+{
+    return pageSize >= 1024U * 1024U * 1024U ? 1 : 0;
+}
+
+
+static bool readLine(const std::string &path, std::string &line)
+{
+    std::ifstream file(path);
+
+    return std::getline(file, line) && !line.empty();
+}
+
+
+static uint64_t readLimit(const std::string &path)
+{
+    std::string line;
+    if (!readLine(path, line) || line == "max") {
+        return ResourceLimits::kUnlimited;
+    }
+
+    // cgroup v1 reports "no limit" as a page aligned LLONG_MAX
+    const uint64_t value = strtoull(line.c_str(), nullptr, 10);
+
+    return value >= (ResourceLimits::kUnlimited >> 2) ? ResourceLimits::kUnlimited : value;
+}
+
+
+static double readQuota(const std::string &dir, int version)
+{
+    std::string line;
+    int64_t quota  = 0;
+    int64_t period = 0;
+
+    if (version == 2) {
+        if (!readLine(dir + "/cpu.max", line)) {
+            return 0.0;
+        }
+
+        std::istringstream(line) >> quota >> period;
+    }
+    else if (readLine(dir + "/cpu.cfs_quota_us", line)) {
+        quota = strtoll(line.c_str(), nullptr, 10);
+
+        if (readLine(dir + "/cpu.cfs_period_us", line)) {
+            period = strtoll(line.c_str(), nullptr, 10);
+        }
+    }
+
+    return (quota > 0 && period > 0) ? static_cast<double>(quota) / period : 0.0;
+}
+
+
+static std::vector<int64_t> readList(const std::string &path)
+{
+    std::vector<int64_t> out;
+    std::string line;
+
+    if (!readLine(path, line)) {
+        return out;
+    }
+
+    std::istringstream stream(line);
+    std::string item;
+
+    while (std::getline(stream, item, ',')) {
+        if (item.empty()) {
+            continue;
+        }
+
+        const size_t dash   = item.find('-');
+        const int64_t first = strtoll(item.c_str(), nullptr, 10);
+        const int64_t last  = dash == std::string::npos ? first : strtoll(item.c_str() + dash + 1, nullptr, 10);
+
+        for (int64_t i = first; i <= last; ++i) {
+            out.push_back(i);
+        }
+    }
+
+    return out;
+}
+
+
+// controller name -> group path from /proc/self/cgroup, the unified (v2) hierarchy has an empty name
+static std::map<std::string, std::string> ownGroups()
+{
+    std::map<std::string, std::string> out;
+    std::ifstream file("/proc/self/cgroup");
+    std::string line;
+
+    while (std::getline(file, line)) {
+        const size_t a = line.find(':');
+        const size_t b = a == std::string::npos ? a : line.find(':', a + 1);
+        if (b == std::string::npos) {
+            continue;
+        }
+
+        const std::string controllers = line.substr(a + 1, b - a - 1);
+        const std::string path        = line.substr(b + 1);
+
+        if (controllers.empty()) {
+            out[controllers] = path;
+        }
+
+        std::istringstream stream(controllers);
+        std::string name;
+
+        while (std::getline(stream, name, ',')) {
+            out[name] = path;
+        }
+    }
+
+    return out;
+}
+
+
+// Visits the group of the process and all its parents up to the root of the hierarchy. Inside a container
+// the own path is usually not visible under the mount point, then only the root (the container group) is read.
+template<typename Func>
+static void walk(const std::string &base, std::string path, Func func)
+{
+    while (path.size() > 1) {
+        func(base + path);
+
+        path.resize(path.rfind('/'));
+    }
+
+    func(base);
+}
+
+
+static inline double minQuota(double a, double b)
+{
+    return (a > 0.0 && b > 0.0) ? std::min(a, b) : std::max(a, b);
+}
+
+
+} // namespace xmrig
+
+
+bool xmrig::ResourceLimits::isLimited()
+{
+    return m_cpus > 0.0 || !m_cpuset.empty() || m_memory != kUnlimited || m_hugePages[0] != kUnlimited || m_hugePages[1] != kUnlimited;
+}
+
+
+bool xmrig::ResourceLimits::reserve(size_t size, size_t pageSize)
+{
+    const uint64_t limit  = hugePages(pageSize);
+    const uint64_t charge = (size + pageSize - 1) / pageSize * pageSize;
+    auto &counter         = reserved[pageIndex(pageSize)];
+    uint64_t current      = counter.load();
+
+    // the hugetlb controller charges pages on first touch, going over the limit ends with SIGBUS instead of a failed mmap
+    do {
+        if (limit != kUnlimited && current + charge > limit) {
+            return false;
+        }
+    } while (!counter.compare_exchange_weak(current, current + charge));
+
+    return true;
+}
+
+
+rapidjson::Value xmrig::ResourceLimits::toJSON(rapidjson::Document &doc)
+{
+    using namespace rapidjson;
+    auto &allocator = doc.GetAllocator();
+
+    auto limit = [](uint64_t value) { return value == kUnlimited ? Value(kNullType) : Value(value); };
+
+    Value out(kObjectType);
+    out.AddMember("cgroup",     m_version, allocator);
+    out.AddMember("cpus",       m_cpus > 0.0 ? Value(m_cpus) : Value(kNullType), allocator);
+    out.AddMember("cpuset",     m_cpuset.empty() ? Value(kNullType) : cpusetToString().toJSON(doc), allocator);
+    out.AddMember("memory",     limit(m_memory), allocator);
+    out.AddMember("hugepages",  limit(m_hugePages[0]), allocator);
+    out.AddMember("1gb_pages",  limit(m_hugePages[1]), allocator);
+
+    return out;
+}
+
+
+size_t xmrig::ResourceLimits::threads(size_t count)
+{
+    if (m_cpus > 0.0) {
+        count = std::min<size_t>(count, std::max<long>(std::lround(m_cpus), 1));
+    }
+
+    if (!m_cpuset.empty()) {
+        count = std::min(count, m_cpuset.size());
+    }
+
+    return count;
+}
+
+
+xmrig::String xmrig::ResourceLimits::cpusetToString()
+{
+    std::string out;
+
+    for (size_t i = 0; i < m_cpuset.size(); ++i) {
+        size_t last = i;
+        while (last + 1 < m_cpuset.size() && m_cpuset[last + 1] == m_cpuset[last] + 1) {
+            ++last;
+        }
+
+        if (!out.empty()) {
+            out += ',';
+        }
+
+        out += std::to_string(m_cpuset[i]);
+
+        if (last > i) {
+            out += '-' + std::to_string(m_cpuset[last]);
+        }
+
+        i = last;
+    }
+
+    return out.c_str();
+}
+
+
+uint64_t xmrig::ResourceLimits::hugePages(size_t pageSize)
+{
+    return m_hugePages[pageIndex(pageSize)];
+}
+
+
+uint64_t xmrig::ResourceLimits::memory()
+{
+    return std::min<uint64_t>(uv_get_total_memory(), m_memory);
+}
+
+
+void xmrig::ResourceLimits::init(const char *root)
+{
+    m_root      = root;
+    m_version   = 0;
+    m_cpus      = 0.0;
+    m_memory    = kUnlimited;
+
+    m_cpuset.clear();
+    std::fill_n(m_hugePages, 2, kUnlimited);
+
+    const std::string base = root ? root : kDefaultRoot;
+    auto groups            = ownGroups();
+    auto group             = [&groups](const char *name) { return groups.count(name) ? groups[name] : std::string("/"); };
+    std::string line;
+
+    if (readLine(base + "/cgroup.controllers", line)) {
+        m_version = 2;
+
+        walk(base, group(""), [](const std::string &dir) {
+            m_cpus   = minQuota(m_cpus, readQuota(dir, 2));
+            m_memory = std::min(m_memory, readLimit(dir + "/memory.max"));
+
+            for (size_t i = 0; i < 2; ++i) {
+                m_hugePages[i] = std::min(m_hugePages[i], readLimit(dir + "/hugetlb." + hugeTlbNames[i] + ".max"));
+            }
+
+            if (m_cpuset.empty()) {
+                m_cpuset = readList(dir + "/cpuset.cpus.effective");
+            }
+        });
+    }
+    else if (readLine(base + "/cpu/cpu.cfs_period_us", line) || readLine(base + "/memory/memory.limit_in_bytes", line)) {
+        m_version = 1;
+
+        walk(base + "/cpu", group("cpu"), [](const std::string &dir) {
+            m_cpus = minQuota(m_cpus, readQuota(dir, 1));
+        });
+
+        walk(base + "/memory", group("memory"), [](const std::string &dir) {
+            m_memory = std::min(m_memory, readLimit(dir + "/memory.limit_in_bytes"));
+        });
+
+        walk(base + "/hugetlb", group("hugetlb"), [](const std::string &dir) {
+            for (size_t i = 0; i < 2; ++i) {
+                m_hugePages[i] = std::min(m_hugePages[i], readLimit(dir + "/hugetlb." + hugeTlbNames[i] + ".limit_in_bytes"));
+            }
+        });
+
+        walk(base + "/cpuset", group("cpuset"), [](const std::string &dir) {
+            if (m_cpuset.empty()) {
+                m_cpuset = readList(dir + "/cpuset.effective_cpus");
+            }
+
+            if (m_cpuset.empty()) {
+                m_cpuset = readList(dir + "/cpuset.cpus");
+            }
+        });
+    }
+
+    // a cpuset with every CPU of the machine is not a limit
+    if (m_cpuset.size() >= std::thread::hardware_concurrency()) {
+        m_cpuset.clear();
+    }
+}
+
+
+void xmrig::ResourceLimits::release(size_t size, size_t pageSize)
+{
+    reserved[pageIndex(pageSize)] -= (size + pageSize - 1) / pageSize * pageSize;
+}
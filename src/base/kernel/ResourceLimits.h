@@ -0,0 +1,78 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_RESOURCELIMITS_H
+#define XMRIG_RESOURCELIMITS_H
+
+
+#include "3rdparty/rapidjson/fwd.h"
+#include "base/tools/String.h"
+
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+
+namespace xmrig {
+
+
+/**
+ * Resource envelope of the process as set by cgroup v1 or v2 (containers, systemd slices).
+ *
+ * Limits are read once from the cgroup filesystem, by default "/sys/fs/cgroup". The root can be moved with the
+ * "cgroup-root" option to probe a fake tree. Limits of parent groups are applied too, and a missing value means
+ * no limit.
+ */
+class ResourceLimits
+{
+public:
+    constexpr static uint64_t kUnlimited = std::numeric_limits<uint64_t>::max();
+
+    static const char *kCgroupRoot;
+    static const char *kDefaultRoot;
+
+    inline static const std::vector<int64_t> &cpuset()  { return m_cpuset; }
+    inline static const String &root()                  { return m_root; }
+    inline static double cpus()                         { return m_cpus; }
+    inline static int version()                         { return m_version; }
+
+    static bool isLimited();
+    static bool reserve(size_t size, size_t pageSize);
+    static rapidjson::Value toJSON(rapidjson::Document &doc);
+    static size_t threads(size_t count);
+    static String cpusetToString();
+    static uint64_t hugePages(size_t pageSize);
+    static uint64_t memory();
+    static void init(const char *root);
+    static void release(size_t size, size_t pageSize);
+
+private:
+    static double m_cpus;
+    static int m_version;
+    static String m_root;
+    static std::vector<int64_t> m_cpuset;
+    static uint64_t m_hugePages[2];
+    static uint64_t m_memory;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_RESOURCELIMITS_H */
@@ -23,7 +23,9 @@
 #include "base/io/log/Log.h"
 #include "base/io/log/Tags.h"
 #include "base/kernel/interfaces/IJsonReader.h"
+#include "base/kernel/ResourceLimits.h"
 #include "base/net/dns/Dns.h"
+#include "base/net/stratum/Recorder.h"
 #include "version.h"
 
 
@@ -110,6 +112,8 @@ bool xmrig::BaseConfig::read(const IJsonReader &reader, const char *fileName)
     m_pools.load(reader);
 
     Dns::set(reader.getObject(DnsConfig::kField));
+    ResourceLimits::init(reader.getString(ResourceLimits::kCgroupRoot));
+    Recorder::init(reader.getString(Recorder::kField));
 
 #   ifdef XMRIG_FEATURE_CC_CLIENT
     return m_ccClient.load(reader.getObject(kCCClient)) || m_pools.active() > 0;
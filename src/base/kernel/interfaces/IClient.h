@@ -84,6 +84,10 @@ public:
     virtual void setRetries(int retries)                                    = 0;
     virtual void setRetryPause(uint64_t ms)                                 = 0;
     virtual void tick(uint64_t now)                                         = 0;
+
+#   ifdef XMRIG_FEATURE_HANDOFF
+    virtual int handoff(rapidjson::Value &state, rapidjson::Document &doc)  = 0;
+#   endif
 };
 
 
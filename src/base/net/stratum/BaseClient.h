@@ -58,6 +58,10 @@ protected:
 
     void setPool(const Pool &pool) override;
 
+#   ifdef XMRIG_FEATURE_HANDOFF
+    inline int handoff(rapidjson::Value &, rapidjson::Document &) override { return -1; }
+#   endif
+
 protected:
     enum SocketState {
         UnconnectedState,
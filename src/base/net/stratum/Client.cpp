@@ -45,6 +45,7 @@
 #include "base/kernel/Platform.h"
 #include "base/net/dns/Dns.h"
 #include "base/net/dns/DnsRecords.h"
+#include "base/net/stratum/Recorder.h"
 #include "base/net/stratum/Socks5.h"
 #include "base/net/tools/NetBuffer.h"
 #include "base/tools/Chrono.h"
@@ -53,6 +54,12 @@
 #include "net/JobResult.h"
 
 
+#ifdef XMRIG_FEATURE_HANDOFF
+#   include <unistd.h>
+#   include "core/Handoff.h"
+#endif
+
+
 #ifdef _MSC_VER
 #   define strncasecmp(x,y,z) _strnicmp(x,y,z)
 #endif
@@ -245,6 +252,12 @@ int64_t xmrig::Client::submit(const JobResult &result)
 
 void xmrig::Client::connect()
 {
+#   ifdef XMRIG_FEATURE_HANDOFF
+    if (adopt()) {
+        return;
+    }
+#   endif
+
     if (m_pool.proxy().isValid()) {
         m_socks5 = new Socks5(this);
         resolve(m_pool.proxy().host());
@@ -307,6 +320,69 @@ void xmrig::Client::tick(uint64_t now)
 }
 
 
+#ifdef XMRIG_FEATURE_HANDOFF
+int xmrig::Client::handoff(rapidjson::Value &state, rapidjson::Document &doc)
+{
+    uv_os_fd_t fd = -1;
+    // writes are never queued (uv_try_write), everything sent so far is already in the socket buffer that moves with it
+    if (m_state != ConnectedState || m_socks5 || isTLS() || m_rpcId.isNull() || !m_jobParams.IsObject() || stream()->write_queue_size > 0 ||
+        uv_fileno(reinterpret_cast<uv_handle_t *>(m_socket), &fd) != 0) {
+        return -1;
+    }
+
+    const int dup = ::dup(fd);
+    if (dup < 0) {
+        return -1;
+    }
+
+    using namespace rapidjson;
+    auto &allocator = doc.GetAllocator();
+
+    state.AddMember("url",          m_pool.url().toJSON(), allocator);
+    state.AddMember("ip",           m_ip.toJSON(doc), allocator);
+    state.AddMember("rpc_id",       m_rpcId.toJSON(doc), allocator);
+    state.AddMember("sequence",     m_sequence, allocator);
+    state.AddMember("extensions",   static_cast<uint64_t>(m_extensions.to_ulong()), allocator);
+    state.AddMember("job",          Value(m_jobParams, allocator), allocator);
+
+    // a line the pool has only sent in part, the rest is read by the new process
+    if (m_reader.size() > 0) {
+        state.AddMember("partial",  Cvt::toHex(reinterpret_cast<const uint8_t *>(m_reader.data()), m_reader.size(), doc), allocator);
+    }
+
+    // shares still waiting for the pool's answer, the new process counts them when it arrives
+    Value results(kArrayType);
+    for (const auto &kv : m_results) {
+        Value result(kArrayType);
+        result.PushBack(kv.second.seq, allocator);
+        result.PushBack(kv.second.diff, allocator);
+        result.PushBack(kv.second.actualDiff, allocator);
+        result.PushBack(kv.second.reqId, allocator);
+        result.PushBack(kv.second.backend, allocator);
+
+        results.PushBack(result, allocator);
+    }
+
+    state.AddMember("results",      results, allocator);
+
+    // the socket now belongs to the new process, closing this handle doesn't send FIN and nothing is written anymore
+    uv_read_stop(stream());
+
+    m_keepAlive = 0;
+    m_expire    = 0;
+    m_failures  = -1;
+
+    m_results.clear();
+    m_reader.reset();
+
+    setState(ClosingState);
+    uv_close(reinterpret_cast<uv_handle_t*>(m_socket), Client::onClose);
+
+    return dup;
+}
+#endif
+
+
 void xmrig::Client::onResolved(const DnsRecords &records, int status, const char *error)
 {
     m_dns.reset();
@@ -354,6 +430,79 @@ bool xmrig::Client::close()
 }
 
 
+#ifdef XMRIG_FEATURE_HANDOFF
+bool xmrig::Client::adopt()
+{
+    const rapidjson::Value *state = nullptr;
+    const int fd                  = Handoff::socket(m_pool.url(), &state);
+    if (fd < 0) {
+        return false;
+    }
+
+    m_socket = new uv_tcp_t;
+    m_socket->data = m_storage.ptr(m_key);
+
+    uv_tcp_init(uv_default_loop(), m_socket);
+
+    if (uv_tcp_open(m_socket, fd) != 0) {
+        ::close(fd);
+        uv_close(reinterpret_cast<uv_handle_t*>(m_socket), [](uv_handle_t *handle) { delete reinterpret_cast<uv_tcp_t *>(handle); });
+        m_socket = nullptr;
+
+        return false;
+    }
+
+    uv_tcp_nodelay(m_socket, 1);
+
+    if (Platform::hasKeepalive()) {
+        uv_tcp_keepalive(m_socket, 1, 60);
+    }
+
+    m_ip         = Json::getString(*state, "ip");
+    m_sequence   = Json::getInt64(*state, "sequence", 1);
+    m_extensions = std::bitset<EXT_MAX>(Json::getUint64(*state, "extensions"));
+    m_failures   = 0;
+
+    const rapidjson::Value &results = Json::getArray(*state, "results");
+    if (results.IsArray()) {
+        for (const rapidjson::Value &result : results.GetArray()) {
+            if (!result.IsArray() || result.Size() != 5 || !result[0].IsInt64() || !result[1].IsUint64() || !result[2].IsUint64() || !result[3].IsInt64() || !result[4].IsUint()) {
+                continue;
+            }
+
+            const int64_t seq = result[0].GetInt64();
+            m_results[seq]    = SubmitResult(seq, result[1].GetUint64(), result[2].GetUint64(), result[3].GetInt64(), result[4].GetUint());
+        }
+    }
+
+    setRpcId(Json::getString(*state, "rpc_id"));
+    setState(ConnectedState);
+    startTimeout();
+
+    m_reader.reset();
+
+    Buffer partial = Cvt::fromHex(Json::getString(*state, "partial", ""), strlen(Json::getString(*state, "partial", "")));
+    if (!partial.empty()) {
+        m_reader.parse(reinterpret_cast<char *>(partial.data()), partial.size());
+    }
+
+    uv_read_start(stream(), NetBuffer::onAlloc, onRead);
+
+    m_listener->onLoginSuccess(this);
+
+    const rapidjson::Value &params = Json::getObject(*state, "job");
+    int code = -1;
+
+    if (parseJob(params, &code)) {
+        m_jobs = 0;
+        m_listener->onJobReceived(this, m_job, params);
+    }
+
+    return true;
+}
+#endif
+
+
 bool xmrig::Client::parseJob(const rapidjson::Value &params, int *code)
 {
     if (!params.IsObject()) {
@@ -424,6 +573,13 @@ bool xmrig::Client::parseJob(const rapidjson::Value &params, int *code)
     if (m_job != job) {
         m_jobs++;
         m_job = std::move(job);
+
+#       ifdef XMRIG_FEATURE_HANDOFF
+        m_jobParams.SetNull();
+        m_jobParams.GetAllocator().Clear();
+        m_jobParams.CopyFrom(params, m_jobParams.GetAllocator());
+#       endif
+
         return true;
     }
 
@@ -531,6 +687,7 @@ int xmrig::Client::resolve(const String &host)
 int64_t xmrig::Client::send(size_t size)
 {
     LOG_DEBUG("[%s] send (%d bytes): \"%.*s\"", url(), size, static_cast<int>(size) - 1, m_sendBuf.data());
+    Recorder::send(m_id, m_sendBuf.data(), size);
 
 #   ifdef XMRIG_FEATURE_TLS
     if (isTLS()) {
@@ -664,6 +821,7 @@ void xmrig::Client::parse(char *line, size_t len)
     startTimeout();
 
     LOG_DEBUG("[%s] received (%d bytes): \"%.*s\"", url(), len, static_cast<int>(len), line);
+    Recorder::receive(m_id, line, len);
 
     if (len < 22 || line[0] != '{') {
         if (!isQuiet()) {
@@ -941,6 +1099,13 @@ void xmrig::Client::setState(SocketState state)
         return;
     }
 
+    if (state == ConnectedState) {
+        Recorder::connect(m_id, url());
+    }
+    else if (m_state == ConnectedState) {
+        Recorder::close(m_id);
+    }
+
     switch (state) {
     case HostLookupState:
         m_expire = 0;
@@ -27,6 +27,11 @@
 #include <vector>
 
 
+#ifdef XMRIG_FEATURE_HANDOFF
+#   include "3rdparty/rapidjson/document.h"
+#endif
+
+
 #include "base/kernel/interfaces/IDnsListener.h"
 #include "base/kernel/interfaces/ILineListener.h"
 #include "base/net/stratum/BaseClient.h"
@@ -74,6 +79,10 @@ protected:
     void deleteLater() override;
     void tick(uint64_t now) override;
 
+#   ifdef XMRIG_FEATURE_HANDOFF
+    int handoff(rapidjson::Value &state, rapidjson::Document &doc) override;
+#   endif
+
     void onResolved(const DnsRecords &records, int status, const char *error) override;
 
     inline bool hasExtension(Extension extension) const noexcept override   { return m_extensions.test(extension); }
@@ -97,6 +106,10 @@ private:
     class Socks5;
     class Tls;
 
+#   ifdef XMRIG_FEATURE_HANDOFF
+    bool adopt();
+#   endif
+
     bool parseJob(const rapidjson::Value &params, int *code);
     bool send(BIO *bio);
     bool verifyAlgorithm(const Algorithm &algorithm, const char *algo) const;
@@ -141,6 +154,10 @@ private:
     uintptr_t m_key             = 0;
     uv_tcp_t *m_socket          = nullptr;
 
+#   ifdef XMRIG_FEATURE_HANDOFF
+    rapidjson::Document m_jobParams;
+#   endif
+
     static Storage<Client> m_storage;
 };
 
@@ -42,6 +42,10 @@ protected:
     void login() override;
     void onClose() override;
 
+#   ifdef XMRIG_FEATURE_HANDOFF
+    inline int handoff(rapidjson::Value &, rapidjson::Document &) override { return -1; }
+#   endif
+
     bool handleResponse(int64_t id, const rapidjson::Value &result, const rapidjson::Value &error) override;
     void parseNotification(const char *method, const rapidjson::Value &params, const rapidjson::Value &error) override;
 
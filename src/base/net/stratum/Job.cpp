@@ -222,6 +222,7 @@ void xmrig::Job::copy(const Job &other)
     m_diff       = other.m_diff;
     m_height     = other.m_height;
     m_target     = other.m_target;
+    m_submitTarget = other.m_submitTarget;
     m_index      = other.m_index;
     m_seed       = other.m_seed;
     m_extraNonce = other.m_extraNonce;
@@ -269,6 +270,7 @@ void xmrig::Job::move(Job &&other)
     m_diff       = other.m_diff;
     m_height     = other.m_height;
     m_target     = other.m_target;
+    m_submitTarget = other.m_submitTarget;
     m_index      = other.m_index;
     m_seed       = std::move(other.m_seed);
     m_extraNonce = std::move(other.m_extraNonce);
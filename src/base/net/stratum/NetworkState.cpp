@@ -66,6 +66,13 @@ inline static void printHashes(uint64_t accepted, uint64_t hashes)
 }
 
 
+inline static void printPool(const std::string &pool, uint32_t weight, uint64_t time, uint64_t total, uint64_t accepted, uint64_t hashes)
+{
+    Log::print(GREEN_BOLD(" * ") WHITE_BOLD("%-17s") "weight " WHITE_BOLD("%u") " time " CYAN_BOLD("%1.1f%%") " accepted " CYAN_BOLD("%" PRIu64) " hashrate " CYAN_BOLD("%1.1f H/s"),
+               pool.c_str(), weight, total ? static_cast<double>(time) / total * 100.0 : 0.0, accepted, time ? static_cast<double>(hashes) * 1000.0 / time : 0.0);
+}
+
+
 inline static void printAvgTime(uint64_t time)
 {
     Log::print(GREEN_BOLD(" * ") WHITE_BOLD("%-17s") CSI "1;3%dm%1.1fs", "avg result time", (time < 10000 ? 3 : 2), time / 1000.0);
@@ -168,6 +175,28 @@ rapidjson::Value xmrig::NetworkState::getResults(rapidjson::Document &doc, int v
 
     results.AddMember("best", best, allocator);
 
+    if (m_pools.size() > 1) {
+        Value pools(kArrayType);
+
+        for (size_t i = 0; i < m_pools.size(); ++i) {
+            const auto &stats   = m_pools[i];
+            const uint64_t time = poolTime(i);
+
+            Value pool(kObjectType);
+            pool.AddMember("pool",          Value(stats.pool.c_str(), allocator), allocator);
+            pool.AddMember("weight",        stats.weight, allocator);
+            pool.AddMember("shares_good",   stats.accepted, allocator);
+            pool.AddMember("shares_total",  stats.accepted + stats.rejected, allocator);
+            pool.AddMember("hashes_total",  stats.hashes, allocator);
+            pool.AddMember("time",          time / 1000, allocator);
+            pool.AddMember("hashrate",      time ? static_cast<double>(stats.hashes) * 1000.0 / time : 0.0, allocator);
+
+            pools.PushBack(pool, allocator);
+        }
+
+        results.AddMember("pools", pools, allocator);
+    }
+
     if (version == 1) {
         results.AddMember("error_log", Value(kArrayType), allocator);
     }
@@ -214,6 +243,19 @@ void xmrig::NetworkState::printResults() const
         printAvgTime(avgTime());
     }
 
+    if (m_pools.size() > 1) {
+        uint64_t total = 0;
+        for (size_t i = 0; i < m_pools.size(); ++i) {
+            total += poolTime(i);
+        }
+
+        Log::print(MAGENTA_BOLD_S " - POOLS");
+
+        for (size_t i = 0; i < m_pools.size(); ++i) {
+            printPool(m_pools[i].pool, m_pools[i].weight, poolTime(i), total, m_pools[i].accepted, m_pools[i].hashes);
+        }
+    }
+
     Log::print(MAGENTA_BOLD_S " - TOP 10");
     Log::print(WHITE_BOLD_S "  # | DIFFICULTY | EFFORT %% |");
 
@@ -257,6 +299,10 @@ std::string xmrig::NetworkState::humanDiff(uint64_t diff)
 
 void xmrig::NetworkState::onActive(IStrategy *strategy, IClient *client)
 {
+    if (m_current >= 0 && m_active) {
+        m_pools[static_cast<size_t>(m_current)].time = poolTime(static_cast<size_t>(m_current));
+    }
+
     snprintf(m_pool, sizeof(m_pool) - 1, "%s:%d", client->pool().host().data(), client->pool().port());
 
     m_user           = client->pool().user();
@@ -267,6 +313,7 @@ void xmrig::NetworkState::onActive(IStrategy *strategy, IClient *client)
     m_fingerprint    = client->tlsFingerprint();
     m_active         = true;
     m_connectionTime = Chrono::steadyMSecs();
+    m_current        = static_cast<int>(&poolStats(client) - m_pools.data());
 
     StrategyProxy::onActive(strategy, client);
 }
@@ -295,6 +342,15 @@ void xmrig::NetworkState::onResultAccepted(IStrategy *strategy, IClient *client,
 {
     add(result, error);
 
+    auto &stats = poolStats(client);
+    if (error) {
+        stats.rejected++;
+    }
+    else {
+        stats.accepted++;
+        stats.hashes += result.diff;
+    }
+
     StrategyProxy::onResultAccepted(strategy, client, result, error);
 }
 
@@ -329,6 +385,35 @@ uint64_t xmrig::NetworkState::connectionTime() const
 }
 
 
+uint64_t xmrig::NetworkState::poolTime(size_t index) const
+{
+    const uint64_t time = m_pools[index].time;
+
+    return (m_active && m_current == static_cast<int>(index)) ? time + Chrono::steadyMSecs() - m_connectionTime : time;
+}
+
+
+xmrig::NetworkState::PoolStats &xmrig::NetworkState::poolStats(const IClient *client)
+{
+    char name[sizeof(m_pool)]{};
+    snprintf(name, sizeof(name) - 1, "%s:%d", client->pool().host().data(), client->pool().port());
+
+    // the same pool can be configured twice with different users, the strategy slot tells them apart
+    for (auto &stats : m_pools) {
+        if (stats.id == client->id() && stats.pool == name) {
+            return stats;
+        }
+    }
+
+    m_pools.emplace_back();
+    m_pools.back().id     = client->id();
+    m_pools.back().pool   = name;
+    m_pools.back().weight = client->pool().weight();
+
+    return m_pools.back();
+}
+
+
 void xmrig::NetworkState::add(const SubmitResult &result, const char *error)
 {
     if (error) {
@@ -351,6 +436,11 @@ void xmrig::NetworkState::add(const SubmitResult &result, const char *error)
 
 void xmrig::NetworkState::stop()
 {
+    if (m_current >= 0 && m_active) {
+        m_pools[static_cast<size_t>(m_current)].time = poolTime(static_cast<size_t>(m_current));
+    }
+
+    m_current     = -1;
     m_active      = false;
     m_diff        = 0;
     m_ip          = nullptr;
@@ -65,16 +65,31 @@ protected:
     void onResultAccepted(IStrategy *strategy, IClient *client, const SubmitResult &result, const char *error) override;
 
 private:
+    struct PoolStats
+    {
+        int id              = -1;
+        std::string pool;
+        uint32_t weight     = 0;
+        uint64_t accepted   = 0;
+        uint64_t hashes     = 0;
+        uint64_t rejected   = 0;
+        uint64_t time       = 0;
+    };
+
+    PoolStats &poolStats(const IClient *client);
     uint32_t latency() const;
     uint64_t avgTime() const;
     uint64_t connectionTime() const;
+    uint64_t poolTime(size_t index) const;
     void add(const SubmitResult &result, const char *error);
     void stop();
 
     Algorithm m_algorithm;
     bool m_active               = false;
     char m_pool[256]{};
+    int m_current               = -1;
     std::array<uint64_t, 10> m_topDiff { { } };
+    std::vector<PoolStats> m_pools;
     std::vector<uint16_t> m_latency;
     String m_fingerprint;
     String m_user;
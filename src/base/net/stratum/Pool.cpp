@@ -69,11 +69,14 @@ const char *Pool::kPass                   = "pass";
 const char *Pool::kRigId                  = "rig-id";
 const char *Pool::kSelfSelect             = "self-select";
 const char *Pool::kSOCKS5                 = "socks5";
+const char *Pool::kShareBuffer            = "share-buffer";
+const char *Pool::kSubmitDiff             = "submit-diff";
 const char *Pool::kSubmitToOrigin         = "submit-to-origin";
 const char *Pool::kTls                    = "tls";
 const char *Pool::kSni                    = "sni";
 const char *Pool::kUrl                    = "url";
 const char *Pool::kUser                   = "user";
+const char *Pool::kWeight                 = "weight";
 const char *Pool::kSpendSecretKey         = "spend-secret-key";
 const char *Pool::kNicehashHost           = "nicehash.com";
 
@@ -123,6 +126,9 @@ xmrig::Pool::Pool(const rapidjson::Value &object) :
     m_fingerprint    = Json::getString(object, kFingerprint);
     m_pollInterval   = Json::getUint64(object, kDaemonPollInterval, kDefaultPollInterval);
     m_jobTimeout     = Json::getUint64(object, kDaemonJobTimeout, kDefaultJobTimeout);
+    m_submitDiff     = Json::getUint64(object, kSubmitDiff);
+    m_weight         = Json::getUint(object, kWeight);
+    m_shareBuffer    = Json::getUint(object, kShareBuffer);
     m_algorithm      = Json::getString(object, kAlgo);
     m_coin           = Json::getString(object, kCoin);
     m_daemon         = Json::getString(object, kSelfSelect);
@@ -186,6 +192,9 @@ bool xmrig::Pool::isEqual(const Pool &other) const
             && m_jobTimeout   == other.m_jobTimeout
             && m_daemon       == other.m_daemon
             && m_proxy        == other.m_proxy
+            && m_submitDiff   == other.m_submitDiff
+            && m_weight       == other.m_weight
+            && m_shareBuffer  == other.m_shareBuffer
             );
 }
 
@@ -261,8 +270,13 @@ rapidjson::Value xmrig::Pool::toJSON(rapidjson::Document &doc) const
         else {
             obj.AddMember(StringRef(kKeepalive), m_keepAlive, allocator);
         }
+
+        obj.AddMember(StringRef(kSubmitDiff), m_submitDiff, allocator);
     }
 
+    obj.AddMember(StringRef(kWeight),       m_weight, allocator);
+    obj.AddMember(StringRef(kShareBuffer),  m_shareBuffer, allocator);
+
     obj.AddMember(StringRef(kEnabled),      m_flags.test(FLAG_ENABLED), allocator);
     obj.AddMember(StringRef(kTls),          isTLS(), allocator);
     obj.AddMember(StringRef(kSni),          isSNI(), allocator);
@@ -295,6 +309,14 @@ std::string xmrig::Pool::printableName() const
         out += std::string(" algo ") + WHITE_BOLD_S + (m_algorithm.isValid() ? m_algorithm.name() : "auto") + CLEAR;
     }
 
+    if (m_weight > 0) {
+        out += std::string(" weight ") + WHITE_BOLD_S + std::to_string(m_weight) + CLEAR;
+    }
+
+    if (m_shareBuffer > 0) {
+        out += std::string(" share-buffer ") + WHITE_BOLD_S + std::to_string(m_shareBuffer) + CLEAR;
+    }
+
     if (m_mode == MODE_SELF_SELECT) {
         out += std::string(" self-select ") + CSI "1;" + std::to_string(m_daemon.isTLS() ? 32 : 36) + "m" + m_daemon.url().data() + WHITE_BOLD_S + (m_submitToOrigin ? " submit-to-origin" : "") + CLEAR;
     }
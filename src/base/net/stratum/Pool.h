@@ -65,11 +65,14 @@ public:
     static const char *kRigId;
     static const char *kSelfSelect;
     static const char *kSOCKS5;
+    static const char *kShareBuffer;
+    static const char *kSubmitDiff;
     static const char *kSubmitToOrigin;
     static const char *kTls;
     static const char *kSni;
     static const char *kUrl;
     static const char *kUser;
+    static const char *kWeight;
     static const char *kSpendSecretKey;
     static const char *kDaemonZMQPort;
     static const char *kNicehashHost;
@@ -105,6 +108,9 @@ public:
     inline int zmq_port() const                         { return m_zmqPort; }
     inline uint64_t pollInterval() const                { return m_pollInterval; }
     inline uint64_t jobTimeout() const                  { return m_jobTimeout; }
+    inline uint64_t submitDiff() const                  { return m_submitDiff; }
+    inline uint32_t shareBuffer() const                 { return m_shareBuffer; }
+    inline uint32_t weight() const                      { return m_weight; }
     inline void setAlgo(const Algorithm &algorithm)     { m_algorithm = algorithm; }
     inline void setUrl(const char *url)                 { m_url = Url(url); }
     inline void setPassword(const String &password)     { m_password = password; }
@@ -153,6 +159,9 @@ private:
     String m_spendSecretKey;
     uint64_t m_pollInterval         = kDefaultPollInterval;
     uint64_t m_jobTimeout           = kDefaultJobTimeout;
+    uint64_t m_submitDiff           = 0;
+    uint32_t m_shareBuffer          = 0;
+    uint32_t m_weight               = 0;
     Url m_daemon;
     Url m_url;
     int m_zmqPort                   = -1;
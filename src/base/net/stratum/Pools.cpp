@@ -30,6 +30,7 @@
 #include "base/kernel/interfaces/IJsonReader.h"
 #include "base/net/stratum/strategies/FailoverStrategy.h"
 #include "base/net/stratum/strategies/SinglePoolStrategy.h"
+#include "base/net/stratum/strategies/SplitStrategy.h"
 #include "donate.h"
 
 
@@ -82,6 +83,17 @@ xmrig::IStrategy *xmrig::Pools::createStrategy(IStrategyListener *listener) cons
         }
     }
 
+    if (weighted() > 1) {
+        auto strategy = new SplitStrategy(retryPause(), retries(), listener);
+        for (const Pool &pool : m_data) {
+            if (pool.isEnabled() && pool.weight() > 0) {
+                strategy->add(pool);
+            }
+        }
+
+        return strategy;
+    }
+
     auto strategy = new FailoverStrategy(retryPause(), retries(), listener);
     for (const Pool &pool : m_data) {
         if (pool.isEnabled()) {
@@ -121,6 +133,19 @@ size_t xmrig::Pools::active() const
 }
 
 
+size_t xmrig::Pools::weighted() const
+{
+    size_t count = 0;
+    for (const Pool &pool : m_data) {
+        if (pool.isEnabled() && pool.weight() > 0) {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+
 void xmrig::Pools::load(const IJsonReader &reader)
 {
     m_data.clear();
@@ -75,6 +75,7 @@ public:
     IStrategy *createStrategy(IStrategyListener *listener) const;
     rapidjson::Value toJSON(rapidjson::Document &doc) const;
     size_t active() const;
+    size_t weighted() const;
     uint32_t benchSize() const;
     void load(const IJsonReader &reader);
     void print() const;
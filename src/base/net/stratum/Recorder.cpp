@@ -0,0 +1,118 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "base/net/stratum/Recorder.h"
+#include "base/io/log/FileLogWriter.h"
+#include "base/io/log/Log.h"
+#include "base/tools/Chrono.h"
+
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+
+namespace xmrig {
+
+
+const char *Recorder::kField    = "stratum-record";
+FileLogWriter *Recorder::m_writer = nullptr;
+String Recorder::m_fileName;
+uint64_t Recorder::m_start      = 0;
+
+
+} // namespace xmrig
+
+
+bool xmrig::Recorder::isEnabled()
+{
+    return m_writer && m_writer->isOpen();
+}
+
+
+void xmrig::Recorder::close(int id)
+{
+    write(kClosed, id, nullptr, 0);
+}
+
+
+void xmrig::Recorder::connect(int id, const char *url)
+{
+    write(kConnected, id, url, url ? strlen(url) : 0);
+}
+
+
+void xmrig::Recorder::init(const char *fileName)
+{
+    // the file can't be switched while recording, a new name is used after restart
+    if (isEnabled() || !fileName || !*fileName) {
+        return;
+    }
+
+    if (!m_writer) {
+        m_writer = new FileLogWriter();
+    }
+
+    m_fileName = fileName;
+
+    if (!m_writer->open(fileName)) {
+        LOG_ERR("failed to open stratum record file \"%s\"", fileName);
+
+        return;
+    }
+
+    m_start = Chrono::steadyMSecs();
+}
+
+
+void xmrig::Recorder::receive(int id, const char *line, size_t size)
+{
+    write(kReceive, id, line, size);
+}
+
+
+void xmrig::Recorder::send(int id, const char *data, size_t size)
+{
+    write(kSend, id, data, size);
+}
+
+
+void xmrig::Recorder::write(char type, int id, const char *data, size_t size)
+{
+    if (!isEnabled()) {
+        return;
+    }
+
+    while (size && (data[size - 1] == '\n' || data[size - 1] == '\r')) {
+        --size;
+    }
+
+    char prefix[48];
+    const int len = snprintf(prefix, sizeof(prefix), "%" PRIu64 " %c %d ", Chrono::steadyMSecs() - m_start, type, id);
+
+    std::string record;
+    record.reserve(len + size);
+    record.append(prefix, len);
+
+    if (size) {
+        record.append(data, size);
+    }
+
+    m_writer->writeLine(record.data(), record.size());
+}
@@ -0,0 +1,74 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_RECORDER_H
+#define XMRIG_RECORDER_H
+
+
+#include "base/tools/String.h"
+
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace xmrig {
+
+
+class FileLogWriter;
+
+
+/**
+ * Writes the raw stratum traffic of all pool connections to a file, to replay it later with xmrigReplay.
+ *
+ * Every record is one line: milliseconds since the recorder was started, record type, client id and payload.
+ * Types are '+' connected (payload is the pool URL), '-' disconnected, '>' line sent to the pool and
+ * '<' line received from the pool.
+ */
+class Recorder
+{
+public:
+    constexpr static char kConnected    = '+';
+    constexpr static char kClosed       = '-';
+    constexpr static char kSend         = '>';
+    constexpr static char kReceive      = '<';
+
+    static const char *kField;
+
+    inline static const String &fileName()      { return m_fileName; }
+
+    static bool isEnabled();
+    static void close(int id);
+    static void connect(int id, const char *url);
+    static void init(const char *fileName);
+    static void receive(int id, const char *line, size_t size);
+    static void send(int id, const char *data, size_t size);
+
+private:
+    static void write(char type, int id, const char *data, size_t size);
+
+    static FileLogWriter *m_writer;
+    static String m_fileName;
+    static uint64_t m_start;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_RECORDER_H */
@@ -0,0 +1,622 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "base/net/stratum/ReplayServer.h"
+#include "3rdparty/rapidjson/document.h"
+#include "3rdparty/rapidjson/stringbuffer.h"
+#include "3rdparty/rapidjson/writer.h"
+#include "base/io/json/Json.h"
+#include "base/io/log/Log.h"
+#include "base/io/Signals.h"
+#include "base/kernel/interfaces/ILineListener.h"
+#include "base/net/stratum/Recorder.h"
+#include "base/net/tools/LineReader.h"
+#include "base/net/tools/NetBuffer.h"
+#include "base/net/tools/TcpServer.h"
+#include "base/tools/Baton.h"
+#include "base/tools/Chrono.h"
+#include "base/tools/Timer.h"
+
+
+#include <cinttypes>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <uv.h>
+
+
+namespace xmrig {
+
+
+class ReplayWriteBaton : public Baton<uv_write_t>
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(ReplayWriteBaton)
+
+    inline ReplayWriteBaton(std::string &&data) :
+        m_data(std::move(data))
+    {
+        m_buf = uv_buf_init(&m_data.front(), m_data.size());
+    }
+
+    void write(uv_stream_t *stream)
+    {
+        uv_write(&req, stream, &m_buf, 1, [](uv_write_t *req, int) { delete reinterpret_cast<ReplayWriteBaton *>(req->data); });
+    }
+
+private:
+    std::string m_data;
+    uv_buf_t m_buf{};
+};
+
+
+class ReplayConnection : public ILineListener
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(ReplayConnection)
+
+    inline ReplayConnection(ReplayServer *server) :
+        m_reader(this),
+        m_server(server)
+    {
+        m_tcp = new uv_tcp_t;
+        m_tcp->data = this;
+
+        uv_tcp_init(uv_default_loop(), m_tcp);
+        uv_tcp_nodelay(m_tcp, 1);
+    }
+
+    inline ~ReplayConnection() override    { delete m_tcp; }
+    inline uv_stream_t *stream() const      { return reinterpret_cast<uv_stream_t *>(m_tcp); }
+
+    void close()
+    {
+        if (m_closing) {
+            return;
+        }
+
+        m_closing = true;
+        m_server->close(this);
+
+        uv_close(reinterpret_cast<uv_handle_t *>(m_tcp), [](uv_handle_t *handle) { delete static_cast<ReplayConnection *>(handle->data); });
+    }
+
+    void read(const char *data, ssize_t size)
+    {
+        if (size < 0) {
+            return close();
+        }
+
+        m_reader.parse(const_cast<char *>(data), static_cast<size_t>(size));
+    }
+
+    void send(std::string &&data)
+    {
+        if (m_closing) {
+            return;
+        }
+
+        data += '\n';
+
+        auto baton = new ReplayWriteBaton(std::move(data));
+        baton->write(stream());
+    }
+
+    void reply(int64_t id, const char *status)
+    {
+        char buf[128];
+        snprintf(buf, sizeof(buf), "{\"id\":%" PRId64 ",\"jsonrpc\":\"2.0\",\"error\":null,\"result\":{\"status\":\"%s\"}}", id, status);
+
+        send(buf);
+    }
+
+    void error(int64_t id, const char *message)
+    {
+        char buf[192];
+        snprintf(buf, sizeof(buf), "{\"id\":%" PRId64 ",\"jsonrpc\":\"2.0\",\"error\":{\"code\":-1,\"message\":\"%s\"}}", id, message);
+
+        send(buf);
+    }
+
+protected:
+    void onLine(char *line, size_t) override
+    {
+        rapidjson::Document doc;
+        if (doc.ParseInsitu(line).HasParseError() || !doc.IsObject()) {
+            LOG_ERR("invalid JSON received from the miner");
+
+            return close();
+        }
+
+        const char *method  = Json::getString(doc, "method", "");
+        const int64_t id    = Json::getInt64(doc, "id");
+        const auto &params  = Json::getObject(doc, "params");
+
+        if (strcmp(method, "login") == 0) {
+            return m_server->login(this, id);
+        }
+
+        if (strcmp(method, "submit") == 0) {
+            return m_server->submit(this, id, Json::getString(params, "job_id"), Json::getString(params, "nonce"), Json::getString(params, "result"));
+        }
+
+        if (strcmp(method, "keepalived") == 0) {
+            return reply(id, "KEEPALIVED");
+        }
+
+        error(id, "Unsupported method");
+    }
+
+private:
+    bool m_closing          = false;
+    LineReader m_reader;
+    ReplayServer *m_server;
+    uv_tcp_t *m_tcp;
+};
+
+
+static bool isHex(const char *str, size_t size)
+{
+    if (!str || strlen(str) != size) {
+        return false;
+    }
+
+    for (size_t i = 0; i < size; ++i) {
+        if (!isxdigit(static_cast<unsigned char>(str[i]))) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+// little endian hex number, as used for stratum targets and hashes
+static uint64_t fromHex(const char *str, size_t size)
+{
+    uint64_t value = 0;
+    char byte[3]   = {};
+
+    for (size_t i = size; i >= 2; i -= 2) {
+        memcpy(byte, str + i - 2, 2);
+        value = (value << 8) | strtoul(byte, nullptr, 16);
+    }
+
+    return value;
+}
+
+
+static uint64_t targetToDiff(const char *target)
+{
+    const size_t size = target ? strlen(target) : 0;
+
+    if (size == 8 && isHex(target, size)) {
+        const uint64_t value = fromHex(target, size);
+
+        return value ? 0xFFFFFFFFULL / value : 0;
+    }
+
+    if (size == 16 && isHex(target, size)) {
+        const uint64_t value = fromHex(target, size);
+
+        return value ? 0xFFFFFFFFFFFFFFFFULL / value : 0;
+    }
+
+    return 0;
+}
+
+
+} // namespace xmrig
+
+
+xmrig::ReplayServer::ReplayServer(int clientId, double speed) :
+    m_speed(speed > 0.0 ? speed : 1.0),
+    m_clientId(clientId)
+{
+    m_timer     = std::make_shared<Timer>(this);
+    m_signals   = std::make_shared<Signals>(this);
+}
+
+
+xmrig::ReplayServer::~ReplayServer()
+{
+    NetBuffer::destroy();
+}
+
+
+bool xmrig::ReplayServer::load(const char *fileName)
+{
+    std::ifstream file(fileName, std::ios::in | std::ios::binary);
+    if (!file.is_open()) {
+        LOG_ERR("failed to open \"%s\"", fileName);
+
+        return false;
+    }
+
+    Session *session = nullptr;
+    std::string line;
+
+    while (std::getline(file, line)) {
+        while (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+
+        char *end           = nullptr;
+        const uint64_t time = strtoull(line.c_str(), &end, 10);
+
+        if (end == line.c_str() || end[0] != ' ' || end[1] == '\0' || end[2] != ' ') {
+            continue;
+        }
+
+        const char type = end[1];
+        const int id    = static_cast<int>(strtol(end + 3, &end, 10));
+
+        if (id != m_clientId) {
+            continue;
+        }
+
+        std::string data(*end == ' ' ? end + 1 : end);
+
+        if (type == Recorder::kConnected) {
+            m_sessions.emplace_back();
+            session      = &m_sessions.back();
+            session->url = std::move(data);
+        }
+
+        if (!session) {
+            continue;
+        }
+
+        session->end = time;
+
+        if (type == Recorder::kClosed) {
+            session->closed = true;
+            session         = nullptr;
+
+            continue;
+        }
+
+        if (type != Recorder::kSend && type != Recorder::kReceive) {
+            continue;
+        }
+
+        rapidjson::Document doc;
+        if (doc.Parse(data.c_str()).HasParseError() || !doc.IsObject()) {
+            continue;
+        }
+
+        if (type == Recorder::kSend) {
+            if (strcmp(Json::getString(doc, "method", ""), "login") == 0) {
+                session->loginId = Json::getInt64(doc, "id", -1);
+            }
+        }
+        else if (session->login.empty()) {
+            if (session->loginId >= 0 && Json::getInt64(doc, "id", -1) == session->loginId) {
+                session->login = std::move(data);
+                session->start = time;
+            }
+        }
+        else if (doc.HasMember("method")) {
+            session->events.emplace_back(time, std::move(data));
+        }
+    }
+
+    // connections which never got a login response can't be replayed
+    for (auto it = m_sessions.begin(); it != m_sessions.end();) {
+        it = it->login.empty() ? m_sessions.erase(it) : it + 1;
+    }
+
+    if (m_sessions.empty()) {
+        LOG_ERR("no replayable session of client %d in \"%s\"", m_clientId, fileName);
+
+        return false;
+    }
+
+    size_t events = 0;
+    for (const auto &s : m_sessions) {
+        events += s.events.size();
+    }
+
+    Log::print(GREEN_BOLD(" * ") WHITE_BOLD("%-13s") CYAN_BOLD("%s") WHITE_BOLD(" client ") CYAN_BOLD("%d") WHITE_BOLD(" sessions ") CYAN_BOLD("%zu")
+               WHITE_BOLD(" notifications ") CYAN_BOLD("%zu"), "RECORD", fileName, m_clientId, m_sessions.size(), events);
+
+    Log::print(GREEN_BOLD(" * ") WHITE_BOLD("%-13s") CYAN_BOLD("%s") WHITE_BOLD(" speed ") CYAN_BOLD("%.2fx"), "POOL", m_sessions.front().url.c_str(), m_speed);
+
+    return true;
+}
+
+
+int xmrig::ReplayServer::bind(const String &host, uint16_t port)
+{
+    m_host      = host;
+    m_server    = std::make_shared<TcpServer>(m_host, port, this);
+
+    const int rc = m_server->bind();
+    if (rc < 0) {
+        LOG_ERR("failed to bind %s:%u \"%s\"", m_host.data(), port, uv_strerror(rc));
+
+        return rc;
+    }
+
+    Log::print(GREEN_BOLD(" * ") WHITE_BOLD("%-13s") CYAN_BOLD("%s:%d"), "LISTEN", m_host.data(), rc);
+
+    return rc;
+}
+
+
+void xmrig::ReplayServer::close(ReplayConnection *connection)
+{
+    if (connection != m_connection) {
+        return;
+    }
+
+    m_connection = nullptr;
+    m_timer->stop();
+
+    LOG_WARN("miner disconnected in session %zu, the next login starts the next session", m_session + 1);
+
+    if (++m_session >= m_sessions.size()) {
+        finish();
+    }
+}
+
+
+void xmrig::ReplayServer::login(ReplayConnection *connection, int64_t id)
+{
+    if (m_session >= m_sessions.size()) {
+        connection->error(id, "Replay finished");
+
+        return connection->close();
+    }
+
+    if (m_connection && m_connection != connection) {
+        auto previous = m_connection;
+        m_connection  = nullptr;
+        previous->close();
+    }
+
+    const auto &session = m_sessions[m_session];
+
+    rapidjson::Document doc;
+    doc.Parse(session.login.c_str());
+    doc["id"] = id;
+
+    const auto &job = Json::getObject(Json::getObject(doc, "result"), "job");
+    if (job.IsObject()) {
+        addJob(job);
+    }
+
+    rapidjson::StringBuffer buffer(nullptr, 512);
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    doc.Accept(writer);
+
+    m_connection = connection;
+    m_connection->send(std::string(buffer.GetString(), buffer.GetSize()));
+
+    m_event     = 0;
+    m_loginTime = Chrono::steadyMSecs();
+
+    if (!m_startTime) {
+        m_startTime = m_loginTime;
+    }
+
+    LOG_INFO("session %zu/%zu started, %zu notifications", m_session + 1, m_sessions.size(), session.events.size());
+
+    next();
+}
+
+
+void xmrig::ReplayServer::submit(ReplayConnection *connection, int64_t id, const char *jobId, const char *nonce, const char *result)
+{
+    if (connection != m_connection) {
+        return connection->error(id, "Unauthenticated");
+    }
+
+    auto it = jobId ? m_jobs.find(jobId) : m_jobs.end();
+    if (it == m_jobs.end() || !isHex(nonce, 8) || !isHex(result, 64)) {
+        m_stats.invalid++;
+
+        LOG_ERR("invalid share, job \"%s\"", jobId ? jobId : "");
+
+        return connection->error(id, it == m_jobs.end() ? "Unknown job" : "Malformed share");
+    }
+
+    if (!m_shares.insert(it->first + nonce).second) {
+        m_stats.duplicate++;
+
+        LOG_ERR("duplicate share, job \"%s\" nonce %s", jobId, nonce);
+
+        return connection->error(id, "Duplicate share");
+    }
+
+    const uint64_t value = fromHex(result + 48, 16);
+    const uint64_t diff  = value ? 0xFFFFFFFFFFFFFFFFULL / value : 0xFFFFFFFFFFFFFFFFULL;
+
+    if (diff < it->second.diff) {
+        m_stats.low++;
+
+        LOG_ERR("low difficulty share, job \"%s\" diff %" PRIu64 "/%" PRIu64, jobId, diff, it->second.diff);
+
+        return connection->error(id, "Low difficulty share");
+    }
+
+    m_stats.accepted++;
+    m_stats.hashes += it->second.diff;
+
+    if (&it->second != m_current) {
+        const uint64_t delay = Chrono::steadyMSecs() - it->second.replaced;
+
+        m_stats.stale++;
+        m_stats.staleDelay += delay;
+        m_stats.staleMax    = std::max(m_stats.staleMax, delay);
+
+        LOG_WARN("stale share, job \"%s\" replaced %" PRIu64 " ms ago", jobId, delay);
+    }
+
+    connection->reply(id, "OK");
+}
+
+
+void xmrig::ReplayServer::onConnection(uv_stream_t *stream, uint16_t)
+{
+    auto connection = new ReplayConnection(this);
+    if (uv_accept(stream, connection->stream()) != 0) {
+        return connection->close();
+    }
+
+    uv_read_start(connection->stream(), NetBuffer::onAlloc,
+        [](uv_stream_t *tcp, ssize_t nread, const uv_buf_t *buf)
+        {
+            static_cast<ReplayConnection *>(tcp->data)->read(buf->base, nread);
+
+            NetBuffer::release(buf);
+        });
+}
+
+
+void xmrig::ReplayServer::onSignal(int signum)
+{
+    switch (signum) {
+    case SIGHUP:
+#   ifdef SIGUSR1
+    case SIGUSR1:
+#   endif
+        return printSummary();
+
+    default:
+        break;
+    }
+
+    finish();
+}
+
+
+void xmrig::ReplayServer::onTimer(const Timer *)
+{
+    if (!m_connection) {
+        return;
+    }
+
+    const auto &session     = m_sessions[m_session];
+    const uint64_t elapsed  = Chrono::steadyMSecs() - m_loginTime;
+
+    for (; m_event < session.events.size() && delay(session.events[m_event].time) <= elapsed; ++m_event) {
+        std::string data = session.events[m_event].data;
+
+        rapidjson::Document doc;
+        doc.Parse(data.c_str());
+
+        if (strcmp(Json::getString(doc, "method", ""), "job") == 0) {
+            addJob(Json::getObject(doc, "params"));
+        }
+
+        m_connection->send(std::move(data));
+    }
+
+    if (m_event < session.events.size() || delay(session.end) > elapsed) {
+        return next();
+    }
+
+    ++m_session;
+
+    if (session.closed) {
+        LOG_INFO("session %zu/%zu closed as recorded", m_session, m_sessions.size());
+
+        auto connection = m_connection;
+        m_connection    = nullptr;
+        connection->close();
+    }
+
+    if (m_session >= m_sessions.size()) {
+        finish();
+    }
+}
+
+
+uint64_t xmrig::ReplayServer::delay(uint64_t time) const
+{
+    const uint64_t start = m_sessions[m_session].start;
+
+    return time > start ? static_cast<uint64_t>((time - start) / m_speed) : 0;
+}
+
+
+void xmrig::ReplayServer::addJob(const rapidjson::Value &params)
+{
+    const char *id = Json::getString(params, "job_id");
+    if (!id) {
+        return;
+    }
+
+    if (m_current) {
+        m_current->replaced = Chrono::steadyMSecs();
+    }
+
+    m_current       = &m_jobs[id];
+    m_current->diff = targetToDiff(Json::getString(params, "target"));
+
+    m_stats.jobs++;
+}
+
+
+void xmrig::ReplayServer::finish()
+{
+    printSummary();
+
+    if (m_connection) {
+        auto connection = m_connection;
+        m_connection    = nullptr;
+        connection->close();
+    }
+
+    m_timer->stop();
+    m_server.reset();
+    m_signals.reset();
+
+    uv_stop(uv_default_loop());
+}
+
+
+void xmrig::ReplayServer::next()
+{
+    const auto &session     = m_sessions[m_session];
+    const uint64_t elapsed  = Chrono::steadyMSecs() - m_loginTime;
+    const uint64_t due      = delay(m_event < session.events.size() ? session.events[m_event].time : session.end);
+
+    m_timer->singleShot(due > elapsed ? due - elapsed : 0);
+}
+
+
+void xmrig::ReplayServer::printSummary() const
+{
+    const double elapsed = m_startTime ? (Chrono::steadyMSecs() - m_startTime) / 1000.0 : 0.0;
+    const uint64_t total = m_stats.accepted + m_stats.low + m_stats.duplicate + m_stats.invalid;
+
+    Log::print(GREEN_BOLD(" * ") WHITE_BOLD("%-13s") CYAN_BOLD("%zu/%zu") WHITE_BOLD(" sessions, ") CYAN_BOLD("%" PRIu64) WHITE_BOLD(" jobs in ")
+               CYAN_BOLD("%.1f s"), "REPLAY", std::min(m_session, m_sessions.size()), m_sessions.size(), m_stats.jobs, elapsed);
+
+    Log::print(GREEN_BOLD(" * ") WHITE_BOLD("%-13s") CYAN_BOLD("%" PRIu64) WHITE_BOLD(" accepted ") CYAN_BOLD("%" PRIu64) WHITE_BOLD(" low diff ")
+               CYAN_BOLD("%" PRIu64) WHITE_BOLD(" duplicate ") CYAN_BOLD("%" PRIu64) WHITE_BOLD(" invalid"),
+               "SHARES", m_stats.accepted, m_stats.low, m_stats.duplicate, m_stats.invalid);
+
+    Log::print(GREEN_BOLD(" * ") WHITE_BOLD("%-13s") CYAN_BOLD("%" PRIu64) WHITE_BOLD(" (%.2f%%) delay avg ") CYAN_BOLD("%" PRIu64 " ms")
+               WHITE_BOLD(" max ") CYAN_BOLD("%" PRIu64 " ms"), "STALE", m_stats.stale, total ? m_stats.stale * 100.0 / total : 0.0,
+               m_stats.stale ? m_stats.staleDelay / m_stats.stale : 0, m_stats.staleMax);
+
+    Log::print(GREEN_BOLD(" * ") WHITE_BOLD("%-13s") CYAN_BOLD("%.1f H/s"), "HASHRATE", elapsed > 0.0 ? m_stats.hashes / elapsed : 0.0);
+}
@@ -0,0 +1,142 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_REPLAYSERVER_H
+#define XMRIG_REPLAYSERVER_H
+
+
+#include "3rdparty/rapidjson/fwd.h"
+#include "base/kernel/interfaces/ISignalListener.h"
+#include "base/kernel/interfaces/ITcpServerListener.h"
+#include "base/kernel/interfaces/ITimerListener.h"
+#include "base/tools/Object.h"
+#include "base/tools/String.h"
+
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+
+namespace xmrig {
+
+
+class ReplayConnection;
+class Signals;
+class TcpServer;
+class Timer;
+
+
+/**
+ * Fake pool which plays a session written by Recorder back to the miner.
+ *
+ * Every recorded connection of the selected client is replayed to one miner connection: the recorded login
+ * response is returned for the login request, then the pool notifications follow with the original timing
+ * (divided by the speed multiplier) and the connection is closed where the pool connection was lost. Shares are
+ * not forwarded anywhere, they are checked against the replayed jobs and answered by the server itself.
+ */
+class ReplayServer : public ITcpServerListener, public ITimerListener, public ISignalListener
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(ReplayServer)
+
+    ReplayServer(int clientId, double speed);
+    ~ReplayServer() override;
+
+    bool load(const char *fileName);
+    int bind(const String &host, uint16_t port);
+
+    void close(ReplayConnection *connection);
+    void login(ReplayConnection *connection, int64_t id);
+    void submit(ReplayConnection *connection, int64_t id, const char *jobId, const char *nonce, const char *result);
+
+protected:
+    void onConnection(uv_stream_t *stream, uint16_t port) override;
+    void onSignal(int signum) override;
+    void onTimer(const Timer *timer) override;
+
+private:
+    struct Event
+    {
+        inline Event(uint64_t time, std::string &&data) : time(time), data(std::move(data)) {}
+
+        uint64_t time;
+        std::string data;
+    };
+
+    struct Session
+    {
+        bool closed         = false;
+        int64_t loginId     = -1;
+        std::string login;
+        std::string url;
+        std::vector<Event> events;
+        uint64_t end        = 0;
+        uint64_t start      = 0;
+    };
+
+    struct JobInfo
+    {
+        uint64_t diff       = 0;
+        uint64_t replaced   = 0;
+    };
+
+    struct Stats
+    {
+        uint64_t accepted   = 0;
+        uint64_t duplicate  = 0;
+        uint64_t hashes     = 0;
+        uint64_t invalid    = 0;
+        uint64_t jobs       = 0;
+        uint64_t low        = 0;
+        uint64_t stale      = 0;
+        uint64_t staleDelay = 0;
+        uint64_t staleMax   = 0;
+    };
+
+    uint64_t delay(uint64_t time) const;
+    void addJob(const rapidjson::Value &params);
+    void finish();
+    void next();
+    void printSummary() const;
+
+    const double m_speed;
+    const int m_clientId;
+    JobInfo *m_current                  = nullptr;
+    ReplayConnection *m_connection      = nullptr;
+    size_t m_event                      = 0;
+    size_t m_session                    = 0;
+    Stats m_stats;
+    std::map<std::string, JobInfo> m_jobs;
+    std::set<std::string> m_shares;
+    std::shared_ptr<Signals> m_signals;
+    std::shared_ptr<TcpServer> m_server;
+    std::shared_ptr<Timer> m_timer;
+    std::vector<Session> m_sessions;
+    String m_host;
+    uint64_t m_loginTime                = 0;
+    uint64_t m_startTime                = 0;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_REPLAYSERVER_H */
@@ -74,6 +74,10 @@ protected:
     int64_t submit(const JobResult &result) override;
     void tick(uint64_t now) override;
 
+#   ifdef XMRIG_FEATURE_HANDOFF
+    inline int handoff(rapidjson::Value &, rapidjson::Document &) override { return -1; }
+#   endif
+
     // IClientListener
     inline void onClose(IClient *, int failures) override                                           { m_listener->onClose(this, failures); setState(IdleState); m_active = false; }
     inline void onLoginSuccess(IClient *) override                                                  { m_listener->onLoginSuccess(this); setState(IdleState); m_active = true; }
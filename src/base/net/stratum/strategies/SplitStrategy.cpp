@@ -0,0 +1,297 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "base/net/stratum/strategies/SplitStrategy.h"
+#include "3rdparty/rapidjson/document.h"
+#include "base/io/log/Log.h"
+#include "base/io/log/Tags.h"
+#include "base/kernel/interfaces/IClient.h"
+#include "base/kernel/interfaces/IStrategyListener.h"
+#include "base/tools/Chrono.h"
+#include "net/JobResult.h"
+
+
+xmrig::SplitStrategy::SplitStrategy(int retryPause, int retries, IStrategyListener *listener) :
+    m_retries(retries),
+    m_retryPause(retryPause),
+    m_listener(listener)
+{
+}
+
+
+xmrig::SplitStrategy::~SplitStrategy()
+{
+    for (auto &slot : m_pools) {
+        slot.client->deleteLater();
+    }
+}
+
+
+void xmrig::SplitStrategy::add(const Pool &pool)
+{
+    IClient *client = pool.createClient(static_cast<int>(m_pools.size()), this);
+
+    client->setRetries(m_retries);
+    client->setRetryPause(m_retryPause * 1000);
+
+    m_pools.emplace_back(client, pool.weight());
+    m_weights += pool.weight();
+}
+
+
+int64_t xmrig::SplitStrategy::submit(const JobResult &result)
+{
+    // results of the previous slice may still arrive after a switch, they belong to the pool that sent the job
+    IClient *target = nullptr;
+
+    for (const auto &slot : m_pools) {
+        const Job &job = slot.client->job();
+        if (job.clientId() != result.clientId) {
+            continue;
+        }
+
+        if (job.id() == result.jobId) {
+            return slot.client->submit(result);
+        }
+
+        if (!target) {
+            target = slot.client;
+        }
+    }
+
+    return target ? target->submit(result) : -1;
+}
+
+
+void xmrig::SplitStrategy::connect()
+{
+    for (auto &slot : m_pools) {
+        slot.client->connect();
+    }
+}
+
+
+void xmrig::SplitStrategy::resume()
+{
+    if (!isActive()) {
+        return;
+    }
+
+    m_listener->onJob(this, active(), active()->job(), rapidjson::Value(rapidjson::kNullType));
+}
+
+
+void xmrig::SplitStrategy::setAlgo(const Algorithm &algo)
+{
+    for (auto &slot : m_pools) {
+        slot.client->setAlgo(algo);
+    }
+}
+
+
+void xmrig::SplitStrategy::setProxy(const ProxyUrl &proxy)
+{
+    for (auto &slot : m_pools) {
+        slot.client->setProxy(proxy);
+    }
+}
+
+
+void xmrig::SplitStrategy::stop()
+{
+    for (auto &slot : m_pools) {
+        slot.client->disconnect();
+        slot.ready = false;
+    }
+
+    m_active = -1;
+
+    m_listener->onPause(this);
+}
+
+
+void xmrig::SplitStrategy::tick(uint64_t now)
+{
+    for (auto &slot : m_pools) {
+        slot.client->tick(now);
+    }
+
+    if (isActive()) {
+        account(now);
+
+        if (now - m_slice < kSliceTime) {
+            return;
+        }
+    }
+
+    m_slice = now;
+
+    const int next = select();
+    if (next >= 0 && next != m_active) {
+        activate(next, now);
+        resume();
+    }
+}
+
+
+void xmrig::SplitStrategy::onClose(IClient *client, int failures)
+{
+    if (failures == -1) {
+        return;
+    }
+
+    m_pools[static_cast<size_t>(client->id())].ready = false;
+
+    if (m_active != client->id()) {
+        return;
+    }
+
+    const uint64_t now = Chrono::steadyMSecs();
+    account(now);
+
+    m_active = -1;
+
+    const int next = select();
+    if (next >= 0) {
+        activate(next, now);
+
+        return resume();
+    }
+
+    m_listener->onPause(this);
+}
+
+
+void xmrig::SplitStrategy::onJobReceived(IClient *client, const Job &job, const rapidjson::Value &params)
+{
+    if (m_active == client->id()) {
+        m_listener->onJob(this, client, job, params);
+    }
+}
+
+
+void xmrig::SplitStrategy::onLogin(IClient *client, rapidjson::Document &doc, rapidjson::Value &params)
+{
+    m_listener->onLogin(this, client, doc, params);
+}
+
+
+void xmrig::SplitStrategy::onLoginSuccess(IClient *client)
+{
+    auto &slot = m_pools[static_cast<size_t>(client->id())];
+    slot.ready = true;
+
+    if (share(slot) > slot.time + kMaxDebt) {
+        slot.time = share(slot) - kMaxDebt;
+    }
+
+    // the job follows in onJobReceived()
+    if (!isActive()) {
+        activate(client->id(), Chrono::steadyMSecs());
+    }
+}
+
+
+void xmrig::SplitStrategy::onResultAccepted(IClient *client, const SubmitResult &result, const char *error)
+{
+    m_listener->onResultAccepted(this, client, result, error);
+}
+
+
+void xmrig::SplitStrategy::onVerifyAlgorithm(const IClient *client, const Algorithm &algorithm, bool *ok)
+{
+    m_listener->onVerifyAlgorithm(this, client, algorithm, ok);
+}
+
+
+int xmrig::SplitStrategy::select() const
+{
+    int next        = -1;
+    int64_t deficit = 0;
+
+    for (size_t i = 0; i < m_pools.size(); ++i) {
+        const auto &slot = m_pools[i];
+        if (!slot.ready || !slot.client->job().isValid()) {
+            continue;
+        }
+
+        const int64_t value = static_cast<int64_t>(share(slot)) - static_cast<int64_t>(slot.time);
+        if (next < 0 || value > deficit) {
+            next    = static_cast<int>(i);
+            deficit = value;
+        }
+    }
+
+    return next;
+}
+
+
+void xmrig::SplitStrategy::account(uint64_t now)
+{
+    const uint64_t elapsed = now - m_since;
+
+    m_pools[static_cast<size_t>(m_active)].time += elapsed;
+    m_time  += elapsed;
+    m_since  = now;
+}
+
+
+void xmrig::SplitStrategy::activate(int index, uint64_t now)
+{
+    const IClient *previous = nullptr;
+
+    if (isActive()) {
+        account(now);
+        previous = active();
+    }
+
+    m_active = index;
+    m_since  = now;
+    m_slice  = now;
+
+    verify(previous, active());
+
+    m_listener->onActive(this, active());
+}
+
+
+void xmrig::SplitStrategy::verify(const IClient *previous, const IClient *next)
+{
+    if (m_warned || !previous) {
+        return;
+    }
+
+    const Job &a = previous->job();
+    const Job &b = next->job();
+
+    if (!a.isValid() || !b.isValid()) {
+        return;
+    }
+
+    if (a.algorithm() != b.algorithm()) {
+        LOG_WARN("%s " YELLOW("split pools use different algorithms (%s, %s), every switch restarts the workers"), Tags::network(), a.algorithm().name(), b.algorithm().name());
+    }
+    else if (a.algorithm().family() == Algorithm::RANDOM_X && a.seed() != b.seed()) {
+        LOG_WARN("%s " YELLOW("split pools use different RandomX seeds, every switch rebuilds the dataset"), Tags::network());
+    }
+    else {
+        return;
+    }
+
+    m_warned = true;
+}
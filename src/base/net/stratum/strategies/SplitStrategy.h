@@ -0,0 +1,114 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_SPLITSTRATEGY_H
+#define XMRIG_SPLITSTRATEGY_H
+
+
+#include <vector>
+
+
+#include "base/kernel/interfaces/IClientListener.h"
+#include "base/kernel/interfaces/IStrategy.h"
+#include "base/net/stratum/Pool.h"
+#include "base/tools/Object.h"
+
+
+namespace xmrig {
+
+
+class IStrategyListener;
+
+
+/**
+ * Keeps all weighted pools connected and mines them in turn.
+ *
+ * The miner works on one job at a time, so the split is done in time slices: after every slice the pool that
+ * is furthest behind its share of the total mined time (weight / sum of weights) gets the next one. Time a pool
+ * could not use because it had no job is made up later, up to kMaxDebt.
+ *
+ * Mined time stands in for hashes, the hashrate is the same for every slice as long as the pools share the
+ * algorithm. Accepted difficulty is not used to steer the split, with a few shares per slice it is mostly noise.
+ */
+class SplitStrategy : public IStrategy, public IClientListener
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(SplitStrategy)
+
+    constexpr static uint64_t kSliceTime    = 20 * 1000;
+    constexpr static uint64_t kMaxDebt      = 5 * kSliceTime;
+
+    SplitStrategy(int retryPause, int retries, IStrategyListener *listener);
+    ~SplitStrategy() override;
+
+    void add(const Pool &pool);
+
+protected:
+    inline bool isActive() const override           { return m_active >= 0; }
+    inline IClient *client() const override         { return isActive() ? active() : m_pools.front().client; }
+
+    int64_t submit(const JobResult &result) override;
+    void connect() override;
+    void resume() override;
+    void setAlgo(const Algorithm &algo) override;
+    void setProxy(const ProxyUrl &proxy) override;
+    void stop() override;
+    void tick(uint64_t now) override;
+
+    void onClose(IClient *client, int failures) override;
+    void onJobReceived(IClient *client, const Job &job, const rapidjson::Value &params) override;
+    void onLogin(IClient *client, rapidjson::Document &doc, rapidjson::Value &params) override;
+    void onLoginSuccess(IClient *client) override;
+    void onResultAccepted(IClient *client, const SubmitResult &result, const char *error) override;
+    void onVerifyAlgorithm(const IClient *client, const Algorithm &algorithm, bool *ok) override;
+
+private:
+    struct Slot
+    {
+        inline Slot(IClient *client, uint32_t weight) : client(client), weight(weight) {}
+
+        IClient *client;
+        uint32_t weight;
+        uint64_t time   = 0;
+        bool ready      = false;
+    };
+
+    inline IClient *active() const                  { return m_pools[static_cast<size_t>(m_active)].client; }
+    inline uint64_t share(const Slot &slot) const   { return m_time * slot.weight / m_weights; }
+
+    int select() const;
+    void account(uint64_t now);
+    void activate(int index, uint64_t now);
+    void verify(const IClient *previous, const IClient *next);
+
+    bool m_warned           = false;
+    const int m_retries;
+    const int m_retryPause;
+    int m_active            = -1;
+    IStrategyListener *m_listener;
+    std::vector<Slot> m_pools;
+    uint32_t m_weights      = 0;
+    uint64_t m_since        = 0;
+    uint64_t m_slice        = 0;
+    uint64_t m_time         = 0;
+};
+
+
+} /* namespace xmrig */
+
+#endif /* XMRIG_SPLITSTRATEGY_H */
@@ -42,6 +42,8 @@ public:
     LineReader(ILineListener *listener) : m_listener(listener) {}
     ~LineReader();
 
+    inline const char *data() const                  { return m_buf; }
+    inline size_t size() const                       { return m_buf ? m_pos : 0; }
     inline void setListener(ILineListener *listener) { m_listener = listener; }
 
     void parse(char *data, size_t size);
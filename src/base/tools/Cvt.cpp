@@ -30,9 +30,191 @@
 #endif
 
 
+#if defined(__SSE2__) || defined(_M_AMD64) || defined(_M_X64)
+#   define XMRIG_CVT_SSE2
+#   include <emmintrin.h>
+#   ifdef __AVX2__
+#       define XMRIG_CVT_AVX2
+#       include <immintrin.h>
+#   endif
+#elif defined(__aarch64__)
+#   define XMRIG_CVT_NEON
+#   include <arm_neon.h>
+#endif
+
+
 namespace xmrig {
 
 
+#if defined(XMRIG_CVT_SSE2)
+static inline __m128i hex_nibbles_to_chars(__m128i n)
+{
+    // '0' + n, plus 'a' - '0' - 10 for nibbles above 9
+    const __m128i alpha = _mm_and_si128(_mm_cmpgt_epi8(n, _mm_set1_epi8(9)), _mm_set1_epi8(39));
+
+    return _mm_add_epi8(_mm_add_epi8(n, _mm_set1_epi8('0')), alpha);
+}
+
+
+static inline __m128i hex_chars_to_nibbles(__m128i c, __m128i &valid)
+{
+    const __m128i digit     = _mm_sub_epi8(c, _mm_set1_epi8('0'));
+    const __m128i alpha     = _mm_sub_epi8(_mm_or_si128(c, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    const __m128i is_digit  = _mm_and_si128(_mm_cmpgt_epi8(digit, _mm_set1_epi8(-1)), _mm_cmplt_epi8(digit, _mm_set1_epi8(10)));
+    const __m128i is_alpha  = _mm_and_si128(_mm_cmpgt_epi8(alpha, _mm_set1_epi8(-1)), _mm_cmplt_epi8(alpha, _mm_set1_epi8(6)));
+
+    valid = _mm_and_si128(valid, _mm_or_si128(is_digit, is_alpha));
+
+    return _mm_or_si128(_mm_and_si128(is_digit, digit), _mm_and_si128(is_alpha, _mm_add_epi8(alpha, _mm_set1_epi8(10))));
+}
+
+
+static inline __m128i hex_pack_nibbles(__m128i n)
+{
+    // every 16-bit lane holds the high nibble in the low byte and the low nibble in the high byte
+    return _mm_or_si128(_mm_and_si128(_mm_slli_epi16(n, 4), _mm_set1_epi16(0xf0)), _mm_srli_epi16(n, 8));
+}
+#endif
+
+
+#if defined(XMRIG_CVT_AVX2)
+static inline __m256i hex_nibbles_to_chars(__m256i n)
+{
+    const __m256i alpha = _mm256_and_si256(_mm256_cmpgt_epi8(n, _mm256_set1_epi8(9)), _mm256_set1_epi8(39));
+
+    return _mm256_add_epi8(_mm256_add_epi8(n, _mm256_set1_epi8('0')), alpha);
+}
+
+
+static inline __m256i hex_chars_to_nibbles(__m256i c, __m256i &valid)
+{
+    const __m256i digit     = _mm256_sub_epi8(c, _mm256_set1_epi8('0'));
+    const __m256i alpha     = _mm256_sub_epi8(_mm256_or_si256(c, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+    const __m256i is_digit  = _mm256_and_si256(_mm256_cmpgt_epi8(digit, _mm256_set1_epi8(-1)), _mm256_cmpgt_epi8(_mm256_set1_epi8(10), digit));
+    const __m256i is_alpha  = _mm256_and_si256(_mm256_cmpgt_epi8(alpha, _mm256_set1_epi8(-1)), _mm256_cmpgt_epi8(_mm256_set1_epi8(6), alpha));
+
+    valid = _mm256_and_si256(valid, _mm256_or_si256(is_digit, is_alpha));
+
+    return _mm256_or_si256(_mm256_and_si256(is_digit, digit), _mm256_and_si256(is_alpha, _mm256_add_epi8(alpha, _mm256_set1_epi8(10))));
+}
+
+
+static inline __m256i hex_pack_nibbles(__m256i n)
+{
+    return _mm256_or_si256(_mm256_and_si256(_mm256_slli_epi16(n, 4), _mm256_set1_epi16(0xf0)), _mm256_srli_epi16(n, 8));
+}
+#endif
+
+
+// Encodes whole 16/32 byte blocks, returns the number of input bytes consumed.
+static inline size_t hex_encode_blocks(char *hex, const uint8_t *bin, size_t bin_len)
+{
+    size_t i = 0;
+
+#   if defined(XMRIG_CVT_AVX2)
+    for (; i + 32 <= bin_len; i += 32) {
+        const __m256i x     = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(bin + i));
+        const __m256i mask  = _mm256_set1_epi8(0x0f);
+        const __m256i hc    = hex_nibbles_to_chars(_mm256_and_si256(_mm256_srli_epi16(x, 4), mask));
+        const __m256i lc    = hex_nibbles_to_chars(_mm256_and_si256(x, mask));
+        const __m256i a     = _mm256_unpacklo_epi8(hc, lc);
+        const __m256i b     = _mm256_unpackhi_epi8(hc, lc);
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(hex + i * 2), _mm256_permute2x128_si256(a, b, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(hex + i * 2 + 32), _mm256_permute2x128_si256(a, b, 0x31));
+    }
+#   endif
+
+#   if defined(XMRIG_CVT_SSE2)
+    for (; i + 16 <= bin_len; i += 16) {
+        const __m128i x     = _mm_loadu_si128(reinterpret_cast<const __m128i *>(bin + i));
+        const __m128i mask  = _mm_set1_epi8(0x0f);
+        const __m128i hc    = hex_nibbles_to_chars(_mm_and_si128(_mm_srli_epi16(x, 4), mask));
+        const __m128i lc    = hex_nibbles_to_chars(_mm_and_si128(x, mask));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(hex + i * 2), _mm_unpacklo_epi8(hc, lc));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(hex + i * 2 + 16), _mm_unpackhi_epi8(hc, lc));
+    }
+#   elif defined(XMRIG_CVT_NEON)
+    const uint8x16_t table = vld1q_u8(reinterpret_cast<const uint8_t *>("0123456789abcdef"));
+
+    for (; i + 16 <= bin_len; i += 16) {
+        const uint8x16_t x = vld1q_u8(bin + i);
+        uint8x16x2_t out;
+        out.val[0] = vqtbl1q_u8(table, vshrq_n_u8(x, 4));
+        out.val[1] = vqtbl1q_u8(table, vandq_u8(x, vdupq_n_u8(0x0f)));
+
+        vst2q_u8(reinterpret_cast<uint8_t *>(hex + i * 2), out);
+    }
+#   endif
+
+    return i;
+}
+
+
+// Decodes whole 32/64 character blocks, stops at the first block with a non-hex character.
+// Returns the number of characters consumed.
+static inline size_t hex_decode_blocks(uint8_t *bin, const char *hex, size_t hex_len)
+{
+    size_t i = 0;
+
+#   if defined(XMRIG_CVT_AVX2)
+    for (; i + 64 <= hex_len; i += 64) {
+        __m256i valid   = _mm256_set1_epi8(-1);
+        const __m256i a = hex_chars_to_nibbles(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(hex + i)), valid);
+        const __m256i b = hex_chars_to_nibbles(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(hex + i + 32)), valid);
+
+        if (_mm256_movemask_epi8(valid) != -1) {
+            break;
+        }
+
+        // packus works per 128-bit lane, restore the byte order afterwards
+        const __m256i r = _mm256_packus_epi16(hex_pack_nibbles(a), hex_pack_nibbles(b));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(bin + i / 2), _mm256_permute4x64_epi64(r, 0xd8));
+    }
+#   endif
+
+#   if defined(XMRIG_CVT_SSE2)
+    for (; i + 32 <= hex_len; i += 32) {
+        __m128i valid   = _mm_set1_epi8(-1);
+        const __m128i a = hex_chars_to_nibbles(_mm_loadu_si128(reinterpret_cast<const __m128i *>(hex + i)), valid);
+        const __m128i b = hex_chars_to_nibbles(_mm_loadu_si128(reinterpret_cast<const __m128i *>(hex + i + 16)), valid);
+
+        if (_mm_movemask_epi8(valid) != 0xffff) {
+            break;
+        }
+
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(bin + i / 2), _mm_packus_epi16(hex_pack_nibbles(a), hex_pack_nibbles(b)));
+    }
+#   elif defined(XMRIG_CVT_NEON)
+    for (; i + 32 <= hex_len; i += 32) {
+        const uint8x16x2_t c = vld2q_u8(reinterpret_cast<const uint8_t *>(hex + i));
+        uint8x16_t n[2];
+        uint8x16_t valid = vdupq_n_u8(0xff);
+
+        for (size_t k = 0; k < 2; ++k) {
+            const uint8x16_t digit      = vsubq_u8(c.val[k], vdupq_n_u8('0'));
+            const uint8x16_t alpha      = vsubq_u8(vorrq_u8(c.val[k], vdupq_n_u8(0x20)), vdupq_n_u8('a'));
+            const uint8x16_t is_digit   = vcltq_u8(digit, vdupq_n_u8(10));
+            const uint8x16_t is_alpha   = vcltq_u8(alpha, vdupq_n_u8(6));
+
+            valid = vandq_u8(valid, vorrq_u8(is_digit, is_alpha));
+            n[k]  = vbslq_u8(is_digit, digit, vaddq_u8(alpha, vdupq_n_u8(10)));
+        }
+
+        if (vminvq_u8(valid) != 0xff) {
+            break;
+        }
+
+        vst1q_u8(bin + i / 2, vorrq_u8(vshlq_n_u8(n[0], 4), n[1]));
+    }
+#   endif
+
+    return i;
+}
+
+
 static char *cvt_bin2hex(char *const hex, const size_t hex_maxlen, const unsigned char *const bin, const size_t bin_len)
 {
     size_t       i = 0U;
@@ -44,6 +226,8 @@ static char *cvt_bin2hex(char *const hex, const size_t hex_maxlen, const unsigne
         return nullptr; /* LCOV_EXCL_LINE */
     }
 
+    i = hex_encode_blocks(hex, bin, bin_len);
+
     while (i < bin_len) {
         c = bin[i] & 0xf;
         b = bin[i] >> 4;
@@ -143,6 +327,19 @@ static int cvt_hex2bin(unsigned char *const bin, const size_t bin_maxlen, const
 #endif
 
 
+// Strict decoder: the whole input must be hex. The vectorized part handles full blocks,
+// the rest and any block with an invalid character go through the byte-at-a-time decoder.
+static bool hex2bin(uint8_t *bin, size_t bin_maxlen, const char *hex, size_t hex_len)
+{
+    const size_t pos = hex_len / 2 <= bin_maxlen ? hex_decode_blocks(bin, hex, hex_len) : 0;
+    if (pos == hex_len) {
+        return true;
+    }
+
+    return sodium_hex2bin(bin + pos / 2, bin_maxlen - pos / 2, hex + pos, hex_len - pos, nullptr, nullptr, nullptr) == 0;
+}
+
+
 template<typename T>
 inline bool fromHexImpl(T &buf, const char *in, size_t size)
 {
@@ -153,7 +350,7 @@ inline bool fromHexImpl(T &buf, const char *in, size_t size)
 
     buf.resize(size / 2);
 
-    return sodium_hex2bin(reinterpret_cast<uint8_t *>(&buf.front()), buf.size(), in, size, nullptr, nullptr, nullptr) == 0;
+    return hex2bin(reinterpret_cast<uint8_t *>(&buf.front()), buf.size(), in, size);
 }
 
 
@@ -189,7 +386,7 @@ bool xmrig::Cvt::fromHex(uint8_t *bin, size_t bin_maxlen, const char *hex, size_
         return false;
     }
 
-    return sodium_hex2bin(bin, bin_maxlen, hex, hex_len, nullptr, nullptr, nullptr) == 0;
+    return hex2bin(bin, bin_maxlen, hex, hex_len);
 }
 
 
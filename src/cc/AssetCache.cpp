@@ -0,0 +1,136 @@
+/* XMRigCC
+ * Copyright 2017-     BenDr0id    <https://github.com/BenDr0id>, <ben@graef.in>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <fstream>
+#include <sstream>
+#include <sys/stat.h>
+
+#ifdef CPPHTTPLIB_ZLIB_SUPPORT
+#include <zlib.h>
+#endif
+
+#include "AssetCache.h"
+#include "ConfigStore.h"
+#include "Service.h"
+
+std::shared_ptr<const AssetCache::Asset> AssetCache::get(const std::string& fileName, const std::string& contentType)
+{
+  struct stat st{};
+  if (fileName.empty() || ::stat(fileName.c_str(), &st) != 0)
+  {
+    return nullptr;
+  }
+
+#   ifdef __linux__
+  const int64_t mtime = static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000LL + st.st_mtim.tv_nsec;
+#   else
+  const int64_t mtime = static_cast<int64_t>(st.st_mtime);
+#   endif
+  const auto size = static_cast<uint64_t>(st.st_size);
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  auto it = m_assets.find(fileName);
+  if (it != m_assets.end() && it->second->mtime == mtime && it->second->size == size)
+  {
+    return it->second;
+  }
+
+  std::ifstream file(fileName, std::ios::binary);
+  if (!file)
+  {
+    return nullptr;
+  }
+
+  std::stringstream data;
+  data << file.rdbuf();
+
+  auto asset = std::make_shared<Asset>();
+  asset->contentType = contentType;
+  asset->data = data.str();
+  asset->etag = ConfigStore::etag(asset->data);
+  asset->mtime = mtime;
+  asset->size = size;
+
+  if (!compress(asset->data, asset->gzip) || asset->gzip.size() >= asset->data.size())
+  {
+    asset->gzip.clear();
+  }
+
+  m_assets[fileName] = asset;
+
+  return asset;
+}
+
+int AssetCache::serve(const Asset& asset, const httplib::Request& req, httplib::Response& res)
+{
+  const auto& acceptEncoding = req.get_header_value("Accept-Encoding");
+  const bool gzip = !asset.gzip.empty() && acceptEncoding.find("gzip") != std::string::npos;
+
+  // the gzip variant is another representation and gets its own strong validator
+  const std::string etag = gzip ? asset.etag.substr(0, asset.etag.size() - 1) + "-gz\"" : asset.etag;
+
+  res.set_header("ETag", etag);
+  res.set_header("Cache-Control", "no-cache");
+  res.set_header("Vary", "Accept-Encoding");
+
+  if (req.get_header_value("If-None-Match") == etag)
+  {
+    return HTTP_NOT_MODIFIED;
+  }
+
+  if (gzip)
+  {
+    res.set_header("Content-Encoding", "gzip");
+    res.set_content(asset.gzip, asset.contentType.c_str());
+  }
+  else
+  {
+    res.set_content(asset.data, asset.contentType.c_str());
+  }
+
+  return HTTP_OK;
+}
+
+bool AssetCache::compress(const std::string& data, std::string& out)
+{
+#   ifdef CPPHTTPLIB_ZLIB_SUPPORT
+  z_stream stream{};
+  if (deflateInit2(&stream, Z_BEST_COMPRESSION, Z_DEFLATED, 15 + 16, 9, Z_DEFAULT_STRATEGY) != Z_OK)
+  {
+    return false;
+  }
+
+  out.resize(deflateBound(&stream, static_cast<uLong>(data.size())));
+
+  stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+  stream.avail_in = static_cast<uInt>(data.size());
+  stream.next_out = reinterpret_cast<Bytef*>(&out[0]);
+  stream.avail_out = static_cast<uInt>(out.size());
+
+  const int result = deflate(&stream, Z_FINISH);
+  out.resize(stream.total_out);
+  deflateEnd(&stream);
+
+  return result == Z_STREAM_END;
+#   else
+  (void) data;
+  (void) out;
+
+  return false;
+#   endif
+}
@@ -0,0 +1,61 @@
+/* XMRigCC
+ * Copyright 2017-     BenDr0id    <https://github.com/BenDr0id>, <ben@graef.in>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __ASSET_CACHE_H__
+#define __ASSET_CACHE_H__
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "3rdparty/cpp-httplib/httplib.h"
+
+/**
+ * Static assets of the CC Dashboard.
+ *
+ * A file is read once and kept in memory together with a gzip variant compressed at the highest level (when built
+ * with WITH_ZLIB). Responses carry a content hash ETag so reloads of the dashboard are answered with 304 Not Modified.
+ * The cached copy is revalidated by size and mtime of the file on every request.
+ */
+class AssetCache
+{
+public:
+  struct Asset
+  {
+    std::string contentType;
+    std::string data;
+    std::string gzip;
+    std::string etag;
+    int64_t mtime = 0;
+    uint64_t size = 0;
+  };
+
+  std::shared_ptr<const Asset> get(const std::string& fileName, const std::string& contentType);
+
+  static int serve(const Asset& asset, const httplib::Request& req, httplib::Response& res);
+
+private:
+  static bool compress(const std::string& data, std::string& out);
+
+private:
+  std::map<std::string, std::shared_ptr<const Asset>> m_assets;
+  std::mutex m_mutex;
+};
+
+#endif /* __ASSET_CACHE_H__ */
@@ -0,0 +1,526 @@
+/* XMRigCC
+ * Copyright 2017-     BenDr0id    <https://github.com/BenDr0id>, <ben@graef.in>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#ifndef _WIN32
+#   include <unistd.h>
+#endif
+
+#include "base/io/log/Log.h"
+#include "base/io/log/backends/ConsoleLog.h"
+#include "version.h"
+
+#include "CCBench.h"
+#include "ControlCommand.h"
+
+namespace
+{
+constexpr static int HTTP_OK = 200;
+
+constexpr static char BENCH_CLIENT_PREFIX[] = "bench-rig-";
+
+constexpr static char BENCH_CONFIG[] = R"({"cpu":{"enabled":true,"huge-pages":true,"max-threads-hint":100},)"
+                                       R"("pools":[{"algo":"rx/0","url":"pool.example.com:3333",)"
+                                       R"("user":"benchmark","pass":"x","keepalive":true}],)"
+                                       R"("cc-client":{"enabled":true,"update-interval-s":10}})";
+
+uint64_t steadyMSecs()
+{
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+uint32_t percentile(const std::vector<uint32_t>& sorted, double pct)
+{
+  if (sorted.empty())
+  {
+    return 0;
+  }
+
+  auto idx = static_cast<size_t>(pct / 100.0 * static_cast<double>(sorted.size() - 1) + 0.5);
+  return sorted[std::min(idx, sorted.size() - 1)];
+}
+}
+
+CCBench::CCBench(cxxopts::ParseResult& parseResult)
+{
+  m_host = parseResult["host"].as<std::string>();
+  m_port = parseResult["port"].as<int>();
+  m_useTLS = parseResult["tls"].as<bool>();
+  m_algo = parseResult["algo"].as<std::string>();
+  m_publishConfig = parseResult["publish-config"].as<bool>();
+
+  if (parseResult.count("token"))
+  {
+    m_token = parseResult["token"].as<std::string>();
+  }
+
+  if (parseResult.count("server-pid"))
+  {
+    m_serverPid = parseResult["server-pid"].as<int>();
+  }
+
+  m_clients = static_cast<size_t>(std::max(1, parseResult["clients"].as<int>()));
+  m_threads = static_cast<size_t>(std::max(1, parseResult["threads"].as<int>()));
+  m_logLines = static_cast<size_t>(std::max(0, parseResult["log-lines"].as<int>()));
+  m_gpus = static_cast<size_t>(std::max(0, parseResult["gpus"].as<int>()));
+
+  m_duration = static_cast<uint64_t>(std::max(1, parseResult["duration"].as<int>())) * 1000;
+  m_statusInterval = static_cast<uint64_t>(std::max(1, parseResult["status-interval"].as<int>())) * 1000;
+  m_configInterval = static_cast<uint64_t>(std::max(0, parseResult["config-interval"].as<int>())) * 1000;
+
+  m_threads = std::min(m_threads, m_clients);
+
+  xmrig::Log::init();
+  xmrig::Log::add(new xmrig::ConsoleLog());
+}
+
+int CCBench::start()
+{
+  xmrig::Log::print(GREEN_BOLD(" * ") WHITE_BOLD("%-13s") CYAN_BOLD("%s/%s"), "ABOUT", APP_NAME "Bench", APP_VERSION);
+  xmrig::Log::print(GREEN_BOLD(" * ") WHITE_BOLD("%-13s") CSI "1;%dm%s:%d", "TARGET", (m_useTLS ? 32 : 36),
+                    m_host.c_str(), m_port);
+  xmrig::Log::print(GREEN_BOLD(" * ") WHITE_BOLD("%-13s") CYAN_BOLD("%zu") WHITE_BOLD(" clients, ")
+                    CYAN_BOLD("%zu") WHITE_BOLD(" threads, status every ") CYAN_BOLD("%" PRIu64 "s")
+                    WHITE_BOLD(", config every ") CYAN_BOLD("%" PRIu64 "s"),
+                    "LOAD", m_clients, m_threads, m_statusInterval / 1000, m_configInterval / 1000);
+
+  m_virtualClients.resize(m_clients);
+  for (size_t i = 0; i < m_clients; ++i)
+  {
+    initClient(m_virtualClients[i], i);
+  }
+
+  ProcessUsage serverBefore;
+  ProcessUsage serverAfter;
+  if (m_serverPid > 0 && !readProcessUsage(m_serverPid, serverBefore))
+  {
+    LOG_WARN("Unable to read resource usage of server pid %d", m_serverPid);
+    m_serverPid = 0;
+  }
+
+  const uint64_t startTime = steadyMSecs();
+
+  // stagger the first status report over one interval like a fleet which has been running for a while
+  for (size_t i = 0; i < m_clients; ++i)
+  {
+    m_virtualClients[i].nextStatus = startTime + (i * m_statusInterval) / m_clients;
+    m_virtualClients[i].nextConfig = m_configInterval > 0 ? m_virtualClients[i].nextStatus + m_configInterval : 0;
+  }
+
+  m_running = true;
+
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < m_threads; ++i)
+  {
+    size_t first = (i * m_clients) / m_threads;
+    size_t last = ((i + 1) * m_clients) / m_threads;
+
+    threads.emplace_back(&CCBench::workerThread, this, first, last);
+  }
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(m_duration));
+  m_running = false;
+
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+
+  const uint64_t elapsed = steadyMSecs() - startTime;
+
+  if (m_serverPid > 0)
+  {
+    readProcessUsage(m_serverPid, serverAfter);
+  }
+
+  printReport(elapsed, serverBefore, serverAfter);
+
+  uint64_t errors = 0;
+  for (auto error : m_stats.errors)
+  {
+    errors += error;
+  }
+
+  return errors > 0 ? 1 : 0;
+}
+
+void CCBench::initClient(VirtualClient& client, size_t index) const
+{
+  char clientId[64];
+  snprintf(clientId, sizeof(clientId), "%s%05zu", BENCH_CLIENT_PREFIX, index);
+
+  auto& status = client.status;
+  status.setClientId(clientId);
+  status.setCurrentStatus(ClientStatus::RUNNING);
+  status.setVersion(std::to_string(APP_VER_MAJOR) + "." + std::to_string(APP_VER_MINOR) + "." +
+                    std::to_string(APP_VER_PATCH));
+  status.setCurrentPool("pool.example.com:3333");
+  status.setCurrentPoolUser("benchmark");
+  status.setCurrentPoolPass("x");
+  status.setCurrentPoolRigId(clientId);
+  status.setCurrentAlgoName(m_algo);
+  status.setCpuBrand("AMD Ryzen 9 5950X 16-Core Processor");
+  status.setAssembly("ryzen");
+  status.setCpuAES(true);
+  status.setCpuX64(true);
+  status.setHugepages(true);
+  status.setHugepagesEnabled(true);
+  status.setCpuSockets(1);
+  status.setCpuCores(16);
+  status.setCpuThreads(32);
+  status.setCurrentThreads(16);
+  status.setCurrentWays(1);
+  status.setCpuL2(8192);
+  status.setCpuL3(65536);
+  status.setNodes(1);
+  status.setMaxCpuUsage(100);
+  status.setHashFactor(1);
+  status.setTotalPages(1168);
+  status.setTotalHugepages(1168);
+  status.setTotalMemory(34359738368ULL);
+  status.setFreeMemory(17179869184ULL);
+
+  for (size_t i = 0; i < m_gpus; ++i)
+  {
+    GPUInfo gpuInfo;
+    gpuInfo.setDeviceIdx(static_cast<uint32_t>(i));
+    gpuInfo.setName("GeForce RTX 3070");
+    gpuInfo.setType("CUDA");
+    gpuInfo.setBusId("0000:0" + std::to_string(i + 1) + ":00.0");
+    gpuInfo.setIntensity(2944);
+    gpuInfo.setThreads(32);
+    gpuInfo.setBlocks(92);
+    gpuInfo.setBfactor(0);
+    gpuInfo.setBsleep(0);
+    gpuInfo.setComputeUnits(46);
+    gpuInfo.setClock(1725);
+    gpuInfo.setMemory(8589934592ULL);
+    gpuInfo.setFreeMem(6442450944ULL);
+
+    status.addGPUInfo(gpuInfo);
+  }
+}
+
+void CCBench::workerThread(size_t first, size_t last)
+{
+  while (m_running)
+  {
+    uint64_t now = steadyMSecs();
+    uint64_t nextDue = now + 1000;
+
+    for (size_t i = first; i < last && m_running; ++i)
+    {
+      auto& client = m_virtualClients[i];
+
+      if (client.nextStatus <= now || (client.nextConfig > 0 && client.nextConfig <= now))
+      {
+        updateClient(client, now);
+        now = steadyMSecs();
+      }
+
+      nextDue = std::min(nextDue, client.nextStatus);
+      if (client.nextConfig > 0)
+      {
+        nextDue = std::min(nextDue, client.nextConfig);
+      }
+    }
+
+    if (nextDue > now)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(std::min<uint64_t>(nextDue - now, 100)));
+    }
+  }
+}
+
+void CCBench::updateClient(VirtualClient& client, uint64_t now)
+{
+  Stats stats;
+
+  auto cli = getClient();
+  const auto& clientId = client.status.getClientId();
+
+  if (m_publishConfig && !client.configPublished)
+  {
+    client.configPublished = true;
+    performRequest(*cli, SET_CONFIG, "/client/setClientConfig?clientId=" + clientId, "POST", BENCH_CONFIG, stats);
+  }
+
+  if (client.nextStatus <= now)
+  {
+    const double jitter = static_cast<double>(client.logSequence % 17) * 10.0;
+
+    client.status.setHashrateShort(11800.0 + jitter);
+    client.status.setHashrateMedium(11750.0 + jitter);
+    client.status.setHashrateLong(11700.0 + jitter);
+    client.status.setHashrateHighest(12100.0);
+    client.status.setSharesGood(client.status.getSharesGood() + 3);
+    client.status.setSharesTotal(client.status.getSharesTotal() + 3);
+    client.status.setHashesTotal(client.status.getHashesTotal() + 11750 * (m_statusInterval / 1000));
+    client.status.setAvgTime(35);
+    client.status.setUptime(client.status.getUptime() + m_statusInterval);
+    client.status.setLog(logChunk(client));
+
+    performRequest(*cli, SET_STATUS, "/client/setClientStatus?clientId=" + clientId, "POST",
+                   client.status.toJsonString(), stats);
+
+    client.status.clearLog();
+    client.nextStatus += m_statusInterval;
+  }
+
+  if (client.nextConfig > 0 && client.nextConfig <= now)
+  {
+    performRequest(*cli, GET_CONFIG, "/client/getConfig?clientId=" + clientId, "GET", "", stats);
+    client.nextConfig += m_configInterval;
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  for (int type = 0; type < REQUEST_TYPE_MAX; ++type)
+  {
+    m_stats.latencies[type].insert(m_stats.latencies[type].end(), stats.latencies[type].begin(),
+                                   stats.latencies[type].end());
+    m_stats.errors[type] += stats.errors[type];
+  }
+
+  m_stats.bytesSent += stats.bytesSent;
+  m_stats.bytesReceived += stats.bytesReceived;
+}
+
+bool CCBench::performRequest(httplib::ClientImpl& cli, RequestType type, const std::string& path,
+                             const std::string& method, const std::string& body, Stats& stats)
+{
+  httplib::Request req;
+  req.method = method;
+  req.path = path;
+  req.set_header("Host", m_host + ":" + std::to_string(m_port));
+  req.set_header("User-Agent", APP_NAME "Bench/" APP_VERSION);
+  req.set_header("Accept", "application/json");
+  req.set_header("Content-Type", "application/json");
+  req.body = body;
+
+  httplib::Response res;
+  auto err = httplib::Error::Success;
+
+  const auto begin = std::chrono::steady_clock::now();
+  const bool sent = cli.send(req, res, err);
+  const auto end = std::chrono::steady_clock::now();
+
+  stats.bytesSent += body.size();
+
+  if (!sent || res.status != HTTP_OK)
+  {
+    stats.errors[type]++;
+    return false;
+  }
+
+  stats.bytesReceived += res.body.size();
+  stats.latencies[type].push_back(
+    static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count()));
+
+  if (type == SET_STATUS)
+  {
+    ControlCommand controlCommand;
+    if (!controlCommand.parseFromJsonString(res.body))
+    {
+      stats.errors[type]++;
+      return false;
+    }
+  }
+
+  return true;
+}
+
+std::shared_ptr<httplib::ClientImpl> CCBench::getClient() const
+{
+  std::shared_ptr<httplib::ClientImpl> cli;
+
+#ifdef XMRIG_FEATURE_TLS
+  if (m_useTLS)
+  {
+    cli = std::make_shared<httplib::SSLClient>(m_host, m_port);
+    cli->enable_server_certificate_verification(false);
+  }
+  else
+  {
+#endif
+    cli = std::make_shared<httplib::ClientImpl>(m_host, m_port);
+#ifdef XMRIG_FEATURE_TLS
+  }
+#endif
+
+  if (!m_token.empty())
+  {
+    cli->set_bearer_token_auth(m_token.c_str());
+  }
+
+  return cli;
+}
+
+std::string CCBench::logChunk(VirtualClient& client) const
+{
+  std::stringstream log;
+
+  for (size_t i = 0; i < m_logLines; ++i)
+  {
+    const uint32_t seq = client.logSequence++;
+
+    if (seq % 5 == 0)
+    {
+      log << "[2024-01-01 00:00:00.000]  net      new job from pool.example.com:3333 diff 240007 algo "
+          << m_algo << " height 3069" << seq << '\n';
+    }
+    else
+    {
+      log << "[2024-01-01 00:00:00.000]  cpu      accepted (" << seq << "/0) diff 240007 (35 ms)\n";
+    }
+  }
+
+  return log.str();
+}
+
+bool CCBench::readProcessUsage(int pid, ProcessUsage& usage) const
+{
+#ifdef __linux__
+  std::ifstream stat("/proc/" + std::to_string(pid) + "/stat");
+  if (!stat)
+  {
+    return false;
+  }
+
+  std::string content((std::istreambuf_iterator<char>(stat)), std::istreambuf_iterator<char>());
+
+  // skip "pid (comm)" as comm may contain spaces, utime/stime are field 14/15
+  const auto pos = content.rfind(')');
+  if (pos == std::string::npos)
+  {
+    return false;
+  }
+
+  std::istringstream fields(content.substr(pos + 2));
+  std::string field;
+  uint64_t utime = 0;
+  uint64_t stime = 0;
+
+  for (int i = 3; i <= 15 && fields >> field; ++i)
+  {
+    if (i == 14)
+    {
+      utime = std::stoull(field);
+    }
+    else if (i == 15)
+    {
+      stime = std::stoull(field);
+    }
+  }
+
+  usage.cpuTime = static_cast<double>(utime + stime) / static_cast<double>(sysconf(_SC_CLK_TCK));
+
+  std::ifstream status("/proc/" + std::to_string(pid) + "/status");
+  std::string line;
+  while (std::getline(status, line))
+  {
+    if (line.rfind("VmRSS:", 0) == 0)
+    {
+      usage.rss = std::stoull(line.substr(6)) * 1024;
+    }
+    else if (line.rfind("VmHWM:", 0) == 0)
+    {
+      usage.peakRss = std::stoull(line.substr(6)) * 1024;
+    }
+  }
+
+  return true;
+#else
+  return false;
+#endif
+}
+
+void CCBench::printReport(uint64_t elapsed, const ProcessUsage& before, const ProcessUsage& after) const
+{
+  const double seconds = static_cast<double>(elapsed) / 1000.0;
+
+  uint64_t totalRequests = 0;
+  uint64_t totalErrors = 0;
+
+  xmrig::Log::print(WHITE_BOLD("%-13s %10s %8s %10s %9s %9s %9s %9s"), "REQUEST", "count", "errors", "req/s",
+                    "p50 ms", "p90 ms", "p99 ms", "max ms");
+
+  for (int type = 0; type < REQUEST_TYPE_MAX; ++type)
+  {
+    auto latencies = m_stats.latencies[type];
+    std::sort(latencies.begin(), latencies.end());
+
+    const uint64_t count = latencies.size();
+    totalRequests += count;
+    totalErrors += m_stats.errors[type];
+
+    if (count == 0 && m_stats.errors[type] == 0)
+    {
+      continue;
+    }
+
+    xmrig::Log::print(CYAN_BOLD("%-13s") " %10" PRIu64 " %s%8" PRIu64 CLEAR " %10.1f %9.2f %9.2f %9.2f %9.2f",
+                      toString(static_cast<RequestType>(type)), count,
+                      m_stats.errors[type] > 0 ? RED_BOLD_S : "", m_stats.errors[type],
+                      static_cast<double>(count) / seconds,
+                      percentile(latencies, 50.0) / 1000.0,
+                      percentile(latencies, 90.0) / 1000.0,
+                      percentile(latencies, 99.0) / 1000.0,
+                      (latencies.empty() ? 0 : latencies.back()) / 1000.0);
+  }
+
+  xmrig::Log::print(GREEN_BOLD(" * ") WHITE_BOLD("%-13s") CYAN_BOLD("%.1f req/s") WHITE_BOLD(" (%" PRIu64
+                    " requests, %" PRIu64 " errors in %.1fs)"), "THROUGHPUT",
+                    static_cast<double>(totalRequests) / seconds, totalRequests, totalErrors, seconds);
+
+  xmrig::Log::print(GREEN_BOLD(" * ") WHITE_BOLD("%-13s") CYAN_BOLD("%.2f MB/s") WHITE_BOLD(" ingest, ")
+                    CYAN_BOLD("%.2f MB/s") WHITE_BOLD(" egress"), "TRAFFIC",
+                    static_cast<double>(m_stats.bytesSent) / seconds / 1048576.0,
+                    static_cast<double>(m_stats.bytesReceived) / seconds / 1048576.0);
+
+  if (m_serverPid > 0)
+  {
+    const double cpuTime = after.cpuTime - before.cpuTime;
+
+    xmrig::Log::print(GREEN_BOLD(" * ") WHITE_BOLD("%-13s") CYAN_BOLD("%.1f%%") WHITE_BOLD(" of one core, ")
+                      CYAN_BOLD("%.3f ms") WHITE_BOLD(" cpu/request"), "SERVER CPU",
+                      cpuTime / seconds * 100.0, totalRequests > 0 ? cpuTime * 1000.0 / totalRequests : 0.0);
+
+    xmrig::Log::print(GREEN_BOLD(" * ") WHITE_BOLD("%-13s") CYAN_BOLD("%.1f MB") WHITE_BOLD(" rss, ")
+                      CYAN_BOLD("%.1f MB") WHITE_BOLD(" peak, ") CYAN_BOLD("%+.1f MB") WHITE_BOLD(" during run"),
+                      "SERVER MEMORY", after.rss / 1048576.0, after.peakRss / 1048576.0,
+                      (static_cast<double>(after.rss) - static_cast<double>(before.rss)) / 1048576.0);
+  }
+}
+
+const char* CCBench::toString(RequestType type)
+{
+  static const char* names[REQUEST_TYPE_MAX] = {
+    "setStatus",
+    "getConfig",
+    "setConfig"
+  };
+
+  return names[static_cast<int>(type)];
+}
@@ -0,0 +1,123 @@
+/* XMRigCC
+ * Copyright 2017-     BenDr0id    <https://github.com/BenDr0id>, <ben@graef.in>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __CC_BENCH_H__
+#define __CC_BENCH_H__
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <cxxopts/cxxopts.hpp>
+
+#include "3rdparty/cpp-httplib/httplib.h"
+
+#include "ClientStatus.h"
+
+/**
+ * Load generator for the CC Server.
+ *
+ * Simulates a fleet of virtual CC Clients which behave like CCClient::publishThread(): they post their
+ * ClientStatus (including a log chunk) and poll the returned control command in one request, fetch their
+ * config and optionally publish it. Latency, throughput and server resource usage are reported at the end.
+ */
+class CCBench
+{
+public:
+  enum RequestType
+  {
+    SET_STATUS,
+    GET_CONFIG,
+    SET_CONFIG,
+    REQUEST_TYPE_MAX
+  };
+
+  explicit CCBench(cxxopts::ParseResult& parseResult);
+
+public:
+  int start();
+
+private:
+  struct VirtualClient
+  {
+    ClientStatus status;
+    uint64_t nextStatus = 0;
+    uint64_t nextConfig = 0;
+    uint32_t logSequence = 0;
+    bool configPublished = false;
+  };
+
+  struct Stats
+  {
+    std::vector<uint32_t> latencies[REQUEST_TYPE_MAX];
+    uint64_t errors[REQUEST_TYPE_MAX] = {};
+    uint64_t bytesSent = 0;
+    uint64_t bytesReceived = 0;
+  };
+
+  struct ProcessUsage
+  {
+    double cpuTime = 0.0;
+    uint64_t rss = 0;
+    uint64_t peakRss = 0;
+  };
+
+  void initClient(VirtualClient& client, size_t index) const;
+  void workerThread(size_t first, size_t last);
+  void updateClient(VirtualClient& client, uint64_t now);
+
+  bool performRequest(httplib::ClientImpl& cli, RequestType type, const std::string& path,
+                      const std::string& method, const std::string& body, Stats& stats);
+
+  std::shared_ptr<httplib::ClientImpl> getClient() const;
+  std::string logChunk(VirtualClient& client) const;
+
+  bool readProcessUsage(int pid, ProcessUsage& usage) const;
+  void printReport(uint64_t elapsed, const ProcessUsage& before, const ProcessUsage& after) const;
+
+  static const char* toString(RequestType type);
+
+private:
+  std::string m_host;
+  std::string m_token;
+  std::string m_algo;
+
+  int m_port = 3344;
+  int m_serverPid = 0;
+
+  bool m_useTLS = false;
+  bool m_publishConfig = false;
+
+  size_t m_clients = 100;
+  size_t m_threads = 4;
+  size_t m_logLines = 20;
+  size_t m_gpus = 0;
+
+  uint64_t m_duration = 60000;
+  uint64_t m_statusInterval = 10000;
+  uint64_t m_configInterval = 0;
+
+  std::vector<VirtualClient> m_virtualClients;
+
+  std::atomic<bool> m_running{false};
+
+  std::mutex m_mutex;
+  Stats m_stats;
+};
+
+#endif /* __CC_BENCH_H__ */
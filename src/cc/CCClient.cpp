@@ -15,6 +15,7 @@
  *   along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <fstream>
 #include <sstream>
 #include "3rdparty/rapidjson/prettywriter.h"
 #include <crypto/common/VirtualMemory.h>
@@ -48,6 +49,7 @@
 namespace
 {
   constexpr static int HTTP_OK = 200;
+  constexpr static int HTTP_NOT_MODIFIED = 304;
 
   static std::string VersionString()
   {
@@ -55,6 +57,20 @@ namespace
                           std::string(".") + std::to_string(APP_VER_PATCH);
     return version;
   }
+
+  static size_t fileHash(const std::string& fileName)
+  {
+    std::ifstream file(fileName);
+    if (!file)
+    {
+      return 0;
+    }
+
+    std::stringstream data;
+    data << file.rdbuf();
+
+    return std::hash<std::string>()(data.str());
+  }
 }
 
 xmrig::CCClient::CCClient(Base* base)
@@ -62,6 +78,7 @@ xmrig::CCClient::CCClient(Base* base)
     m_startTime(Chrono::currentMSecsSinceEpoch()),
     m_configPublishedOnStart(false),
     m_failedRequests(0),
+    m_configHash(0),
     m_timer(nullptr)
 {
   base->addListener(this);
@@ -254,12 +271,24 @@ void xmrig::CCClient::fetchConfig()
   std::string requestUrl = "/client/getConfig?clientId=" + m_clientStatus.getClientId();
   std::string requestBuffer;
 
-  auto res = performRequest(requestUrl, requestBuffer, "GET");
+  // a 304 only means the server side is unchanged, so the ETag is only sent while the local file is still the one
+  // written for it, otherwise an edited or corrupted local config could never be restored
+  httplib::Headers headers;
+  if (!m_configETag.empty() && fileHash(m_base->config()->fileName().data()) == m_configHash)
+  {
+    headers.emplace("If-None-Match", m_configETag);
+  }
+
+  auto res = performRequest(requestUrl, requestBuffer, "GET", headers);
   if (!res)
   {
     LOG_ERR(CLEAR "%s" RED("error:unable to performRequest GET [http%s://%s:%d%s]"), Tags::cc(),
             config.useTLS() ? "s" : "", config.host(), config.port(), requestUrl.c_str());
   }
+  else if (res->status == HTTP_NOT_MODIFIED)
+  {
+    LOG_INFO(CLEAR "%s" WHITE_BOLD("Config unchanged."), Tags::cc());
+  }
   else if (res->status != HTTP_OK)
   {
     LOG_ERR(CLEAR "%s" RED("error:\"%d\" [http%s://%s:%d%s]"), Tags::cc(), res->status,
@@ -283,6 +312,9 @@ void xmrig::CCClient::fetchConfig()
         clientConfigFile << buffer.GetString();
         clientConfigFile.close();
 
+        m_configETag = res->get_header_value("ETag");
+        m_configHash = std::hash<std::string>()(std::string(buffer.GetString(), buffer.GetSize()));
+
         if (!m_base->config()->isWatch())
         {
           static_cast<IWatcherListener*>(m_base)->onFileChanged(m_base->config()->fileName());
@@ -460,7 +492,8 @@ std::shared_ptr<httplib::ClientImpl> xmrig::CCClient::getClient()
 
 std::shared_ptr<httplib::Response> xmrig::CCClient::performRequest(const std::string& requestUrl,
                                                                    const std::string& requestBuffer,
-                                                                   const std::string& operation)
+                                                                   const std::string& operation,
+                                                                   const httplib::Headers& headers)
 {
   std::shared_ptr<httplib::Response> res;
 
@@ -485,6 +518,11 @@ std::shared_ptr<httplib::Response> xmrig::CCClient::performRequest(const std::st
     req.set_header("Accept", "application/json");
     req.set_header("Content-Type", "application/json");
 
+    for (const auto& header : headers)
+    {
+      req.set_header(header.first.c_str(), header.second);
+    }
+
     if (!requestBuffer.empty())
     {
       req.body = requestBuffer;
@@ -77,7 +77,8 @@ private:
 
   std::shared_ptr<httplib::Response> performRequest(const std::string& requestUrl,
                                                     const std::string& requestBuffer,
-                                                    const std::string& operation);
+                                                    const std::string& operation,
+                                                    const httplib::Headers& headers = {});
 
   std::shared_ptr<httplib::ClientImpl> getClient();
 
@@ -88,7 +89,9 @@ private:
   ClientStatus m_clientStatus;
 
   bool m_configPublishedOnStart;
+  std::string m_configETag;
   int m_failedRequests;
+  size_t m_configHash;
 
   Timer* m_timer;
   std::thread m_thread;
@@ -255,6 +255,36 @@ double ClientStatus::getHashrateHighest() const
   return m_hashrateHighest;
 }
 
+double ClientStatus::getCpuPower() const
+{
+  return m_cpuPower;
+}
+
+void ClientStatus::setCpuPower(double cpuPower)
+{
+  m_cpuPower = cpuPower;
+}
+
+double ClientStatus::getHashesPerJoule() const
+{
+  return m_hashesPerJoule;
+}
+
+void ClientStatus::setHashesPerJoule(double hashesPerJoule)
+{
+  m_hashesPerJoule = hashesPerJoule;
+}
+
+double ClientStatus::getCpuTemperature() const
+{
+  return m_cpuTemperature;
+}
+
+void ClientStatus::setCpuTemperature(double cpuTemperature)
+{
+  m_cpuTemperature = cpuTemperature;
+}
+
 int ClientStatus::getHashFactor() const
 {
   return m_hashFactor;
@@ -375,6 +405,56 @@ void ClientStatus::setFreeMemory(uint64_t freeMemory)
   m_freeMemory = freeMemory;
 }
 
+int ClientStatus::getCgroupVersion() const
+{
+  return m_cgroupVersion;
+}
+
+void ClientStatus::setCgroupVersion(int cgroupVersion)
+{
+  m_cgroupVersion = cgroupVersion;
+}
+
+double ClientStatus::getCgroupCpus() const
+{
+  return m_cgroupCpus;
+}
+
+void ClientStatus::setCgroupCpus(double cgroupCpus)
+{
+  m_cgroupCpus = cgroupCpus;
+}
+
+std::string ClientStatus::getCgroupCpuset() const
+{
+  return m_cgroupCpuset;
+}
+
+void ClientStatus::setCgroupCpuset(const std::string& cgroupCpuset)
+{
+  m_cgroupCpuset = cgroupCpuset;
+}
+
+uint64_t ClientStatus::getCgroupMemory() const
+{
+  return m_cgroupMemory;
+}
+
+void ClientStatus::setCgroupMemory(uint64_t cgroupMemory)
+{
+  m_cgroupMemory = cgroupMemory;
+}
+
+int64_t ClientStatus::getCgroupHugepages() const
+{
+  return m_cgroupHugepages;
+}
+
+void ClientStatus::setCgroupHugepages(int64_t cgroupHugepages)
+{
+  m_cgroupHugepages = cgroupHugepages;
+}
+
 int ClientStatus::getNodes()
 {
   return m_nodes;
@@ -566,6 +646,21 @@ bool ClientStatus::parseFromJson(const rapidjson::Document& document)
       m_hashrateHighest = clientStatus["hashrate_highest"].GetDouble();
     }
 
+    if (clientStatus.HasMember("cpu_power") && clientStatus["cpu_power"].IsNumber())
+    {
+      m_cpuPower = clientStatus["cpu_power"].GetDouble();
+    }
+
+    if (clientStatus.HasMember("hashes_per_joule") && clientStatus["hashes_per_joule"].IsNumber())
+    {
+      m_hashesPerJoule = clientStatus["hashes_per_joule"].GetDouble();
+    }
+
+    if (clientStatus.HasMember("cpu_temperature") && clientStatus["cpu_temperature"].IsNumber())
+    {
+      m_cpuTemperature = clientStatus["cpu_temperature"].GetDouble();
+    }
+
     if (clientStatus.HasMember("hash_factor"))
     {
       m_hashFactor = clientStatus["hash_factor"].GetInt();
@@ -640,6 +735,21 @@ bool ClientStatus::parseFromJson(const rapidjson::Document& document)
       }
     }
 
+    if (clientStatus.HasMember("thermal_info_list") && clientStatus["thermal_info_list"].IsArray())
+    {
+      m_thermalInfoList.clear();
+
+      auto thermalInfoList = clientStatus["thermal_info_list"].GetArray();
+      for (rapidjson::Value::ConstValueIterator itr = thermalInfoList.Begin(); itr != thermalInfoList.End(); ++itr)
+      {
+        ThermalInfo thermalInfo;
+        if (itr->IsObject() && thermalInfo.parseFromJson(*itr))
+        {
+          m_thermalInfoList.push_back(thermalInfo);
+        }
+      }
+    }
+
     if (clientStatus.HasMember("shares_good"))
     {
       m_sharesGood = clientStatus["shares_good"].GetUint64();
@@ -665,6 +775,31 @@ bool ClientStatus::parseFromJson(const rapidjson::Document& document)
       m_freeMemory = clientStatus["free_memory"].GetUint64();
     }
 
+    if (clientStatus.HasMember("cgroup_version") && clientStatus["cgroup_version"].IsInt())
+    {
+      m_cgroupVersion = clientStatus["cgroup_version"].GetInt();
+    }
+
+    if (clientStatus.HasMember("cgroup_cpus") && clientStatus["cgroup_cpus"].IsNumber())
+    {
+      m_cgroupCpus = clientStatus["cgroup_cpus"].GetDouble();
+    }
+
+    if (clientStatus.HasMember("cgroup_cpuset") && clientStatus["cgroup_cpuset"].IsString())
+    {
+      m_cgroupCpuset = clientStatus["cgroup_cpuset"].GetString();
+    }
+
+    if (clientStatus.HasMember("cgroup_memory") && clientStatus["cgroup_memory"].IsUint64())
+    {
+      m_cgroupMemory = clientStatus["cgroup_memory"].GetUint64();
+    }
+
+    if (clientStatus.HasMember("cgroup_hugepages") && clientStatus["cgroup_hugepages"].IsInt64())
+    {
+      m_cgroupHugepages = clientStatus["cgroup_hugepages"].GetInt64();
+    }
+
     if (clientStatus.HasMember("avg_time"))
     {
       m_avgTime = clientStatus["avg_time"].GetUint();
@@ -712,6 +847,9 @@ rapidjson::Value ClientStatus::toJson(rapidjson::MemoryPoolAllocator<rapidjson::
   clientStatus.AddMember("hashrate_medium", m_hashrateMedium, allocator);
   clientStatus.AddMember("hashrate_long", m_hashrateLong, allocator);
   clientStatus.AddMember("hashrate_highest", m_hashrateHighest, allocator);
+  clientStatus.AddMember("cpu_power", m_cpuPower, allocator);
+  clientStatus.AddMember("hashes_per_joule", m_hashesPerJoule, allocator);
+  clientStatus.AddMember("cpu_temperature", m_cpuTemperature, allocator);
 
   clientStatus.AddMember("hash_factor", m_hashFactor, allocator);
   clientStatus.AddMember("total_pages", m_totalPages, allocator);
@@ -727,6 +865,11 @@ rapidjson::Value ClientStatus::toJson(rapidjson::MemoryPoolAllocator<rapidjson::
   clientStatus.AddMember("max_cpu_usage", m_maxCpuUsage, allocator);
   clientStatus.AddMember("total_memory", m_totalMemory, allocator);
   clientStatus.AddMember("free_memory", m_freeMemory, allocator);
+  clientStatus.AddMember("cgroup_version", m_cgroupVersion, allocator);
+  clientStatus.AddMember("cgroup_cpus", m_cgroupCpus, allocator);
+  clientStatus.AddMember("cgroup_cpuset", rapidjson::StringRef(m_cgroupCpuset.c_str()), allocator);
+  clientStatus.AddMember("cgroup_memory", m_cgroupMemory, allocator);
+  clientStatus.AddMember("cgroup_hugepages", m_cgroupHugepages, allocator);
 
   rapidjson::Value gpuInfoList(rapidjson::kArrayType);
   for (auto& gpuInfo : m_gpuInfoList)
@@ -737,6 +880,13 @@ rapidjson::Value ClientStatus::toJson(rapidjson::MemoryPoolAllocator<rapidjson::
   }
   clientStatus.AddMember("gpu_info_list", gpuInfoList, allocator);
 
+  rapidjson::Value thermalInfoList(rapidjson::kArrayType);
+  for (auto& thermalInfo : m_thermalInfoList)
+  {
+    thermalInfoList.PushBack(thermalInfo.toJson(allocator), allocator);
+  }
+  clientStatus.AddMember("thermal_info_list", thermalInfoList, allocator);
+
   clientStatus.AddMember("shares_good", m_sharesGood, allocator);
   clientStatus.AddMember("shares_total", m_sharesTotal, allocator);
   clientStatus.AddMember("hashes_total", m_hashesTotal, allocator);
@@ -778,3 +928,18 @@ void ClientStatus::addGPUInfo(const GPUInfo& gpuInfo)
 {
   m_gpuInfoList.push_back(gpuInfo);
 }
+
+const std::list<ThermalInfo>& ClientStatus::getThermalInfoList() const
+{
+  return m_thermalInfoList;
+}
+
+void ClientStatus::clearThermalInfoList()
+{
+  m_thermalInfoList.clear();
+}
+
+void ClientStatus::addThermalInfo(const ThermalInfo& thermalInfo)
+{
+  m_thermalInfoList.push_back(thermalInfo);
+}
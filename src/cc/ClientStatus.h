@@ -23,6 +23,7 @@
 #include <list>
 #include <rapidjson/document.h>
 #include "GPUInfo.h"
+#include "ThermalInfo.h"
 
 class ClientStatus
 {
@@ -123,6 +124,15 @@ public:
   void setHashrateHighest(double hashrateHighest);
   double getHashrateHighest() const;
 
+  double getCpuPower() const;
+  void setCpuPower(double cpuPower);
+
+  double getHashesPerJoule() const;
+  void setHashesPerJoule(double hashesPerJoule);
+
+  double getCpuTemperature() const;
+  void setCpuTemperature(double cpuTemperature);
+
   int getHashFactor() const;
   void setHashFactor(int hashFactor);
 
@@ -162,6 +172,21 @@ public:
   uint64_t getFreeMemory() const;
   void setFreeMemory(uint64_t freeMemory);
 
+  int getCgroupVersion() const;
+  void setCgroupVersion(int cgroupVersion);
+
+  double getCgroupCpus() const;
+  void setCgroupCpus(double cgroupCpus);
+
+  std::string getCgroupCpuset() const;
+  void setCgroupCpuset(const std::string& cgroupCpuset);
+
+  uint64_t getCgroupMemory() const;
+  void setCgroupMemory(uint64_t cgroupMemory);
+
+  int64_t getCgroupHugepages() const;
+  void setCgroupHugepages(int64_t cgroupHugepages);
+
   void setNodes(int nodes);
   int getNodes();
 
@@ -171,6 +196,12 @@ public:
 
   void clearGPUInfoList();
 
+  const std::list<ThermalInfo>& getThermalInfoList() const;
+
+  void addThermalInfo(const ThermalInfo& thermalInfo);
+
+  void clearThermalInfoList();
+
   uint64_t getSharesGood() const;
   void setSharesGood(uint64_t sharesGood);
 
@@ -215,6 +246,7 @@ private:
   std::string m_version;
   std::string m_log;
   std::string m_assembly;
+  std::string m_cgroupCpuset;
 
   bool m_hasHugepages = false;
   bool m_isHugepagesEnabled = false;
@@ -226,6 +258,10 @@ private:
   double m_hashrateMedium = 0;
   double m_hashrateLong = 0;
   double m_hashrateHighest = 0;
+  double m_cpuPower = 0;
+  double m_hashesPerJoule = 0;
+  double m_cpuTemperature = 0;
+  double m_cgroupCpus = 0;
 
   int m_hashFactor = 0;
   int m_totalPages = 0;
@@ -239,8 +275,10 @@ private:
   int m_cpuL3 = 0;
   int m_nodes = 0;
   int m_maxCpuUsage = 0;
+  int m_cgroupVersion = 0;
 
   std::list<GPUInfo> m_gpuInfoList;
+  std::list<ThermalInfo> m_thermalInfoList;
 
   uint64_t m_sharesGood = 0;
   uint64_t m_sharesTotal = 0;
@@ -248,6 +286,8 @@ private:
   uint64_t m_uptime = 0;
   uint64_t m_totalMemory = 0;
   uint64_t m_freeMemory = 0;
+  uint64_t m_cgroupMemory = 0;
+  int64_t m_cgroupHugepages = -1;
 
   uint32_t m_avgTime = 0;
   uint64_t m_lastStatusUpdate = 0;
@@ -0,0 +1,255 @@
+/* XMRigCC
+ * Copyright 2017-     BenDr0id    <https://github.com/BenDr0id>, <ben@graef.in>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <regex>
+#include <sstream>
+#include <utility>
+#include <sys/stat.h>
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "3rdparty/rapidjson/document.h"
+#include "3rdparty/rapidjson/prettywriter.h"
+#include "3rdparty/rapidjson/stringbuffer.h"
+#include "3rdparty/rapidjson/writer.h"
+#include "ConfigStore.h"
+
+namespace
+{
+std::string sanitize(const std::string& data)
+{
+  return std::regex_replace(data, std::regex(R"(([^\x20-~]+)|([\\/:?"<>|~;]+))"), "_");
+}
+};
+
+ConfigStore::ConfigStore(std::string folder)
+  : m_folder(std::move(folder))
+{
+
+}
+
+ConfigStore::Result ConfigStore::get(const std::string& clientId, Record& record)
+{
+  const std::string name = fileName(clientId);
+
+  int64_t mtime = 0;
+  uint64_t size = 0;
+
+  if (!stat(name, mtime, size))
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.erase(name);
+
+    return NOT_FOUND;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_entries.find(name);
+    if (it != m_entries.end() && it->second.mtime == mtime && it->second.size == size)
+    {
+      record = it->second.record;
+      return OK;
+    }
+  }
+
+  std::ifstream file(name);
+  if (!file)
+  {
+    return NOT_FOUND;
+  }
+
+  std::stringstream data;
+  data << file.rdbuf();
+
+  rapidjson::Document document;
+  if (document.Parse(data.str().c_str()).HasParseError())
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.erase(name);
+
+    return BROKEN;
+  }
+
+  rapidjson::StringBuffer buffer(0, 4096);
+  rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+  writer.SetMaxDecimalPlaces(10);
+  document.Accept(writer);
+
+  record.data = std::string(buffer.GetString(), buffer.GetSize());
+  record.etag = etag(record.data);
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  auto& entry = m_entries[name];
+  entry.record = record;
+  entry.mtime = mtime;
+  entry.size = size;
+
+  return OK;
+}
+
+ConfigStore::Result ConfigStore::set(const std::string& clientId, const std::string& json)
+{
+  rapidjson::Document document;
+  if (document.Parse(json.c_str()).HasParseError())
+  {
+    return BROKEN;
+  }
+
+  rapidjson::StringBuffer buffer(0, 4096);
+  rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
+  writer.SetMaxDecimalPlaces(10);
+  document.Accept(writer);
+
+  const std::string name = fileName(clientId);
+  const std::string tmpName = name + ".tmp" + std::to_string(++m_writes);
+
+  if (!writeTemp(tmpName, std::string(buffer.GetString(), buffer.GetSize())))
+  {
+    std::remove(tmpName.c_str());
+    return IO_ERROR;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (!replace(tmpName, name))
+    {
+      std::remove(tmpName.c_str());
+      return IO_ERROR;
+    }
+
+    // the cache is refreshed by the next get(), the compact form is only produced there
+    m_entries.erase(name);
+  }
+
+  syncFolder();
+
+  return OK;
+}
+
+ConfigStore::Result ConfigStore::remove(const std::string& clientId)
+{
+  const std::string name = fileName(clientId);
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  m_entries.erase(name);
+
+  return std::remove(name.c_str()) == 0 ? OK : NOT_FOUND;
+}
+
+std::string ConfigStore::fileName(const std::string& clientId) const
+{
+  std::string fileName;
+
+  if (!m_folder.empty())
+  {
+    fileName += m_folder;
+#       ifdef WIN32
+    fileName += '\\';
+#       else
+    fileName += '/';
+#       endif
+  }
+
+  fileName += sanitize(clientId) + std::string("_config.json");
+
+  return fileName;
+}
+
+std::string ConfigStore::etag(const std::string& data)
+{
+  // FNV-1a, stable across restarts so clients keep their ETag when the server is restarted
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  for (const char c : data)
+  {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 0x100000001b3ULL;
+  }
+
+  char buf[24] = {0};
+  snprintf(buf, sizeof(buf), "\"%016llx\"", static_cast<unsigned long long>(hash));
+
+  return buf;
+}
+
+bool ConfigStore::stat(const std::string& fileName, int64_t& mtime, uint64_t& size)
+{
+  struct stat st{};
+  if (::stat(fileName.c_str(), &st) != 0)
+  {
+    return false;
+  }
+
+#   ifdef __linux__
+  mtime = static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000LL + st.st_mtim.tv_nsec;
+#   else
+  mtime = static_cast<int64_t>(st.st_mtime);
+#   endif
+  size = static_cast<uint64_t>(st.st_size);
+
+  return true;
+}
+
+bool ConfigStore::writeTemp(const std::string& fileName, const std::string& data)
+{
+  FILE* file = fopen(fileName.c_str(), "wb");
+  if (!file)
+  {
+    return false;
+  }
+
+  bool result = fwrite(data.data(), 1, data.size(), file) == data.size() && fflush(file) == 0;
+
+#   ifndef WIN32
+  result = result && fsync(fileno(file)) == 0;
+#   endif
+
+  return (fclose(file) == 0) && result;
+}
+
+bool ConfigStore::replace(const std::string& from, const std::string& to)
+{
+#   ifdef WIN32
+  return MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#   else
+  return rename(from.c_str(), to.c_str()) == 0;
+#   endif
+}
+
+void ConfigStore::syncFolder() const
+{
+#   ifndef WIN32
+  // the rename itself is only durable once the directory entry is on disk
+  const int fd = open(m_folder.empty() ? "." : m_folder.c_str(), O_RDONLY | O_DIRECTORY);
+  if (fd >= 0)
+  {
+    fsync(fd);
+    close(fd);
+  }
+#   endif
+}
@@ -0,0 +1,86 @@
+/* XMRigCC
+ * Copyright 2017-     BenDr0id    <https://github.com/BenDr0id>, <ben@graef.in>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __CONFIG_STORE_H__
+#define __CONFIG_STORE_H__
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+
+/**
+ * Client config and template storage of the CC Server.
+ *
+ * Configs stay one pretty printed `<clientId>_config.json` per client so they can still be edited by hand, but
+ * reads are served from a cache of the compact JSON which is only rebuilt when size or mtime of the file change.
+ * Every record carries an ETag (content hash) for conditional requests. Writes go to a temporary file which is
+ * synced and renamed over the old one, so a crash never leaves a truncated config behind; only the rename is done
+ * under the lock.
+ */
+class ConfigStore
+{
+public:
+  enum Result
+  {
+    OK,
+    NOT_FOUND,
+    BROKEN,
+    IO_ERROR
+  };
+
+  struct Record
+  {
+    std::string data;
+    std::string etag;
+  };
+
+  explicit ConfigStore(std::string folder);
+
+public:
+  Result get(const std::string& clientId, Record& record);
+  Result set(const std::string& clientId, const std::string& json);
+  Result remove(const std::string& clientId);
+
+  std::string fileName(const std::string& clientId) const;
+
+  static std::string etag(const std::string& data);
+
+private:
+  struct Entry
+  {
+    Record record;
+    int64_t mtime = 0;
+    uint64_t size = 0;
+  };
+
+  static bool stat(const std::string& fileName, int64_t& mtime, uint64_t& size);
+  static bool writeTemp(const std::string& fileName, const std::string& data);
+  static bool replace(const std::string& from, const std::string& to);
+
+  void syncFolder() const;
+
+private:
+  const std::string m_folder;
+
+  std::atomic<uint64_t> m_writes{0};
+  std::map<std::string, Entry> m_entries;
+  std::mutex m_mutex;
+};
+
+#endif /* __CONFIG_STORE_H__ */
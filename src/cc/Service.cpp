@@ -41,18 +41,11 @@
 #include "Service.h"
 #include "fmt/format.h"
 
-namespace
-{
-std::string sanitize(const std::string& data)
-{
-  return std::regex_replace(data, std::regex(R"(([^\x20-~]+)|([\\/:?"<>|~;]+))"), "_");
-}
-};
-
 constexpr static char DEFAULT_MINER[] = "default_miner";
 
 Service::Service(std::shared_ptr<CCServerConfig> config)
-  : m_config(std::move(config))
+  : m_config(std::move(config)),
+    m_configStore(std::make_shared<ConfigStore>(m_config->clientConfigFolder()))
 {
 
 }
@@ -128,7 +121,7 @@ int Service::handleGET(const httplib::Request& req, httplib::Response& res)
 
   if (req.path == "/")
   {
-    resultCode = getAdminPage(res);
+    resultCode = getAdminPage(req, res);
   }
   else if (req.path.rfind("/admin/getClientStatusList", 0) == 0)
   {
@@ -148,7 +141,7 @@ int Service::handleGET(const httplib::Request& req, httplib::Response& res)
     {
       if (req.path.rfind("/client/getConfig", 0) == 0 || req.path.rfind("/admin/getClientConfig", 0) == 0)
       {
-        resultCode = getClientConfig(clientId, res);
+        resultCode = getClientConfig(req, clientId, res);
       }
       else if (req.path.rfind("/admin/getClientCommand", 0) == 0)
       {
@@ -217,6 +210,10 @@ int Service::handlePOST(const httplib::Request& req, httplib::Response& res)
     {
       resultCode = resetClientStatusList();
     }
+    else if (req.path.rfind("/admin/setClientConfigs", 0) == 0)
+    {
+      resultCode = setClientConfigs(req, res);
+    }
     else
     {
       LOG_WARN("[%s] 404 NOT FOUND (%s)", remoteAddr.c_str(), req.path.c_str());
@@ -226,32 +223,28 @@ int Service::handlePOST(const httplib::Request& req, httplib::Response& res)
   return resultCode;
 }
 
-int Service::getAdminPage(httplib::Response& res)
+int Service::getAdminPage(const httplib::Request& req, httplib::Response& res)
 {
-  std::stringstream data;
-
-  std::ifstream customDashboard(m_config->customDashboard());
-  if (customDashboard)
+  const auto dashboard = m_assetCache.get(m_config->customDashboard(), CONTENT_TYPE_HTML);
+  if (dashboard && !dashboard->data.empty())
   {
-    data << customDashboard.rdbuf();
-    customDashboard.close();
+    return AssetCache::serve(*dashboard, req, res);
   }
 
-  if (!data.rdbuf()->in_avail())
-  {
-    data << "<!DOCTYPE html>";
-    data << "<html lang=\"en\">";
-    data << "<head>";
-    data << "<meta charset=\"utf-8\">";
-    data << "<title>XMRigCC Dashboard</title>";
-    data << "</head>";
-    data << "<body>";
-    data << "    <div style=\"text-align: center;\">";
-    data << "       <h1>Please configure a Dashboard</h1>";
-    data << "    </div>";
-    data << "</body>";
-    data << "</html>";
-  }
+  std::stringstream data;
+
+  data << "<!DOCTYPE html>";
+  data << "<html lang=\"en\">";
+  data << "<head>";
+  data << "<meta charset=\"utf-8\">";
+  data << "<title>XMRigCC Dashboard</title>";
+  data << "</head>";
+  data << "<body>";
+  data << "    <div style=\"text-align: center;\">";
+  data << "       <h1>Please configure a Dashboard</h1>";
+  data << "    </div>";
+  data << "</body>";
+  data << "</html>";
 
   res.set_content(data.str(), CONTENT_TYPE_HTML);
 
@@ -481,51 +474,36 @@ int Service::getClientConfigTemplates(httplib::Response& res)
   return HTTP_OK;
 }
 
-int Service::getClientConfig(const std::string& clientId, httplib::Response& res)
+int Service::getClientConfig(const httplib::Request& req, const std::string& clientId, httplib::Response& res)
 {
   int resultCode = HTTP_INTERNAL_ERROR;
 
-  std::string clientConfigFileName = getClientConfigFileName(clientId);
-
-  std::stringstream data;
-  std::ifstream clientConfig(clientConfigFileName);
-  if (clientConfig)
-  {
-    data << clientConfig.rdbuf();
-    clientConfig.close();
-  }
-  else
+  ConfigStore::Record record;
+  auto result = m_configStore->get(clientId, record);
+  if (result == ConfigStore::NOT_FOUND)
   {
-    std::string defaultConfigFileName = getClientConfigFileName(DEFAULT_MINER);
-    std::ifstream defaultConfig(defaultConfigFileName);
-    if (defaultConfig)
-    {
-      data << defaultConfig.rdbuf();
-      defaultConfig.close();
-    }
+    result = m_configStore->get(DEFAULT_MINER, record);
   }
 
-  if (data.tellp() > 0)
+  if (result == ConfigStore::OK)
   {
-    rapidjson::Document respDocument;
-    respDocument.Parse(data.str().c_str());
+    res.set_header("ETag", record.etag);
 
-    if (!respDocument.HasParseError())
+    if (req.get_header_value("If-None-Match") == record.etag)
     {
-      rapidjson::StringBuffer buffer(0, 4096);
-      rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
-      writer.SetMaxDecimalPlaces(10);
-      respDocument.Accept(writer);
-
-      res.set_content(buffer.GetString(), CONTENT_TYPE_JSON);
-
-      resultCode = HTTP_OK;
+      resultCode = HTTP_NOT_MODIFIED;
     }
     else
     {
-      LOG_ERR("Not able to send client config. Client config %s is broken!", clientConfigFileName.c_str());
+      res.set_content(record.data, CONTENT_TYPE_JSON);
+
+      resultCode = HTTP_OK;
     }
   }
+  else if (result == ConfigStore::BROKEN)
+  {
+    LOG_ERR("Not able to send client config. Client config for %s is broken!", clientId.c_str());
+  }
   else
   {
     LOG_ERR("Not able to load a client config. Please check your configuration!");
@@ -569,43 +547,86 @@ int Service::setClientConfig(const httplib::Request& req, const std::string& cli
 
   std::string remoteAddr = req.get_header_value("REMOTE_ADDR");
 
-  rapidjson::Document respDocument;
-  if (!respDocument.Parse(req.body.c_str()).HasParseError())
+  if (m_configStore->fileName(clientId) != m_configStore->fileName(DEFAULT_MINER))
   {
-    std::string clientConfigFileName = getClientConfigFileName(clientId);
-    std::string defaultMinerConfigFileName = getClientConfigFileName(DEFAULT_MINER);
-
-    if (clientConfigFileName != defaultMinerConfigFileName)
+    const auto result = m_configStore->set(clientId, req.body);
+    if (result == ConfigStore::OK)
+    {
+      resultCode = HTTP_OK;
+    }
+    else if (result == ConfigStore::BROKEN)
     {
-      std::ofstream clientConfigFile(clientConfigFileName);
+      LOG_ERR("[%s] Not able to store client config. The received client config for client %s is broken!",
+              remoteAddr.c_str(), clientId.c_str());
+    }
+    else
+    {
+      LOG_ERR("[%s] Not able to store client config to file %s.", remoteAddr.c_str(),
+              m_configStore->fileName(clientId).c_str());
+    }
+  }
+  else
+  {
+    LOG_WARN("[%s] Someone is trying to override our %s file. Rejected!", remoteAddr.c_str(),
+             m_configStore->fileName(DEFAULT_MINER).c_str());
+  }
 
-      if (clientConfigFile)
-      {
-        rapidjson::StringBuffer buffer(0, 4096);
-        rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
-        writer.SetMaxDecimalPlaces(10);
-        respDocument.Accept(writer);
+  return resultCode;
+}
+
+int Service::setClientConfigs(const httplib::Request& req, httplib::Response& res)
+{
+  int resultCode = HTTP_BAD_REQUEST;
+
+  std::string remoteAddr = req.get_header_value("REMOTE_ADDR");
+
+  // {"<clientId>": {<config>}, ...}, a fleet wide rollout in one request
+  rapidjson::Document document;
+  if (!document.Parse(req.body.c_str()).HasParseError() && document.IsObject())
+  {
+    rapidjson::Document respDocument;
+    respDocument.SetObject();
+
+    auto& allocator = respDocument.GetAllocator();
+
+    rapidjson::Value failed(rapidjson::kArrayType);
+    size_t updated = 0;
+
+    for (auto& member : document.GetObject())
+    {
+      const std::string clientId = member.name.GetString();
 
-        clientConfigFile << buffer.GetString();
-        clientConfigFile.close();
+      rapidjson::StringBuffer buffer(0, 4096);
+      rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+      writer.SetMaxDecimalPlaces(10);
+      member.value.Accept(writer);
 
-        resultCode = HTTP_OK;
+      if (member.value.IsObject() && m_configStore->fileName(clientId) != m_configStore->fileName(DEFAULT_MINER) &&
+          m_configStore->set(clientId, buffer.GetString()) == ConfigStore::OK)
+      {
+        updated++;
       }
       else
       {
-        LOG_ERR("[%s] Not able to store client config to file %s.", remoteAddr.c_str(), clientConfigFileName.c_str());
+        LOG_ERR("[%s] Not able to store client config for client %s.", remoteAddr.c_str(), clientId.c_str());
+        failed.PushBack(rapidjson::Value(clientId.c_str(), allocator), allocator);
       }
     }
-    else
-    {
-      LOG_WARN("[%s] Someone is trying to override our %s file. Rejected!", remoteAddr.c_str(),
-               defaultMinerConfigFileName.c_str());
-    }
+
+    respDocument.AddMember("updated", static_cast<uint64_t>(updated), allocator);
+    respDocument.AddMember("failed", failed, allocator);
+
+    rapidjson::StringBuffer buffer(0, 4096);
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    respDocument.Accept(writer);
+
+    res.set_content(buffer.GetString(), CONTENT_TYPE_JSON);
+
+    resultCode = HTTP_OK;
   }
   else
   {
-    LOG_ERR("[%s] Not able to store client config. The received client config for client %s is broken!",
-            remoteAddr.c_str(), clientId.c_str());
+    LOG_ERR("[%s] Not able to store client configs. The received document is broken!", remoteAddr.c_str());
   }
 
   return resultCode;
@@ -635,18 +656,9 @@ int Service::deleteClientConfig(const std::string& clientId)
 {
   int resultCode = HTTP_BAD_REQUEST;
 
-
   if (!clientId.empty())
   {
-    std::string clientConfigFileName = getClientConfigFileName(clientId);
-    if (!clientConfigFileName.empty() && remove(clientConfigFileName.c_str()) == 0)
-    {
-      resultCode = HTTP_OK;
-    }
-    else
-    {
-      resultCode = HTTP_NOT_FOUND;
-    }
+    resultCode = m_configStore->remove(clientId) == ConfigStore::OK ? HTTP_OK : HTTP_NOT_FOUND;
   }
 
   return resultCode;
@@ -666,25 +678,6 @@ int Service::resetClientStatusList()
   return HTTP_OK;
 }
 
-std::string Service::getClientConfigFileName(const std::string& clientId)
-{
-  std::string clientConfigFileName;
-
-  if (!m_config->clientConfigFolder().empty())
-  {
-    clientConfigFileName += m_config->clientConfigFolder();
-#       ifdef WIN32
-    clientConfigFileName += '\\';
-#       else
-    clientConfigFileName += '/';
-#       endif
-  }
-
-  clientConfigFileName += sanitize(clientId) + std::string("_config.json");
-
-  return clientConfigFileName;
-}
-
 void Service::sendMinerOfflinePush(uint64_t now)
 {
   uint64_t offlineThreshold = now - OFFLINE_TRESHOLD_IN_MS;
@@ -23,8 +23,10 @@
 #include <map>
 #include "3rdparty/cpp-httplib/httplib.h"
 
+#include "AssetCache.h"
 #include "CCServerConfig.h"
 #include "ClientStatus.h"
+#include "ConfigStore.h"
 #include "ControlCommand.h"
 #include "Timer.h"
 
@@ -32,6 +34,7 @@ constexpr static char CONTENT_TYPE_HTML[] = "text/html";
 constexpr static char CONTENT_TYPE_JSON[] = "application/json";
 
 constexpr static int HTTP_OK = 200;
+constexpr static int HTTP_NOT_MODIFIED = 304;
 constexpr static int HTTP_BAD_REQUEST = 400;
 constexpr static int HTTP_UNAUTHORIZED = 401;
 constexpr static int HTTP_FORBIDDEN = 403;
@@ -63,24 +66,23 @@ public:
   int handlePOST(const httplib::Request& req, httplib::Response& res);
 
 private:
-  int getAdminPage(httplib::Response& res);
+  int getAdminPage(const httplib::Request& req, httplib::Response& res);
 
   int getClientStatusList(httplib::Response& res);
   int getClientStatistics(httplib::Response& res);
   int getClientCommand(const std::string& clientId, httplib::Response& res);
   int getClientConfigTemplates(httplib::Response& res);
-  int getClientConfig(const std::string& clientId, httplib::Response& res);
+  int getClientConfig(const httplib::Request& req, const std::string& clientId, httplib::Response& res);
   int getClientLog(const std::string& clientId, httplib::Response& res);
 
   int setClientStatus(const httplib::Request& req, const std::string& clientId, httplib::Response& res);
   int setClientCommand(const httplib::Request& req, const std::string& clientId, httplib::Response& res);
   int setClientConfig(const httplib::Request& req, const std::string& clientId, httplib::Response& res);
+  int setClientConfigs(const httplib::Request& req, httplib::Response& res);
   int deleteClientConfig(const std::string& clientId);
   int removeClientStatus(const std::string clientId);
   int resetClientStatusList();
 
-  std::string getClientConfigFileName(const std::string& clientId);
-
   void setClientLog(size_t maxRows, const std::string& clientId, const std::string& log);
 
   void sendServerStatusPush(uint64_t now);
@@ -95,6 +97,9 @@ private:
 private:
   std::shared_ptr<CCServerConfig> m_config;
   std::shared_ptr<Timer> m_timer;
+  std::shared_ptr<ConfigStore> m_configStore;
+
+  AssetCache m_assetCache;
 
   uint64_t m_currentServerTime = 0;
   uint64_t m_lastStatusUpdateTime = 0;
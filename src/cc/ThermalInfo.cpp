@@ -0,0 +1,124 @@
+/* XMRigCC
+ * Copyright 2017-     BenDr0id    <https://github.com/BenDr0id>, <ben@graef.in>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ThermalInfo.h"
+
+ThermalInfo::ThermalInfo()
+{
+
+}
+
+ThermalInfo::~ThermalInfo()
+{
+
+}
+
+rapidjson::Value ThermalInfo::toJson(rapidjson::MemoryPoolAllocator<rapidjson::CrtAllocator>& allocator)
+{
+  rapidjson::Value thermalInfo(rapidjson::kObjectType);
+
+  thermalInfo.AddMember("name", rapidjson::StringRef(m_name.c_str()), allocator);
+  thermalInfo.AddMember("package", m_package, allocator);
+  thermalInfo.AddMember("temperature", m_temperature, allocator);
+  thermalInfo.AddMember("duty", m_duty, allocator);
+  thermalInfo.AddMember("threads", m_threads, allocator);
+
+  return thermalInfo;
+}
+
+bool ThermalInfo::parseFromJson(const rapidjson::Value& thermalInfo)
+{
+  bool result = false;
+
+  if (thermalInfo.HasMember("name") && thermalInfo["name"].IsString())
+  {
+    m_name = thermalInfo["name"].GetString();
+    result = true;
+  }
+
+  if (thermalInfo.HasMember("package") && thermalInfo["package"].IsInt())
+  {
+    m_package = thermalInfo["package"].GetInt();
+  }
+
+  if (thermalInfo.HasMember("temperature") && thermalInfo["temperature"].IsNumber())
+  {
+    m_temperature = thermalInfo["temperature"].GetDouble();
+  }
+
+  if (thermalInfo.HasMember("duty") && thermalInfo["duty"].IsInt())
+  {
+    m_duty = thermalInfo["duty"].GetInt();
+  }
+
+  if (thermalInfo.HasMember("threads") && thermalInfo["threads"].IsUint())
+  {
+    m_threads = thermalInfo["threads"].GetUint();
+  }
+
+  return result;
+}
+
+int ThermalInfo::getPackage() const
+{
+  return m_package;
+}
+
+void ThermalInfo::setPackage(int package)
+{
+  m_package = package;
+}
+
+double ThermalInfo::getTemperature() const
+{
+  return m_temperature;
+}
+
+void ThermalInfo::setTemperature(double temperature)
+{
+  m_temperature = temperature;
+}
+
+int ThermalInfo::getDuty() const
+{
+  return m_duty;
+}
+
+void ThermalInfo::setDuty(int duty)
+{
+  m_duty = duty;
+}
+
+uint32_t ThermalInfo::getThreads() const
+{
+  return m_threads;
+}
+
+void ThermalInfo::setThreads(uint32_t threads)
+{
+  m_threads = threads;
+}
+
+std::string ThermalInfo::getName() const
+{
+  return m_name;
+}
+
+void ThermalInfo::setName(const std::string& name)
+{
+  m_name = name;
+}
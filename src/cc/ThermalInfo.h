@@ -0,0 +1,62 @@
+/* XMRigCC
+ * Copyright 2017-     BenDr0id    <https://github.com/BenDr0id>, <ben@graef.in>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_THERMALINFO_H
+#define XMRIG_THERMALINFO_H
+
+#include <string>
+#include "3rdparty/rapidjson/document.h"
+
+class ThermalInfo
+{
+public:
+  ThermalInfo();
+
+  ~ThermalInfo();
+
+  rapidjson::Value toJson(rapidjson::MemoryPoolAllocator<rapidjson::CrtAllocator>& allocator);
+
+  bool parseFromJson(const rapidjson::Value& thermalInfo);
+
+  int getPackage() const;
+  void setPackage(int package);
+
+  double getTemperature() const;
+  void setTemperature(double temperature);
+
+  int getDuty() const;
+  void setDuty(int duty);
+
+  uint32_t getThreads() const;
+  void setThreads(uint32_t threads);
+
+  std::string getName() const;
+  void setName(const std::string& name);
+
+private:
+  double m_temperature{0};
+
+  int m_package{-1};
+  int m_duty{100};
+
+  uint32_t m_threads{0};
+
+  std::string m_name;
+};
+
+
+#endif //XMRIG_THERMALINFO_H
@@ -0,0 +1,70 @@
+/* XMRigCC
+ * Copyright 2017-     BenDr0id    <https://github.com/BenDr0id>, <ben@graef.in>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <iostream>
+#include <cxxopts/cxxopts.hpp>
+#include "CCBench.h"
+#include "version.h"
+
+int main(int argc, char** argv)
+{
+  int ret = 0;
+
+  try
+  {
+    cxxopts::Options options(argv[0], APP_NAME "Bench " APP_VERSION);
+    options.positional_help("[optional args]");
+    options.show_positional_help();
+
+    options.add_options()
+      ("H, host", "The CC Server host", cxxopts::value<std::string>()->default_value("127.0.0.1"))
+      ("p, port", "The CC Server port", cxxopts::value<int>()->default_value("3344"), "N")
+      ("T, token", "The CC Server access token for the CC Client", cxxopts::value<std::string>())
+      ("t, tls", "Use SSL/TLS to connect to the CC Server", cxxopts::value<bool>()->default_value("false"))
+
+      ("n, clients", "Number of simulated CC Clients", cxxopts::value<int>()->default_value("100"), "N")
+      ("j, threads", "Number of request threads", cxxopts::value<int>()->default_value("4"), "N")
+      ("d, duration", "Benchmark duration in seconds", cxxopts::value<int>()->default_value("60"), "N")
+      ("status-interval", "Seconds between status updates of each client", cxxopts::value<int>()->default_value("10"), "N")
+      ("config-interval", "Seconds between config fetches of each client (0 = off)", cxxopts::value<int>()->default_value("0"), "N")
+      ("log-lines", "Log lines sent with each status update", cxxopts::value<int>()->default_value("20"), "N")
+      ("gpus", "GPUs reported by each client", cxxopts::value<int>()->default_value("0"), "N")
+      ("algo", "Algorithm reported by each client", cxxopts::value<std::string>()->default_value("rx/0"))
+      ("publish-config", "Publish a config for each client on first contact", cxxopts::value<bool>()->default_value("false"))
+      ("server-pid", "Pid of a local CC Server to sample cpu and memory usage from", cxxopts::value<int>(), "PID")
+
+      ("h, help", "Print this help");
+
+    auto result = options.parse(argc, argv);
+    if (result.count("help"))
+    {
+      std::cout << options.help({""}) << std::endl;
+    }
+    else
+    {
+      CCBench bench(result);
+      ret = bench.start();
+    }
+  }
+  catch (const cxxopts::OptionException& e)
+  {
+    std::cout << "error parsing options: " << e.what() << std::endl;
+    ret = EINVAL;
+  }
+
+  return ret;
+}
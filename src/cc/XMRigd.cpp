@@ -33,6 +33,15 @@
 #include <errno.h>
 #endif
 
+#ifdef XMRIG_FEATURE_HANDOFF
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <sstream>
+#include <unistd.h>
+#include <vector>
+#endif
+
 #ifndef MINER_EXECUTABLE_NAME
 #define MINER_EXECUTABLE_NAME xmrigMiner
 #endif
@@ -45,73 +54,241 @@ bool fileFound(const std::string& filePath)
   return file.good();
 }
 
-int main(int argc, char** argv)
+void applyUpdate(const std::string& fullMinerBinaryPath)
 {
-  std::string ownPath(argv[0]);
-  std::string params = " --daemonized";
-  for (int i = 1; i < argc; i++)
+  auto status = EXIT_SUCCESS;
+
+  if (!fileFound(fullMinerBinaryPath + UPDATE_EXTENSION))
   {
-    params += " ";
-    params += argv[i];
+    return;
   }
 
-#if defined(_WIN32) || defined(WIN32)
-  auto pos = ownPath.rfind('\\');
-  std::string minerBinaryName(VALUE(MINER_EXECUTABLE_NAME) ".exe");
-#else
-  auto pos = ownPath.rfind('/');
-  std::string minerBinaryName(VALUE(MINER_EXECUTABLE_NAME));
+  // remove old backup file
+  if (fileFound(fullMinerBinaryPath + BACKUP_EXTENSION))
+  {
+    status = std::remove((fullMinerBinaryPath + BACKUP_EXTENSION).c_str());
+  }
+
+  if (status == EXIT_SUCCESS)
+  {
+    // rename original to backup
+    status = std::rename(fullMinerBinaryPath.c_str(), (fullMinerBinaryPath + BACKUP_EXTENSION).c_str());
+    if (status == EXIT_SUCCESS)
+    {
+      // rename update to original
+      status = std::rename((fullMinerBinaryPath + UPDATE_EXTENSION).c_str(), fullMinerBinaryPath.c_str());
+
+#if !defined(_WIN32) && !defined(WIN32)
+      if (status == EXIT_SUCCESS)
+      {
+        // on non-windows system make file executable
+        status = chmod(fullMinerBinaryPath.c_str(), S_IRWXU);
+      }
 #endif
+    }
 
-  auto fullMinerBinaryPath = ownPath.substr(0, pos + 1) + minerBinaryName;
-  auto status = EXIT_SUCCESS;
+    if (status != EXIT_SUCCESS)
+    {
+      // try to rollback
+      std::rename((fullMinerBinaryPath + BACKUP_EXTENSION).c_str(), fullMinerBinaryPath.c_str());
+    }
+  }
+  else
+  {
+    // update failed try to remove the update
+    std::remove((fullMinerBinaryPath + UPDATE_EXTENSION).c_str());
+  }
+}
 
-  do
+#ifdef XMRIG_FEATURE_HANDOFF
+pid_t spawnMiner(const std::vector<std::string>& args, int controlFd, const std::string& handoffPath)
+{
+  auto pid = fork();
+  if (pid != 0)
   {
-    status = EXIT_SUCCESS;
+    return pid;
+  }
 
-    // apply update if we have one
-    if (fileFound(fullMinerBinaryPath + UPDATE_EXTENSION))
+  signal(SIGINT, SIG_DFL);
+  signal(SIGQUIT, SIG_DFL);
+
+  setenv(DAEMON_FD_ENV, std::to_string(controlFd).c_str(), 1);
+  if (handoffPath.empty())
+  {
+    unsetenv(HANDOFF_ENV);
+  }
+  else
+  {
+    setenv(HANDOFF_ENV, handoffPath.c_str(), 1);
+  }
+
+  std::vector<char*> argv;
+  for (const auto& arg : args)
+  {
+    argv.push_back(const_cast<char*>(arg.c_str()));
+  }
+  argv.push_back(nullptr);
+
+  execv(argv[0], argv.data());
+  _exit(127);
+}
+
+// Runs the miner until it exits without a successor. A running miner can ask for a successor by writing
+// "handoff <pid> <socket path>" to the control pipe, the new miner is started next to it and takes over
+// its pool connection and dataset. A pending update is started from the update file and installed only when
+// the successor reports "active <pid>". If the successor dies first or the old miner reports "cancel <pid>",
+// the old miner stays in charge.
+int runMiner(const std::string& fullMinerBinaryPath, const std::vector<std::string>& args)
+{
+  int control[2];
+  if (pipe(control) != 0)
+  {
+    return EXIT_FAILURE << 8;
+  }
+
+  fcntl(control[0], F_SETFD, FD_CLOEXEC);
+
+  signal(SIGINT, SIG_IGN);
+  signal(SIGQUIT, SIG_IGN);
+
+  applyUpdate(fullMinerBinaryPath);
+
+  auto current = spawnMiner(args, control[1], "");
+  pid_t previous = -1;
+  bool updating = false;
+  int status = EXIT_FAILURE << 8;
+  std::string buffer;
+
+  while (current > 0)
+  {
+    pollfd pfd = {control[0], POLLIN, 0};
+    if (poll(&pfd, 1, 200) > 0)
     {
-      // remove old backup file
-      if (fileFound(fullMinerBinaryPath + BACKUP_EXTENSION))
+      char data[512];
+      auto size = read(control[0], data, sizeof(data));
+      if (size > 0)
       {
-        status = std::remove((fullMinerBinaryPath + BACKUP_EXTENSION).c_str());
+        buffer.append(data, static_cast<size_t>(size));
       }
 
-      if (status == EXIT_SUCCESS)
+      size_t pos;
+      while ((pos = buffer.find('\n')) != std::string::npos)
       {
-        // rename original to backup
-        status = std::rename(fullMinerBinaryPath.c_str(), (fullMinerBinaryPath + BACKUP_EXTENSION).c_str());
-        if (status == EXIT_SUCCESS)
+        std::istringstream line(buffer.substr(0, pos));
+        buffer.erase(0, pos + 1);
+
+        std::string request;
+        std::string path;
+        pid_t pid = -1;
+        line >> request >> pid >> path;
+
+        if (request == "handoff" && pid == current && previous < 0 && !path.empty())
         {
-          // rename update to original
-          status = std::rename((fullMinerBinaryPath + UPDATE_EXTENSION).c_str(), fullMinerBinaryPath.c_str());
+          auto successorArgs = args;
+          updating = fileFound(fullMinerBinaryPath + UPDATE_EXTENSION) &&
+                     chmod((fullMinerBinaryPath + UPDATE_EXTENSION).c_str(), S_IRWXU) == 0;
 
-#if !defined(_WIN32) && !defined(WIN32)
-          if (status == EXIT_SUCCESS)
+          if (updating)
           {
-            // on non-windows system make file executable
-            status = chmod(fullMinerBinaryPath.c_str(), S_IRWXU);
+            successorArgs[0] = fullMinerBinaryPath + UPDATE_EXTENSION;
           }
-#endif
-        }
 
-        if (status != EXIT_SUCCESS)
+          auto successor = spawnMiner(successorArgs, control[1], path);
+          if (successor > 0)
+          {
+            previous = current;
+            current = successor;
+          }
+          else
+          {
+            updating = false;
+          }
+        }
+        else if (request == "active" && pid == current)
+        {
+          if (updating)
+          {
+            applyUpdate(fullMinerBinaryPath);
+            updating = false;
+          }
+        }
+        else if (request == "cancel" && pid == previous)
         {
-          // try to rollback
-          std::rename((fullMinerBinaryPath + BACKUP_EXTENSION).c_str(), fullMinerBinaryPath.c_str());
+          // the old miner keeps running, waitpid() below makes it current again
+          kill(current, SIGKILL);
+          updating = false;
         }
       }
-      else
+    }
+
+    int childStatus = 0;
+    pid_t pid;
+    while ((pid = waitpid(-1, &childStatus, WNOHANG)) > 0)
+    {
+      if (pid == previous)
+      {
+        previous = -1;
+      }
+      else if (pid == current)
       {
-        // update failed try to remove the update
-        std::remove((fullMinerBinaryPath + UPDATE_EXTENSION).c_str());
+        current = previous;
+        previous = -1;
+        updating = false;
+        status = childStatus;
       }
     }
+  }
+
+  close(control[0]);
+  close(control[1]);
+
+  signal(SIGINT, SIG_DFL);
+  signal(SIGQUIT, SIG_DFL);
+
+  return status;
+}
+#endif
+
+int main(int argc, char** argv)
+{
+  std::string ownPath(argv[0]);
+  std::string params = " --daemonized";
+  for (int i = 1; i < argc; i++)
+  {
+    params += " ";
+    params += argv[i];
+  }
+
+#if defined(_WIN32) || defined(WIN32)
+  auto pos = ownPath.rfind('\\');
+  std::string minerBinaryName(VALUE(MINER_EXECUTABLE_NAME) ".exe");
+#else
+  auto pos = ownPath.rfind('/');
+  std::string minerBinaryName(VALUE(MINER_EXECUTABLE_NAME));
+#endif
+
+  auto fullMinerBinaryPath = ownPath.substr(0, pos + 1) + minerBinaryName;
+  auto status = EXIT_SUCCESS;
+
+#ifdef XMRIG_FEATURE_HANDOFF
+  std::vector<std::string> args = {fullMinerBinaryPath, "--daemonized"};
+  for (int i = 1; i < argc; i++)
+  {
+    args.emplace_back(argv[i]);
+  }
+#endif
+
+  do
+  {
+#ifdef XMRIG_FEATURE_HANDOFF
+    status = runMiner(fullMinerBinaryPath, args);
+#else
+    // apply update if we have one
+    applyUpdate(fullMinerBinaryPath);
 
     // execute miner and wait for result
     status = system(("\"" +fullMinerBinaryPath + "\""  + params).c_str());
+#endif
 #if defined(_WIN32) || defined(WIN32)
     } while (status != EINVAL && status != SIGHUP && status != SIGINT && status != EXIT_SUCCESS);
 
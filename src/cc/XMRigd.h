@@ -24,4 +24,7 @@ constexpr static int RC_RESTART = 10000;
 constexpr static char BACKUP_EXTENSION[] = ".bak";
 constexpr static char UPDATE_EXTENSION[] = ".upd";
 
+constexpr static char DAEMON_FD_ENV[] = "XMRIG_DAEMON_FD";
+constexpr static char HANDOFF_ENV[] = "XMRIG_HANDOFF";
+
 #endif /* __XMRIGD_H__ */
@@ -30,6 +30,11 @@
 #endif
 
 
+#ifdef XMRIG_FEATURE_HANDOFF
+#   include "core/Handoff.h"
+#endif
+
+
 #include <cassert>
 
 
@@ -68,7 +73,13 @@ void xmrig::Controller::start()
 
     m_miner = std::make_shared<Miner>(this);
 
+#   ifdef XMRIG_FEATURE_HANDOFF
+    Handoff::receive(this);
     network()->connect();
+    Handoff::release();
+#   else
+    network()->connect();
+#   endif
 }
 
 
@@ -0,0 +1,823 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "core/Handoff.h"
+#include "3rdparty/rapidjson/document.h"
+#include "3rdparty/rapidjson/stringbuffer.h"
+#include "3rdparty/rapidjson/writer.h"
+#include "base/io/json/Json.h"
+#include "base/io/log/Log.h"
+#include "base/io/log/Tags.h"
+#include "base/kernel/interfaces/IClient.h"
+#include "base/kernel/interfaces/IStrategy.h"
+#include "base/net/stratum/Job.h"
+#include "base/tools/Baton.h"
+#include "base/tools/Chrono.h"
+#include "base/tools/Cvt.h"
+#include "base/tools/Handle.h"
+#include "base/tools/Timer.h"
+#include "cc/XMRigd.h"
+#include "core/config/Config.h"
+#include "core/Controller.h"
+#include "core/Miner.h"
+#include "crypto/common/Nonce.h"
+#include "net/Network.h"
+
+
+#ifdef XMRIG_FEATURE_API
+#   include "base/api/Api.h"
+#endif
+
+
+#ifdef XMRIG_ALGO_RANDOMX
+#   include "crypto/rx/Rx.h"
+#   include "crypto/rx/RxDataset.h"
+#   include "crypto/rx/RxSeed.h"
+#endif
+
+
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <fcntl.h>
+#include <mutex>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <uv.h>
+#include <vector>
+
+
+namespace xmrig {
+
+
+constexpr size_t kMaxFds            = 2;
+constexpr size_t kChunkSize         = 64 * 1024 * 1024;
+constexpr uint32_t kMaxMessageSize  = 1024 * 1024;
+constexpr uint64_t kStateTimeout    = 10 * 1000;
+
+
+static struct
+{
+    int dataset     = -1;
+    int socket      = -1;
+    rapidjson::Document state;
+    String jobId;
+    uint64_t nonce  = 0;
+    std::condition_variable imported;
+    std::mutex mutex;
+
+#   ifdef XMRIG_ALGO_RANDOMX
+    RxSeed seed;
+#   endif
+} incoming;
+
+
+static int daemonFd()
+{
+    const char *env = getenv(DAEMON_FD_ENV); // NOLINT(concurrency-mt-unsafe)
+    if (!env) {
+        return -1;
+    }
+
+    const int fd = static_cast<int>(strtol(env, nullptr, 10));
+
+    return fd > STDERR_FILENO && fcntl(fd, F_GETFD) != -1 ? fd : -1;
+}
+
+
+static void notifyDaemon(const char *request)
+{
+    const int control = daemonFd();
+    if (control < 0) {
+        return;
+    }
+
+    const std::string line = std::string(request) + " " + std::to_string(getpid()) + "\n";
+    if (write(control, line.data(), line.size()) != static_cast<ssize_t>(line.size())) {
+        LOG_ERR("%s " RED("daemon is not reachable: ") RED_BOLD("\"%s\""), Tags::miner(), strerror(errno));
+    }
+}
+
+
+static std::string socketPath()
+{
+    char tmp[1024]  = {};
+    size_t size     = sizeof(tmp);
+
+    if (uv_os_tmpdir(tmp, &size) != 0) {
+        strncpy(tmp, "/tmp", sizeof(tmp) - 1);
+    }
+
+    return std::string(tmp) + "/xmrig-handoff-" + std::to_string(getpid()) + ".sock";
+}
+
+
+static bool wait(int fd, short events, uint64_t timeout)
+{
+    pollfd pfd = { fd, events, 0 };
+    int rc     = 0;
+
+    do {
+        rc = poll(&pfd, 1, static_cast<int>(timeout));
+    } while (rc < 0 && errno == EINTR);
+
+    return rc > 0;
+}
+
+
+static void closeAll(std::vector<int> &fds)
+{
+    for (const int fd : fds) {
+        close(fd);
+    }
+
+    fds.clear();
+}
+
+
+static bool sendMessage(int fd, const rapidjson::Document &doc, const std::vector<int> &fds)
+{
+    rapidjson::StringBuffer buffer(nullptr, 4096);
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    doc.Accept(writer);
+
+    const auto size = static_cast<uint32_t>(buffer.GetSize());
+    std::vector<char> data(sizeof(size) + size);
+    memcpy(data.data(), &size, sizeof(size));
+    memcpy(data.data() + sizeof(size), buffer.GetString(), size);
+
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int) * kMaxFds)] = {};
+    iovec iov  = { data.data(), data.size() };
+    msghdr msg = {};
+    msg.msg_iov    = &iov;
+    msg.msg_iovlen = 1;
+
+    if (!fds.empty()) {
+        msg.msg_control    = control;
+        msg.msg_controllen = CMSG_SPACE(sizeof(int) * fds.size());
+
+        cmsghdr *cmsg    = CMSG_FIRSTHDR(&msg);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type  = SCM_RIGHTS;
+        cmsg->cmsg_len   = CMSG_LEN(sizeof(int) * fds.size());
+        memcpy(CMSG_DATA(cmsg), fds.data(), sizeof(int) * fds.size());
+    }
+
+    size_t offset = 0;
+    while (offset < data.size()) {
+        const ssize_t rc = sendmsg(fd, &msg, MSG_NOSIGNAL);
+        if (rc < 0) {
+            if (errno == EINTR || ((errno == EAGAIN || errno == EWOULDBLOCK) && wait(fd, POLLOUT, 1000))) {
+                continue;
+            }
+
+            return false;
+        }
+
+        offset += static_cast<size_t>(rc);
+        iov.iov_base = data.data() + offset;
+        iov.iov_len  = data.size() - offset;
+
+        // descriptors travel with the first byte only
+        msg.msg_control    = nullptr;
+        msg.msg_controllen = 0;
+    }
+
+    return true;
+}
+
+
+static bool receive(int fd, char *data, size_t size, std::vector<int> &fds, uint64_t deadline)
+{
+    size_t offset = 0;
+
+    while (offset < size) {
+        alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int) * kMaxFds)] = {};
+        iovec iov  = { data + offset, size - offset };
+        msghdr msg = {};
+        msg.msg_iov        = &iov;
+        msg.msg_iovlen     = 1;
+        msg.msg_control    = control;
+        msg.msg_controllen = sizeof(control);
+
+        const ssize_t rc = recvmsg(fd, &msg, MSG_CMSG_CLOEXEC);
+        if (rc < 0) {
+            const uint64_t now = Chrono::steadyMSecs();
+            if (errno == EINTR || ((errno == EAGAIN || errno == EWOULDBLOCK) && now < deadline && wait(fd, POLLIN, deadline - now))) {
+                continue;
+            }
+
+            return false;
+        }
+
+        for (cmsghdr *cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+            if (cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS) {
+                continue;
+            }
+
+            const size_t count = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+            for (size_t i = 0; i < count; ++i) {
+                int received = -1;
+                memcpy(&received, CMSG_DATA(cmsg) + i * sizeof(int), sizeof(int));
+                fds.push_back(received);
+            }
+        }
+
+        if (rc == 0) {
+            return false;
+        }
+
+        offset += static_cast<size_t>(rc);
+    }
+
+    return true;
+}
+
+
+static bool receiveMessage(int fd, rapidjson::Document &doc, std::vector<int> &fds, uint64_t timeout)
+{
+    const uint64_t deadline = Chrono::steadyMSecs() + timeout;
+    uint32_t size           = 0;
+
+    if (!receive(fd, reinterpret_cast<char *>(&size), sizeof(size), fds, deadline) || size == 0 || size > kMaxMessageSize) {
+        return false;
+    }
+
+    std::vector<char> data(size);
+    if (!receive(fd, data.data(), size, fds, deadline)) {
+        return false;
+    }
+
+    return !doc.Parse(data.data(), size).HasParseError() && doc.IsObject();
+}
+
+
+static bool isType(const rapidjson::Value &doc, const char *type)
+{
+    return strcmp(Json::getString(doc, "type", ""), type) == 0;
+}
+
+
+#ifdef XMRIG_ALGO_RANDOMX
+static int exportDataset(const void *raw, size_t size)
+{
+    const int fd = memfd_create("xmrig-dataset", MFD_CLOEXEC);
+    if (fd < 0) {
+        return -1;
+    }
+
+    const auto *data = static_cast<const char *>(raw);
+    size_t offset    = 0;
+
+    while (offset < size) {
+        const ssize_t rc = write(fd, data + offset, std::min(size - offset, kChunkSize));
+        if (rc < 0 && errno == EINTR) {
+            continue;
+        }
+
+        if (rc <= 0) {
+            close(fd);
+
+            return -1;
+        }
+
+        offset += static_cast<size_t>(rc);
+    }
+
+    return fd;
+}
+
+
+class DatasetBaton : public Baton<uv_work_t>
+{
+public:
+    inline DatasetBaton(Handoff *handoff, const Job &job, const void *raw) :
+        algo(job.algorithm().name()),
+        seed(Cvt::toHex(job.seed())),
+        raw(raw),
+        handoff(handoff)
+    {}
+
+    const char *algo;
+    const String seed;
+    const void *raw;
+    Handoff *handoff;
+    int fd = -1;
+};
+#endif
+
+
+} // namespace xmrig
+
+
+xmrig::Handoff::Handoff(Controller *controller, Callback callback) :
+    m_callback(std::move(callback)),
+    m_controller(controller)
+{
+}
+
+
+xmrig::Handoff::~Handoff()
+{
+    Handle::close(m_poll);
+
+    delete m_timer;
+
+    if (m_connection >= 0) {
+        close(m_connection);
+    }
+
+    if (m_server >= 0) {
+        close(m_server);
+        unlink(m_path.c_str());
+    }
+}
+
+
+bool xmrig::Handoff::importDataset(const RxSeed &seed, void *raw, size_t size)
+{
+#   ifdef XMRIG_ALGO_RANDOMX
+    std::lock_guard<std::mutex> lock(incoming.mutex);
+
+    if (incoming.dataset < 0) {
+        return false;
+    }
+
+    struct stat st = {};
+    bool ok        = raw && incoming.seed == seed && fstat(incoming.dataset, &st) == 0 && static_cast<size_t>(st.st_size) >= size;
+    size_t offset  = 0;
+
+    while (ok && offset < size) {
+        const ssize_t rc = pread(incoming.dataset, static_cast<char *>(raw) + offset, std::min(size - offset, kChunkSize), static_cast<off_t>(offset));
+        if (rc < 0 && errno == EINTR) {
+            continue;
+        }
+
+        ok      = rc > 0;
+        offset += ok ? static_cast<size_t>(rc) : 0;
+    }
+
+    close(incoming.dataset);
+    incoming.dataset = -1;
+    incoming.imported.notify_all();
+
+    if (ok) {
+        LOG_INFO("%s" GREEN_BOLD(" dataset imported from the previous miner"), Tags::randomx());
+    }
+
+    return ok;
+#   else
+    return false;
+#   endif
+}
+
+
+bool xmrig::Handoff::isAvailable()
+{
+    return daemonFd() >= 0;
+}
+
+
+int xmrig::Handoff::socket(const char *url, const rapidjson::Value **state)
+{
+    if (incoming.socket < 0 || !url || !incoming.state.IsObject()) {
+        return -1;
+    }
+
+    const rapidjson::Value &pool = Json::getObject(incoming.state, "pool");
+    if (strcmp(Json::getString(pool, "url", ""), url) != 0) {
+        return -1;
+    }
+
+    const int fd    = incoming.socket;
+    incoming.socket = -1;
+    *state          = &pool;
+
+    return fd;
+}
+
+
+uint64_t xmrig::Handoff::nonce(const Job &job)
+{
+    if (incoming.jobId.isNull() || job.index() != 0 || job.id() != incoming.jobId) {
+        return 0;
+    }
+
+    incoming.jobId = String();
+
+    return incoming.nonce;
+}
+
+
+void xmrig::Handoff::receive(Controller *controller)
+{
+    const char *env = getenv(HANDOFF_ENV); // NOLINT(concurrency-mt-unsafe)
+    if (!env) {
+        return;
+    }
+
+    sockaddr_un addr = {};
+    addr.sun_family  = AF_UNIX;
+    strncpy(addr.sun_path, env, sizeof(addr.sun_path) - 1);
+    unsetenv(HANDOFF_ENV); // NOLINT(concurrency-mt-unsafe)
+
+    const int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0 || connect(fd, reinterpret_cast<const sockaddr *>(&addr), sizeof(addr)) != 0) {
+        LOG_ERR("%s " RED("handoff connect error: ") RED_BOLD("\"%s\""), Tags::miner(), strerror(errno));
+
+        if (fd >= 0) {
+            close(fd);
+        }
+
+        return;
+    }
+
+    using namespace rapidjson;
+    Document doc;
+    std::vector<int> fds;
+
+    if (!receiveMessage(fd, doc, fds, kTimeout) || !isType(doc, "dataset")) {
+        LOG_ERR("%s " RED("previous miner did not respond"), Tags::miner());
+
+        closeAll(fds);
+        close(fd);
+
+        return;
+    }
+
+#   ifdef XMRIG_ALGO_RANDOMX
+    if (fds.size() == 1) {
+        const RxSeed seed(Json::getString(doc, "algo", ""), Cvt::fromHex(Json::getString(doc, "seed", ""), strlen(Json::getString(doc, "seed", ""))));
+
+        {
+            std::lock_guard<std::mutex> lock(incoming.mutex);
+            incoming.dataset = fds[0];
+            incoming.seed    = seed;
+            fds.clear();
+        }
+
+        // The dataset is picked up by the first RxDataset::init() on the RandomX thread, only wait until it is
+        // copied (or rejected), the remaining initialization continues in the background as usual.
+        const bool ready = Rx::init(seed, controller->config()->rx(), controller->config()->cpu());
+
+        std::unique_lock<std::mutex> lock(incoming.mutex);
+        if (!ready) {
+            incoming.imported.wait_for(lock, std::chrono::milliseconds(kTimeout), [] { return incoming.dataset < 0; });
+        }
+
+        if (incoming.dataset >= 0) {
+            close(incoming.dataset);
+            incoming.dataset = -1;
+        }
+    }
+#   endif
+
+    closeAll(fds);
+
+    Document ready(kObjectType);
+    ready.AddMember("type", "ready", ready.GetAllocator());
+
+    if (!sendMessage(fd, ready, fds) || !receiveMessage(fd, incoming.state, fds, kStateTimeout) || !isType(incoming.state, "state")) {
+        LOG_ERR("%s " RED("previous miner did not hand over its state"), Tags::miner());
+
+        incoming.state.SetNull();
+        closeAll(fds);
+        close(fd);
+
+        return;
+    }
+
+    // the old miner exits and the daemon installs a pending update only once this arrives
+    Document done(kObjectType);
+    done.AddMember("type", "done", done.GetAllocator());
+    sendMessage(fd, done, std::vector<int>());
+
+    notifyDaemon("active");
+
+    close(fd);
+
+    if (fds.size() == 1 && incoming.state.HasMember("pool")) {
+        incoming.socket = fds[0];
+        fds.clear();
+    }
+
+    closeAll(fds);
+
+    incoming.jobId = Json::getString(incoming.state, "job_id");
+    incoming.nonce = Json::getUint64(incoming.state, "nonce");
+
+    LOG_INFO("%s " GREEN_BOLD("took over from the previous miner") "%s", Tags::miner(), incoming.socket >= 0 ? "" : ", reconnecting to the pool");
+}
+
+
+void xmrig::Handoff::release()
+{
+    if (incoming.socket >= 0) {
+        close(incoming.socket);
+        incoming.socket = -1;
+    }
+}
+
+
+bool xmrig::Handoff::start()
+{
+    const int control = daemonFd();
+    if (control < 0) {
+        return false;
+    }
+
+    m_path = socketPath();
+
+    sockaddr_un addr = {};
+    addr.sun_family  = AF_UNIX;
+
+    if (m_path.size() >= sizeof(addr.sun_path)) {
+        return false;
+    }
+
+    strncpy(addr.sun_path, m_path.c_str(), sizeof(addr.sun_path) - 1);
+    unlink(m_path.c_str());
+
+    m_server = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (m_server < 0 ||
+        bind(m_server, reinterpret_cast<const sockaddr *>(&addr), sizeof(addr)) != 0 ||
+        chmod(m_path.c_str(), S_IRUSR | S_IWUSR) != 0 ||
+        listen(m_server, 1) != 0) {
+        LOG_ERR("%s " RED("handoff listen error: ") RED_BOLD("\"%s\""), Tags::miner(), strerror(errno));
+
+        return false;
+    }
+
+#   ifdef XMRIG_FEATURE_API
+    // the new miner binds the same HTTP API port
+    m_controller->api()->stop();
+#   endif
+
+    const std::string request = "handoff " + std::to_string(getpid()) + " " + m_path + "\n";
+    if (write(control, request.data(), request.size()) != static_cast<ssize_t>(request.size())) {
+        LOG_ERR("%s " RED("daemon is not reachable: ") RED_BOLD("\"%s\""), Tags::miner(), strerror(errno));
+
+        return false;
+    }
+
+    m_poll       = new uv_poll_t;
+    m_poll->data = this;
+    uv_poll_init(uv_default_loop(), m_poll, m_server);
+    uv_poll_start(m_poll, UV_READABLE, onPoll);
+
+    m_timer = new Timer(this);
+    m_timer->singleShot(kTimeout);
+
+    m_active = true;
+
+    LOG_INFO("%s " WHITE_BOLD("waiting for the new miner to take over"), Tags::miner());
+
+    return true;
+}
+
+
+void xmrig::Handoff::onTimer(const Timer *)
+{
+    cancel("timeout");
+}
+
+
+void xmrig::Handoff::exportDataset()
+{
+#   ifdef XMRIG_ALGO_RANDOMX
+    const Job job       = m_controller->miner()->job();
+    RxDataset *dataset  = job.algorithm().family() == Algorithm::RANDOM_X ? Rx::dataset(job, 0) : nullptr;
+
+    if (dataset && dataset->raw()) {
+        // the dataset already lives in an anonymous file, the new miner reads it from there
+        if (dataset->fd() >= 0) {
+            return sendDataset(dup(dataset->fd()), job.algorithm().name(), Cvt::toHex(job.seed()));
+        }
+
+        // otherwise a copy lives in RAM until the new miner has read it into its own dataset, it is made on the
+        // thread pool so the pool connection keeps being served meanwhile
+        if (uv_get_free_memory() > RxDataset::maxSize() * 2) {
+            auto baton = new DatasetBaton(this, job, dataset->raw());
+
+            uv_queue_work(uv_default_loop(), &baton->req,
+                [](uv_work_t *req) {
+                    auto baton = static_cast<DatasetBaton *>(req->data);
+                    baton->fd  = xmrig::exportDataset(baton->raw, RxDataset::maxSize());
+                },
+                [](uv_work_t *req, int) {
+                    auto baton = static_cast<DatasetBaton *>(req->data);
+                    baton->handoff->sendDataset(baton->fd, baton->algo, baton->seed);
+
+                    delete baton;
+                }
+            );
+
+            return;
+        }
+    }
+#   endif
+
+    sendDataset(-1, nullptr, nullptr);
+}
+
+
+void xmrig::Handoff::sendDataset(int fd, const char *algo, const char *seed)
+{
+    using namespace rapidjson;
+    Document doc(kObjectType);
+    auto &allocator = doc.GetAllocator();
+    std::vector<int> fds;
+
+    doc.AddMember("type", "dataset", allocator);
+
+    if (fd >= 0) {
+        fds.push_back(fd);
+
+        doc.AddMember("algo", Value(algo, allocator), allocator);
+        doc.AddMember("seed", Value(seed, allocator), allocator);
+    }
+
+    const bool rc = sendMessage(m_connection, doc, fds);
+    closeAll(fds);
+
+    if (!rc) {
+        return cancel("successor disconnected");
+    }
+
+    m_poll       = new uv_poll_t;
+    m_poll->data = this;
+    uv_poll_init(uv_default_loop(), m_poll, m_connection);
+    uv_poll_start(m_poll, UV_READABLE | UV_DISCONNECT, onPoll);
+}
+
+
+void xmrig::Handoff::cancel(const char *reason)
+{
+    LOG_ERR("%s " RED("handoff failed: ") RED_BOLD("%s") RED(", continuing"), Tags::miner(), reason);
+
+    Handle::close(m_poll);
+    m_poll = nullptr;
+    m_timer->stop();
+
+    if (m_connection >= 0) {
+        close(m_connection);
+        m_connection = -1;
+    }
+
+    if (m_server >= 0) {
+        close(m_server);
+        unlink(m_path.c_str());
+        m_server = -1;
+    }
+
+    // this miner stays in charge, the daemon stops the successor if it is still running
+    notifyDaemon("cancel");
+
+    m_active = false;
+
+    // the HTTP API binds its port again on its own
+    if (m_state == StateSent) {
+        if (m_transferred) {
+            m_controller->network()->connect();
+        }
+        else {
+            const Job job = m_controller->miner()->job();
+            m_controller->miner()->setJob(job, job.index() != 0);
+        }
+    }
+}
+
+
+void xmrig::Handoff::finish()
+{
+    Miner *miner = m_controller->miner();
+    miner->pause();
+
+    using namespace rapidjson;
+    Document doc(kObjectType);
+    auto &allocator = doc.GetAllocator();
+    std::vector<int> fds;
+
+    doc.AddMember("type", "state", allocator);
+
+    const Job job = miner->job();
+    if (job.index() == 0) {
+        doc.AddMember("job_id", job.id().toJSON(doc), allocator);
+        doc.AddMember("nonce", Nonce::value(0), allocator);
+    }
+
+    IStrategy *strategy = m_controller->network()->strategy();
+    IClient *client     = strategy ? strategy->client() : nullptr;
+    Value state(kObjectType);
+
+    const int fd = client ? client->handoff(state, doc) : -1;
+    if (fd >= 0) {
+        fds.push_back(fd);
+        doc.AddMember("pool", state, allocator);
+    }
+
+    m_state       = StateSent;
+    m_transferred = fd >= 0;
+
+    const bool rc = sendMessage(m_connection, doc, fds);
+    closeAll(fds);
+
+    if (!rc) {
+        return cancel("successor disconnected");
+    }
+
+    // this miner exits only when the successor confirms it has taken over
+    m_timer->singleShot(kStateTimeout);
+}
+
+
+void xmrig::Handoff::done()
+{
+    Handle::close(m_poll);
+    m_poll = nullptr;
+    m_timer->stop();
+
+    m_active = false;
+
+    LOG_INFO("%s " GREEN_BOLD("handed over to the new miner") "%s", Tags::miner(), m_transferred ? "" : ", pool connection is not transferable");
+
+    m_callback(RC_OK);
+}
+
+
+void xmrig::Handoff::onAccept()
+{
+    const int fd = accept4(m_server, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+    if (fd < 0) {
+        return;
+    }
+
+    Handle::close(m_poll);
+    close(m_server);
+    unlink(m_path.c_str());
+
+    m_poll       = nullptr;
+    m_server     = -1;
+    m_connection = fd;
+    m_state      = StateDataset;
+
+    exportDataset();
+}
+
+
+void xmrig::Handoff::onRequest()
+{
+    rapidjson::Document doc;
+    std::vector<int> fds;
+
+    const bool rc = receiveMessage(m_connection, doc, fds, 1000);
+    closeAll(fds);
+
+    if (!rc) {
+        return cancel("successor disconnected");
+    }
+
+    if (isType(doc, "ready") && m_state == StateDataset) {
+        finish();
+    }
+    else if (isType(doc, "done") && m_state == StateSent) {
+        done();
+    }
+}
+
+
+void xmrig::Handoff::onPoll(uv_poll_t *handle, int status, int)
+{
+    auto handoff = static_cast<Handoff *>(handle->data);
+
+    if (status < 0) {
+        return handoff->cancel(uv_strerror(status));
+    }
+
+    if (handoff->m_connection < 0) {
+        handoff->onAccept();
+    }
+    else {
+        handoff->onRequest();
+    }
+}
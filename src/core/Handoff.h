@@ -0,0 +1,115 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_HANDOFF_H
+#define XMRIG_HANDOFF_H
+
+
+#include "3rdparty/rapidjson/fwd.h"
+#include "base/kernel/interfaces/ITimerListener.h"
+#include "base/tools/Object.h"
+
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+
+using uv_poll_t = struct uv_poll_s;
+
+
+namespace xmrig {
+
+
+class Controller;
+class Job;
+class RxSeed;
+class Timer;
+
+
+/**
+ * Zero-downtime restart of a miner started by XMRigd.
+ *
+ * The running miner asks the daemon for a successor and listens on a Unix socket. The successor connects during
+ * startup and first receives the RandomX dataset as a memfd, while the old miner keeps hashing. The dataset of a miner
+ * started by XMRigd is allocated in a memfd from the start, so it is passed without a copy. Once the dataset is
+ * imported it asks for the rest: the old miner pauses and passes its connected pool socket with the login, job and
+ * nonce state via SCM_RIGHTS. The successor adopts the socket without a new login and confirms, only then the old
+ * miner exits. If anything fails before that, the old miner resumes and stays in charge.
+ */
+class Handoff : public ITimerListener
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(Handoff)
+
+    using Callback = std::function<void(int rc)>;
+
+    constexpr static uint64_t kTimeout = 120 * 1000;
+
+    Handoff(Controller *controller, Callback callback);
+    ~Handoff() override;
+
+    static bool importDataset(const RxSeed &seed, void *raw, size_t size);
+    static bool isAvailable();
+    static int socket(const char *url, const rapidjson::Value **state);
+    static uint64_t nonce(const Job &job);
+    static void receive(Controller *controller);
+    static void release();
+
+    inline bool isActive() const { return m_active; }
+
+    bool start();
+
+protected:
+    void onTimer(const Timer *timer) override;
+
+private:
+    enum State {
+        StateListen,
+        StateDataset,
+        StateSent
+    };
+
+    void cancel(const char *reason);
+    void done();
+    void exportDataset();
+    void sendDataset(int fd, const char *algo, const char *seed);
+    void finish();
+    void onAccept();
+    void onRequest();
+
+    static void onPoll(uv_poll_t *handle, int status, int events);
+
+    bool m_active       = false;
+    bool m_transferred  = false;
+    Callback m_callback;
+    Controller *m_controller;
+    int m_connection    = -1;
+    int m_server        = -1;
+    std::string m_path;
+    State m_state       = StateListen;
+    Timer *m_timer      = nullptr;
+    uv_poll_t *m_poll   = nullptr;
+};
+
+
+} // namespace xmrig
+
+
+#endif /* XMRIG_HANDOFF_H */
@@ -17,6 +17,7 @@
  */
 
 #include <algorithm>
+#include <memory>
 #include <mutex>
 #include <thread>
 
@@ -46,11 +47,23 @@
 
 
 #ifdef XMRIG_FEATURE_CC_CLIENT
+#   include "base/kernel/ResourceLimits.h"
 #   include "cc/CCClient.h"
 #   include "crypto/common/VirtualMemory.h"
 #endif
 
 
+#ifdef XMRIG_FEATURE_HANDOFF
+#   include "core/Handoff.h"
+#endif
+
+
+#if defined(XMRIG_FEATURE_OPENCL) || defined(XMRIG_FEATURE_CUDA)
+#   include "backend/common/GpuHostCores.h"
+#   include "base/tools/Chrono.h"
+#endif
+
+
 #ifdef XMRIG_FEATURE_OPENCL
 #   include "backend/opencl/OclBackend.h"
 #endif
@@ -120,6 +133,74 @@ public:
     }
 
 
+    // Workers pick up the current job without taking the global mutex, each backend gets its own
+    // immutable copy so the backend id does not need to be patched in by every worker.
+    inline void publishJob()
+    {
+        for (uint32_t backend = Nonce::CPU; backend < Nonce::MAX; ++backend) {
+            auto snapshot = std::make_shared<Job>(job);
+            snapshot->setBackend(backend);
+
+            std::atomic_store(&snapshots[backend], std::shared_ptr<const Job>(std::move(snapshot)));
+        }
+    }
+
+
+    // With several pools mined in turn the same user job can come back, keep its nonce position so the
+    // workers continue where they stopped instead of hashing the same nonces again.
+    inline void park()
+    {
+        if (job.index() != 0 || !job.isValid()) {
+            return;
+        }
+
+        if (parked.size() == kMaxParked) {
+            parked.erase(parked.begin());
+        }
+
+        parked.emplace_back(job, Nonce::value(0));
+    }
+
+
+    inline uint64_t resume()
+    {
+        if (job.index() == 0) {
+            for (auto it = parked.begin(); it != parked.end(); ++it) {
+                if (it->first.clientId() == job.clientId() && it->first.isEqualBlob(job)) {
+                    const uint64_t nonce = it->second;
+                    parked.erase(it);
+
+                    return nonce;
+                }
+            }
+        }
+
+#       ifdef XMRIG_FEATURE_HANDOFF
+        return Handoff::nonce(job);
+#       else
+        return 0;
+#       endif
+    }
+
+
+    // The CPU backend reserves the host cores of the GPU backends (GpuHostCores) while it builds its threads,
+    // so it always gets the job first and the OpenCL and CUDA backends pin their host threads to those cores.
+    inline void setJob(const Job &job)
+    {
+        for (IBackend *backend : backends) {
+            if (backend->type() == "cpu") {
+                backend->setJob(job);
+            }
+        }
+
+        for (IBackend *backend : backends) {
+            if (backend->type() != "cpu") {
+                backend->setJob(job);
+            }
+        }
+    }
+
+
     inline void handleJobChange()
     {
         if (!enabled) {
@@ -127,12 +208,10 @@ public:
         }
 
         if (reset) {
-            Nonce::reset(job.index());
+            Nonce::reset(job.index(), resume());
         }
 
-        for (IBackend *backend : backends) {
-            backend->setJob(job);
-        }
+        setJob(job);
 
         Nonce::touch();
 
@@ -363,6 +442,8 @@ public:
     bool reset          = true;
     Controller *controller;
     Job job;
+    std::vector<std::pair<Job, uint64_t>> parked;
+    std::shared_ptr<const Job> snapshots[Nonce::MAX];
     mutable std::map<Algorithm::Id, double> maxHashrate;
     std::vector<IBackend *> backends;
     String userJobId;
@@ -370,6 +451,8 @@ public:
     uint64_t ticks      = 0;
 
     Taskbar m_taskbar;
+
+    constexpr static size_t kMaxParked = 8;
 };
 
 
@@ -459,6 +542,12 @@ xmrig::Job xmrig::Miner::job() const
 }
 
 
+std::shared_ptr<const xmrig::Job> xmrig::Miner::jobSnapshot(Nonce::Backend backend) const
+{
+    return std::atomic_load(&d_ptr->snapshots[backend]);
+}
+
+
 void xmrig::Miner::execCommand(char command)
 {
     switch (command) {
@@ -577,6 +666,10 @@ void xmrig::Miner::setJob(const Job &job, bool donate)
         d_ptr->reset = false;
     }
 
+    if (d_ptr->reset) {
+        d_ptr->park();
+    }
+
     d_ptr->job   = job;
     d_ptr->job.setIndex(index);
     d_ptr->job.setDonate(donate);
@@ -585,6 +678,8 @@ void xmrig::Miner::setJob(const Job &job, bool donate)
         d_ptr->userJobId = job.id();
     }
 
+    d_ptr->publishJob();
+
 #   ifdef XMRIG_ALGO_RANDOMX
     const bool ready = d_ptr->initRX();
 #   else
@@ -626,11 +721,7 @@ void xmrig::Miner::onConfigChanged(Config *config, Config *previousConfig)
         return;
     }
 
-    const Job job = this->job();
-
-    for (IBackend *backend : d_ptr->backends) {
-        backend->setJob(job);
-    }
+    d_ptr->setJob(this->job());
 }
 
 
@@ -665,6 +756,12 @@ void xmrig::Miner::onTimer(const Timer *)
 
     d_ptr->ticks++;
 
+#   if defined(XMRIG_FEATURE_OPENCL) || defined(XMRIG_FEATURE_CUDA)
+    if (d_ptr->active && GpuHostCores::tick(this, d_ptr->algorithm, config->cpu().gpuReserve(), d_ptr->enabled, Chrono::steadyMSecs())) {
+        d_ptr->setJob(this->job());
+    }
+#   endif
+
     auto autoPause = [this](bool &state, bool pause, const char *pauseMessage, const char *activeMessage)
     {
         if ((pause && !state) || (!pause && state)) {
@@ -750,6 +847,7 @@ void xmrig::Miner::onUpdateRequest(ClientStatus& clientStatus)
     if (!d_ptr->job.isDonate()) {
 
         clientStatus.clearGPUInfoList();
+        clientStatus.clearThermalInfoList();
 
         double t[3] = { 0.0 };
         int ways = {0};
@@ -774,6 +872,21 @@ void xmrig::Miner::onUpdateRequest(ClientStatus& clientStatus)
 
                 ways += cpuBackend->ways();
 
+                clientStatus.setCpuPower(cpuBackend->power());
+                clientStatus.setHashesPerJoule(cpuBackend->hashesPerJoule());
+                clientStatus.setCpuTemperature(cpuBackend->temperature());
+
+                for (const auto &zone : cpuBackend->thermalZones()) {
+                    ThermalInfo thermalInfo;
+                    thermalInfo.setName(zone.name.data());
+                    thermalInfo.setPackage(zone.package);
+                    thermalInfo.setTemperature(zone.temperature);
+                    thermalInfo.setDuty(zone.duty);
+                    thermalInfo.setThreads(static_cast<uint32_t>(zone.threads));
+
+                    clientStatus.addThermalInfo(thermalInfo);
+                }
+
                 HugePagesInfo pages = cpuBackend->hugePages();
 
 #   ifdef XMRIG_ALGO_RANDOMX
@@ -833,6 +946,8 @@ void xmrig::Miner::onUpdateRequest(ClientStatus& clientStatus)
             }
         }
 
+        const uint64_t hugePagesLimit = ResourceLimits::hugePages(VirtualMemory::hugePageSize());
+
         clientStatus.setTotalPages(totalPages);
         clientStatus.setTotalHugepages(totalHugepages);
         clientStatus.setHugepagesEnabled(totalHugepages>0);
@@ -841,6 +956,11 @@ void xmrig::Miner::onUpdateRequest(ClientStatus& clientStatus)
         clientStatus.setCurrentWays(ways);
         clientStatus.setTotalMemory(uv_get_total_memory());
         clientStatus.setFreeMemory(uv_get_free_memory());
+        clientStatus.setCgroupVersion(ResourceLimits::version());
+        clientStatus.setCgroupCpus(ResourceLimits::cpus());
+        clientStatus.setCgroupCpuset(ResourceLimits::cpusetToString().data());
+        clientStatus.setCgroupMemory(ResourceLimits::memory() < uv_get_total_memory() ? ResourceLimits::memory() : 0);
+        clientStatus.setCgroupHugepages(hugePagesLimit != ResourceLimits::kUnlimited ? static_cast<int64_t>(hugePagesLimit) : -1);
         clientStatus.setMaxCpuUsage(d_ptr->controller->config()->cpu().maxCpuUsage());
         clientStatus.setHashFactor(threads > 0 ? ways/threads : 0);
         clientStatus.setHashrateShort(t[0]);
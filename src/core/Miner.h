@@ -20,6 +20,7 @@
 #define XMRIG_MINER_H
 
 
+#include <memory>
 #include <vector>
 
 
@@ -30,6 +31,7 @@
 #include "base/kernel/interfaces/ITimerListener.h"
 #include "base/cc/interfaces/IClientStatusListener.h"
 #include "base/tools/Object.h"
+#include "crypto/common/Nonce.h"
 
 
 namespace xmrig {
@@ -54,6 +56,7 @@ public:
     const Algorithms &algorithms() const;
     const std::vector<IBackend *> &backends() const;
     Job job() const;
+    std::shared_ptr<const Job> jobSnapshot(Nonce::Backend backend) const;
     void execCommand(char command);
     void pause();
     void setEnabled(bool enabled);
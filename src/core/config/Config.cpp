@@ -27,7 +27,9 @@
 #include "backend/cpu/Cpu.h"
 #include "base/io/log/Log.h"
 #include "base/kernel/interfaces/IJsonReader.h"
+#include "base/kernel/ResourceLimits.h"
 #include "base/net/dns/Dns.h"
+#include "base/net/stratum/Recorder.h"
 #include "crypto/common/Assembly.h"
 
 
@@ -304,6 +306,8 @@ void xmrig::Config::getJSON(rapidjson::Document &doc) const
 #   endif
 
     doc.AddMember(StringRef(DnsConfig::kField),         Dns::config().toJSON(doc), allocator);
+    doc.AddMember(StringRef(ResourceLimits::kCgroupRoot), ResourceLimits::root().toJSON(), allocator);
+    doc.AddMember(StringRef(Recorder::kField),          Recorder::fileName().toJSON(), allocator);
     doc.AddMember(StringRef(kUserAgent),                m_userAgent.toJSON(), allocator);
     doc.AddMember(StringRef(kVerbose),                  Log::verbose(), allocator);
     doc.AddMember(StringRef(kWatch),                    m_watch, allocator);
@@ -53,7 +53,8 @@ R"===(
         "wrmsr": true,
         "cache_qos": false,
         "numa": true,
-        "scratchpad_prefetch_mode": 1
+        "scratchpad_prefetch_mode": 1,
+        "vm-bench": false
     },
     "cpu": {
         "enabled": true,
@@ -63,9 +64,17 @@ R"===(
         "priority": null,
         "memory-pool": false,
         "yield": true,
+        "scratchpad-placement": false,
+        "numa-shards": false,
+        "efficiency-mode": false,
         "force-autoconfig": false,
         "max-threads-hint": 100,
         "max-cpu-usage": null,
+        "gpu-reserve": true,
+        "e-cores": null,
+        "thermal-target": null,
+        "thermal-hysteresis": 3,
+        "thermal-sysfs": null,
         "asm": true,
         "argon2-impl": null,
         "cn/0": false,
@@ -74,6 +83,8 @@ R"===(
     "opencl": {
         "enabled": false,
         "cache": true,
+        "cache-size": 256,
+        "cache-prebuild": false,
         "loader": null,
         "platform": "AMD",
         "adl": true,
@@ -100,6 +111,9 @@ R"===(
             "rig-id": null,
             "nicehash": false,
             "keepalive": false,
+            "submit-diff": 0,
+            "weight": 0,
+            "share-buffer": 0,
             "enabled": true,
             "tls": false,
             "tls-fingerprint": null,
@@ -140,6 +154,8 @@ R"===(
         "ciphersuites": null,
         "dhparam": null
     },
+    "cgroup-root": null,
+    "stratum-record": null,
     "user-agent": null,
     "verbose": 0,
     "watch": true,
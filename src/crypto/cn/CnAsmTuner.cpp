@@ -0,0 +1,427 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "crypto/cn/CnAsmTuner.h"
+#include "3rdparty/rapidjson/document.h"
+#include "backend/cpu/Cpu.h"
+#include "backend/cpu/CpuLaunchData.h"
+#include "base/crypto/Algorithm.h"
+#include "base/io/json/Json.h"
+#include "base/io/log/Log.h"
+#include "base/io/log/Tags.h"
+#include "base/kernel/Process.h"
+#include "base/tools/Chrono.h"
+#include "crypto/cn/CnCtx.h"
+#include "crypto/cn/CnHash.h"
+#include "crypto/common/VirtualMemory.h"
+
+
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+
+namespace xmrig {
+
+
+static const char *kFileName    = "asm-tune.json";
+static const char *kAsm         = "asm";
+static const char *kBrand       = "brand";
+static const char *kHashrate    = "hashrate";
+static const char *kMicrocode   = "microcode";
+
+constexpr uint64_t kDuration    = 250;
+constexpr uint32_t kMinHashes   = 8;
+
+static const Assembly::Id variants[] = { Assembly::NONE, Assembly::INTEL, Assembly::RYZEN, Assembly::BULLDOZER };
+
+
+struct TuneResult
+{
+    Assembly::Id assembly       = Assembly::AUTO;
+    double hashrate[Assembly::MAX]{};
+    bool reported               = false;
+};
+
+
+static bool loaded = false;
+static std::map<uint64_t, TuneResult> results;
+static std::mutex mutex;         // guards the results, only held for lookups
+static std::mutex tuneMutex;     // serializes benchmarks, other workers wait instead of disturbing the measurement
+
+
+static const CnHash::AlgoVariant avs[] = {
+    CnHash::AV_SINGLE, CnHash::AV_DOUBLE, CnHash::AV_TRIPLE, CnHash::AV_QUAD, CnHash::AV_PENTA,
+    CnHash::AV_SINGLE_SOFT, CnHash::AV_DOUBLE_SOFT, CnHash::AV_TRIPLE_SOFT, CnHash::AV_QUAD_SOFT, CnHash::AV_PENTA_SOFT
+};
+
+
+static inline uint64_t key(uint32_t family, CnHash::AlgoVariant av) { return (static_cast<uint64_t>(family) << 8) | av; }
+
+
+static size_t ways(CnHash::AlgoVariant av)
+{
+    switch (av) {
+    case CnHash::AV_DOUBLE:
+    case CnHash::AV_DOUBLE_SOFT:
+        return 2;
+
+    case CnHash::AV_TRIPLE:
+    case CnHash::AV_TRIPLE_SOFT:
+        return 3;
+
+    case CnHash::AV_QUAD:
+    case CnHash::AV_QUAD_SOFT:
+        return 4;
+
+    case CnHash::AV_PENTA:
+    case CnHash::AV_PENTA_SOFT:
+        return 5;
+
+    default:
+        break;
+    }
+
+    return 1;
+}
+
+
+static std::string avName(CnHash::AlgoVariant av)
+{
+    const bool soft = av == CnHash::AV_SINGLE_SOFT || av == CnHash::AV_DOUBLE_SOFT || av >= CnHash::AV_TRIPLE_SOFT;
+
+    return std::to_string(ways(av)) + (soft ? "-soft" : "");
+}
+
+
+static const char *familyName(uint32_t family)
+{
+    switch (family) {
+    case Algorithm::CN:
+        return "cn";
+
+    case Algorithm::CN_LITE:
+        return "cn-lite";
+
+    case Algorithm::CN_HEAVY:
+        return "cn-heavy";
+
+    case Algorithm::CN_PICO:
+        return "cn-pico";
+
+    case Algorithm::CN_FEMTO:
+        return "cn-femto";
+
+    default:
+        break;
+    }
+
+    return nullptr;
+}
+
+
+static std::string microcode()
+{
+    std::string revision;
+
+#   ifdef __linux__
+    FILE *fp = fopen("/proc/cpuinfo", "r");
+    if (!fp) {
+        return revision;
+    }
+
+    char buf[256];
+    while (fgets(buf, sizeof(buf), fp) != nullptr) {
+        if (strncmp(buf, "microcode", 9) != 0) {
+            continue;
+        }
+
+        const char *value = strchr(buf, ':');
+        if (value) {
+            revision = value + 1;
+            revision.erase(0, revision.find_first_not_of(" \t"));
+            revision.erase(revision.find_last_not_of(" \t\r\n") + 1);
+        }
+
+        break;
+    }
+
+    fclose(fp);
+#   endif
+
+    return revision;
+}
+
+
+static void load()
+{
+    if (loaded) {
+        return;
+    }
+
+    loaded = true;
+
+    rapidjson::Document doc;
+    if (!Json::get(Process::location(Process::DataLocation, kFileName), doc) || !doc.IsObject()) {
+        return;
+    }
+
+    if (strcmp(Json::getString(doc, kBrand, ""), Cpu::info()->brand()) != 0 || microcode() != Json::getString(doc, kMicrocode, "")) {
+        LOG_INFO("%s" MAGENTA_BOLD("asm-tune") " CPU or microcode changed, previous results discarded", Tags::cpu());
+
+        return;
+    }
+
+    for (const uint32_t family : { Algorithm::CN, Algorithm::CN_LITE, Algorithm::CN_HEAVY, Algorithm::CN_PICO, Algorithm::CN_FEMTO }) {
+        const auto &object = Json::getObject(doc, familyName(family));
+
+        for (const auto av : avs) {
+            const auto &value = Json::getObject(object, avName(av).c_str());
+            if (!value.IsObject()) {
+                continue;
+            }
+
+            TuneResult result;
+            result.assembly = Assembly::parse(Json::getString(value, kAsm), Assembly::AUTO);
+
+            if (result.assembly == Assembly::AUTO || result.assembly == Assembly::TUNE) {
+                continue;
+            }
+
+            const auto &hashrate = Json::getObject(value, kHashrate);
+            for (const auto id : variants) {
+                result.hashrate[id] = Json::getDouble(hashrate, Assembly(id).toString());
+            }
+
+            results[key(family, av)] = result;
+        }
+    }
+}
+
+
+static void save()
+{
+    using namespace rapidjson;
+
+    Document doc(kObjectType);
+    auto &allocator = doc.GetAllocator();
+
+    doc.AddMember(StringRef(kBrand),     Value(Cpu::info()->brand(), allocator), allocator);
+    doc.AddMember(StringRef(kMicrocode), Value(microcode().c_str(), allocator), allocator);
+
+    for (const auto &kv : results) {
+        const char *family = familyName(static_cast<uint32_t>(kv.first >> 8));
+        if (!family) {
+            continue;
+        }
+
+        Value hashrate(kObjectType);
+        for (const auto id : variants) {
+            hashrate.AddMember(StringRef(Assembly(id).toString()), Json::normalize(kv.second.hashrate[id], true), allocator);
+        }
+
+        Value value(kObjectType);
+        value.AddMember(StringRef(kAsm),      StringRef(Assembly(kv.second.assembly).toString()), allocator);
+        value.AddMember(StringRef(kHashrate), hashrate, allocator);
+
+        if (!doc.HasMember(family)) {
+            doc.AddMember(StringRef(family), Value(kObjectType), allocator);
+        }
+
+        doc[family].AddMember(Value(avName(static_cast<CnHash::AlgoVariant>(kv.first & 0xff)).c_str(), allocator), value, allocator);
+    }
+
+    const std::string fileName = Process::location(Process::DataLocation, kFileName).data();
+    const std::string tmp      = fileName + ".tmp";
+
+    if (!Json::save(tmp.c_str(), doc)) {
+        return;
+    }
+
+    if (std::rename(tmp.c_str(), fileName.c_str()) != 0) {
+        std::remove(fileName.c_str());
+        std::rename(tmp.c_str(), fileName.c_str());
+    }
+}
+
+
+static double measure(cn_hash_fun fn, cryptonight_ctx **ctx, size_t ways)
+{
+    constexpr size_t kBlobSize = 76;
+
+    alignas(16) uint8_t blob[kBlobSize * CnAsmTuner::kMaxWays]{};
+    uint8_t hash[32 * CnAsmTuner::kMaxWays];
+    uint32_t nonce = 0;
+    uint32_t count = 0;
+
+    // warm up, touches the scratchpad and builds the cn/r code for this height
+    fn(blob, kBlobSize, hash, ctx, 0);
+
+    const uint64_t start = Chrono::highResolutionMicroSecs();
+    uint64_t elapsed     = 0;
+
+    do {
+        for (size_t i = 0; i < ways; ++i) {
+            memcpy(blob + i * kBlobSize + 39, &++nonce, sizeof(nonce));
+        }
+
+        fn(blob, kBlobSize, hash, ctx, 0);
+
+        ++count;
+        elapsed = Chrono::highResolutionMicroSecs() - start;
+    } while (count < kMinHashes || elapsed < kDuration * 1000);
+
+    return count * ways * 1e6 / static_cast<double>(elapsed);
+}
+
+
+static bool tune(const Algorithm &algorithm, CnHash::AlgoVariant av, TuneResult &result)
+{
+    const size_t count = ways(av);
+
+    cn_hash_fun fn[Assembly::MAX]{};
+    bool found = false;
+
+    for (const auto id : variants) {
+        fn[id] = CnHash::fn(algorithm, av, id);
+        found  = found || fn[id] != fn[Assembly::NONE];
+    }
+
+    // nothing to choose from, all variants use the same code
+    if (!found || !fn[Assembly::NONE]) {
+        return false;
+    }
+
+    VirtualMemory memory(algorithm.l3() * count, true, false, false);
+    cryptonight_ctx *ctx[CnAsmTuner::kMaxWays] = { nullptr };
+    CnCtx::create(ctx, memory.scratchpad(), algorithm.l3(), count);
+
+    result.assembly = Assembly::NONE;
+
+    for (const auto id : variants) {
+        double hashrate = 0.0;
+
+        for (const auto prev : variants) {
+            if (prev == id) {
+                hashrate = measure(fn[id], ctx, count);
+                break;
+            }
+
+            if (fn[prev] == fn[id]) {
+                hashrate = result.hashrate[prev];
+                break;
+            }
+        }
+
+        result.hashrate[id] = hashrate;
+
+        if (hashrate > result.hashrate[result.assembly]) {
+            result.assembly = id;
+        }
+    }
+
+    CnCtx::release(ctx, count);
+
+    return true;
+}
+
+
+static void print(const std::string &name, const TuneResult &result, bool cached)
+{
+    char buf[256] = { 0 };
+    size_t size   = 0;
+
+    for (const auto id : variants) {
+        size += snprintf(buf + size, sizeof(buf) - size, " %s " CYAN_BOLD("%.1f H/s"), Assembly(id).toString(), result.hashrate[id]);
+    }
+
+    LOG_INFO("%s" MAGENTA_BOLD("asm-tune") WHITE_BOLD(" %-13s") "%s " GREEN_BOLD("-> %s") BLACK_BOLD("%s"),
+             Tags::cpu(),
+             name.c_str(),
+             buf,
+             Assembly(result.assembly).toString(),
+             cached ? " (cached)" : ""
+             );
+}
+
+
+} // namespace xmrig
+
+
+xmrig::Assembly::Id xmrig::CnAsmTuner::assembly(const CpuLaunchData &data)
+{
+    const uint32_t family = data.algorithm.family();
+    const auto av         = data.av();
+
+    if (!familyName(family)) {
+        return Cpu::info()->assembly();
+    }
+
+    const std::string name = std::string(familyName(family)) + " x" + avName(av);
+
+    std::lock_guard<std::mutex> tuneLock(tuneMutex);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        load();
+
+        auto it = results.find(key(family, av));
+        if (it != results.end()) {
+            if (!it->second.reported) {
+                print(name, it->second, true);
+                it->second.reported = true;
+            }
+
+            return it->second.assembly;
+        }
+    }
+
+    TuneResult result;
+    if (!tune(data.algorithm, av, result)) {
+        return Cpu::info()->assembly();
+    }
+
+    result.reported = true;
+    print(name, result, false);
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    results[key(family, av)] = result;
+    save();
+
+    return result.assembly;
+}
+
+
+xmrig::Assembly::Id xmrig::CnAsmTuner::cached(const CpuLaunchData &data)
+{
+    const uint32_t family = data.algorithm.family();
+    if (!familyName(family)) {
+        return Cpu::info()->assembly();
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    const auto it = results.find(key(family, data.av()));
+
+    return it != results.end() ? it->second.assembly : Assembly::TUNE;
+}
@@ -0,0 +1,52 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_CN_ASMTUNER_H
+#define XMRIG_CN_ASMTUNER_H
+
+
+#include "crypto/common/Assembly.h"
+
+
+namespace xmrig
+{
+
+
+class CpuLaunchData;
+
+
+/**
+ * Resolves "asm": "tune" for CryptoNight algorithms. At first use of an algorithm family and hash variant (intensity
+ * and soft AES) every compiled-in asm variant is benchmarked for a short time on the calling worker thread, the
+ * fastest one wins. Results are persisted in "asm-tune.json" in the data directory and reused while the CPU brand and
+ * microcode revision stay the same.
+ */
+class CnAsmTuner
+{
+public:
+    constexpr static size_t kMaxWays = 5;
+
+    static Assembly::Id assembly(const CpuLaunchData &data);    // benchmarks on first use, worker threads only
+    static Assembly::Id cached(const CpuLaunchData &data);      // Assembly::TUNE until the variant was measured
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_CN_ASMTUNER_H */
@@ -38,7 +38,8 @@ static const char *asmNames[] = {
     "auto",
     "intel",
     "ryzen",
-    "bulldozer"
+    "bulldozer",
+    "tune"
 };
 
 
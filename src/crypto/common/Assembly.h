@@ -35,6 +35,7 @@ public:
         INTEL,
         RYZEN,
         BULLDOZER,
+        TUNE,
         MAX
     };
 
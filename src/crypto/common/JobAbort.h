@@ -0,0 +1,56 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_JOBABORT_H
+#define XMRIG_JOBABORT_H
+
+
+#include <atomic>
+
+
+namespace xmrig {
+
+
+/**
+ * Cooperative early abort for long CPU hashes.
+ *
+ * Every CPU worker thread attaches its own flag, which the backend raises from jobEarlyNotification() as soon as
+ * a new job is announced. Hash implementations poll isRequested() at points where they can stop without leaving
+ * shared state behind (between RandomX programs, between GhostRider parts) and report an incomplete hash.
+ * Threads without an attached flag (self test, benchmarks, helpers) never abort.
+ */
+class JobAbort
+{
+public:
+    static inline void attach(const std::atomic<bool> *flag)    { current() = flag; }
+    static inline bool isRequested()                            { const std::atomic<bool> *flag = current(); return flag && flag->load(std::memory_order_relaxed); }
+
+private:
+    static inline const std::atomic<bool> *&current()
+    {
+        static thread_local const std::atomic<bool> *flag = nullptr;
+
+        return flag;
+    }
+};
+
+
+} // namespace xmrig
+
+
+#endif /* XMRIG_JOBABORT_H */
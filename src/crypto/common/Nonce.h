@@ -39,9 +39,11 @@ public:
 
     static inline bool isOutdated(Backend backend, uint64_t sequence)   { return m_sequence[backend].load(std::memory_order_relaxed) != sequence; }
     static inline bool isPaused()                                       { return m_paused.load(std::memory_order_relaxed); }
+    static inline uint64_t generation(uint8_t index)                    { return m_generations[index].load(std::memory_order_acquire); }
     static inline uint64_t sequence(Backend backend)                    { return m_sequence[backend].load(std::memory_order_relaxed); }
+    static inline uint64_t value(uint8_t index)                         { return m_nonces[index].load(std::memory_order_relaxed); }
     static inline void pause(bool paused)                               { m_paused = paused; }
-    static inline void reset(uint8_t index)                             { m_nonces[index] = 0; }
+    static inline void reset(uint8_t index, uint64_t value = 0)         { m_nonces[index] = value; m_generations[index]++; }
     static inline void stop(Backend backend)                            { m_sequence[backend] = 0; }
     static inline void touch(Backend backend)                           { m_sequence[backend]++; }
 
@@ -52,6 +54,7 @@ public:
 private:
     static std::atomic<bool> m_paused;
     static std::atomic<uint64_t> m_sequence[MAX];
+    static std::atomic<uint64_t> m_generations[2];
     static std::atomic<uint64_t> m_nonces[2];
 };
 
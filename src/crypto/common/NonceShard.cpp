@@ -0,0 +1,71 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "crypto/common/NonceShard.h"
+#include "base/tools/Alignment.h"
+
+
+#include <algorithm>
+
+
+bool xmrig::NonceShard::next(uint8_t index, uint32_t *nonce, uint32_t reserveCount, uint64_t mask)
+{
+    mask &= 0x7FFFFFFFFFFFFFFFULL;
+
+    if (reserveCount == 0 || mask < reserveCount - 1) {
+        return Nonce::next(index, nonce, reserveCount, mask);
+    }
+
+    const uint64_t rounds = std::min<uint64_t>(kLeaseRounds, (mask / reserveCount + 1) / kLeaseRounds);
+    const uint64_t size   = rounds * reserveCount;
+    if (rounds < 2 || size > 0xFFFFFFFFULL) {
+        return Nonce::next(index, nonce, reserveCount, mask);
+    }
+
+    // must be read before the global counter, a lease taken across a reset keeps the old generation and is dropped
+    // by the next call
+    const uint64_t generation = Nonce::generation(index);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    Lease &lease = m_leases[index];
+    if (lease.mask != mask || lease.generation != generation || lease.end - lease.next < reserveCount) {
+        uint32_t counter[2] = { 0, 0 };
+        if (!Nonce::next(index, counter, static_cast<uint32_t>(size), mask)) {
+            lease = Lease();
+
+            return Nonce::next(index, nonce, reserveCount, mask);
+        }
+
+        lease.next       = (static_cast<uint64_t>(counter[1]) << 32 | counter[0]) & mask;
+        lease.end        = lease.next + size;
+        lease.generation = generation;
+        lease.mask       = mask;
+    }
+
+    const uint64_t value = lease.next;
+    lease.next += reserveCount;
+
+    writeUnaligned(nonce, static_cast<uint32_t>((readUnaligned(nonce) & ~mask) | value));
+
+    if (mask > 0xFFFFFFFFULL) {
+        writeUnaligned(nonce + 1, static_cast<uint32_t>((readUnaligned(nonce + 1) & (~mask >> 32)) | (value >> 32)));
+    }
+
+    return true;
+}
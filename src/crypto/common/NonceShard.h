@@ -0,0 +1,67 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_NONCESHARD_H
+#define XMRIG_NONCESHARD_H
+
+
+#include <mutex>
+
+
+#include "crypto/common/Nonce.h"
+
+
+namespace xmrig {
+
+
+/**
+ * Node local nonce allocator.
+ *
+ * Reserves large ranges from the global Nonce counter and hands them out to the threads of one NUMA node
+ * in smaller pieces, so the shared counter cache line is touched once per lease instead of once per round.
+ * A lease is dropped only when the counter is reset for a new blob, pauses and same blob updates keep it,
+ * and it never takes more than 1/64 of the nonce space, so small nicehash masks are not burned.
+ */
+class alignas(64) NonceShard
+{
+public:
+    constexpr static uint32_t kLeaseRounds = 64;
+
+    inline NonceShard(Nonce::Backend backend) : m_backend(backend) {}
+
+    bool next(uint8_t index, uint32_t *nonce, uint32_t reserveCount, uint64_t mask);
+
+private:
+    struct Lease
+    {
+        uint64_t next       = 0;
+        uint64_t end        = 0;
+        uint64_t generation = 0;
+        uint64_t mask       = 0;
+    };
+
+    const Nonce::Backend m_backend;
+    Lease m_leases[2];
+    std::mutex m_mutex;
+};
+
+
+} // namespace xmrig
+
+
+#endif /* XMRIG_NONCESHARD_H */
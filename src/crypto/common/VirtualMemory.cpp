@@ -45,7 +45,7 @@ static std::mutex mutex;
 } // namespace xmrig
 
 
-xmrig::VirtualMemory::VirtualMemory(size_t size, bool hugePages, bool oneGbPages, bool usePool, uint32_t node, size_t alignSize) :
+xmrig::VirtualMemory::VirtualMemory(size_t size, bool hugePages, bool oneGbPages, bool usePool, uint32_t node, size_t alignSize, bool shared) :
     m_size(alignToHugePageSize(size)),
     m_node(node),
     m_capacity(m_size)
@@ -70,6 +70,11 @@ xmrig::VirtualMemory::VirtualMemory(size_t size, bool hugePages, bool oneGbPages
         return;
     }
 
+    // huge pages take priority over sharing, without them the shared allocation uses regular pages
+    if (shared && allocateSharedMemory(hugePages)) {
+        return;
+    }
+
     if (hugePages && allocateLargePagesMemory()) {
         return;
     }
@@ -88,6 +93,9 @@ xmrig::VirtualMemory::~VirtualMemory()
         std::lock_guard<std::mutex> lock(mutex);
         pool->release(m_node);
     }
+    else if (m_flags.test(FLAG_SHARED)) {
+        freeSharedMemory();
+    }
     else if (isHugePages() || isOneGbPages()) {
         freeLargePagesMemory();
     }
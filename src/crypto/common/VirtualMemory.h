@@ -42,11 +42,12 @@ public:
     constexpr static size_t kDefaultHugePageSize    = 2U * 1024U * 1024U;
     constexpr static size_t kOneGiB                 = 1024U * 1024U * 1024U;
 
-    VirtualMemory(size_t size, bool hugePages, bool oneGbPages, bool usePool, uint32_t node = 0, size_t alignSize = 64);
+    VirtualMemory(size_t size, bool hugePages, bool oneGbPages, bool usePool, uint32_t node = 0, size_t alignSize = 64, bool shared = false);
     ~VirtualMemory();
 
     inline bool isHugePages() const                                 { return m_flags.test(FLAG_HUGEPAGES); }
     inline bool isOneGbPages() const                                { return m_flags.test(FLAG_1GB_PAGES); }
+    inline int fd() const                                           { return m_fd; }
     inline size_t size() const                                      { return m_size; }
     inline size_t capacity() const                                  { return m_capacity; }
     inline uint8_t *raw() const                                     { return m_scratchpad; }
@@ -62,11 +63,13 @@ public:
     static bool protectRWX(void *p, size_t size);
     static bool protectRX(void *p, size_t size);
     static uint32_t bindToNUMANode(int64_t affinity);
+    static void *allocateDualMappedMemory(size_t size, void **exec);
     static void *allocateExecutableMemory(size_t size, bool hugePages);
     static void *allocateLargePagesMemory(size_t size);
     static void *allocateOneGbPagesMemory(size_t size);
     static void destroy();
     static void flushInstructionCache(void *p, size_t size);
+    static void freeDualMappedMemory(void *p, void *exec, size_t size);
     static void freeLargePagesMemory(void *p, size_t size);
     static void init(size_t poolSize, size_t hugePageSize);
 
@@ -80,6 +83,7 @@ private:
         FLAG_1GB_PAGES,
         FLAG_LOCK,
         FLAG_EXTERNAL,
+        FLAG_SHARED,
         FLAG_MAX
     };
 
@@ -87,7 +91,9 @@ private:
 
     bool allocateLargePagesMemory();
     bool allocateOneGbPagesMemory();
+    bool allocateSharedMemory(bool hugePages);
     void freeLargePagesMemory();
+    void freeSharedMemory();
 
     static size_t m_hugePageSize;
 
@@ -95,6 +101,7 @@ private:
     const uint32_t m_node;
     size_t m_capacity;
     std::bitset<FLAG_MAX> m_flags;
+    int m_fd              = -1;     // anonymous file behind a shared allocation, it can be passed to another process
     uint8_t *m_scratchpad = nullptr;
 };
 
@@ -44,7 +44,10 @@
 
 
 #ifdef XMRIG_OS_LINUX
+#   include "base/kernel/ResourceLimits.h"
 #   include "crypto/common/LinuxMemory.h"
+#   include <sys/syscall.h>
+#   include <unistd.h>
 #endif
 
 
@@ -67,6 +70,16 @@
 #endif
 
 
+#ifndef MFD_CLOEXEC
+#   define MFD_CLOEXEC 0x0001U
+#endif
+
+
+#ifndef MFD_HUGETLB
+#   define MFD_HUGETLB 0x0004U
+#endif
+
+
 #ifdef XMRIG_SECURE_JIT
 #   define SECURE_PROT_EXEC 0
 #else
@@ -139,6 +152,43 @@ bool xmrig::VirtualMemory::protectRX(void *p, size_t size)
 }
 
 
+void *xmrig::VirtualMemory::allocateDualMappedMemory(size_t size, void **exec)
+{
+#   if defined(XMRIG_OS_LINUX) && defined(SYS_memfd_create)
+    // Two views of the same anonymous file: writable for the JIT compiler, executable for the workers.
+    // Neither is ever W+X, so no mprotect() calls (and TLB shootdowns) are needed between programs.
+    const int fd = static_cast<int>(syscall(SYS_memfd_create, "xmrig-jit", MFD_CLOEXEC));
+    if (fd < 0) {
+        return nullptr;
+    }
+
+    void *mem = MAP_FAILED;
+    void *rx  = MAP_FAILED;
+
+    if (ftruncate(fd, static_cast<off_t>(size)) == 0) {
+        mem = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        rx  = mem == MAP_FAILED ? MAP_FAILED : mmap(nullptr, size, PROT_READ | PROT_EXEC, MAP_SHARED, fd, 0);
+    }
+
+    close(fd);
+
+    if (rx == MAP_FAILED) {
+        if (mem != MAP_FAILED) {
+            munmap(mem, size);
+        }
+
+        return nullptr;
+    }
+
+    *exec = rx;
+
+    return mem;
+#   else
+    return nullptr;
+#   endif
+}
+
+
 void *xmrig::VirtualMemory::allocateExecutableMemory(size_t size, bool hugePages)
 {
 #   if defined(XMRIG_OS_APPLE)
@@ -213,6 +263,16 @@ void xmrig::VirtualMemory::flushInstructionCache(void *p, size_t size)
 }
 
 
+void xmrig::VirtualMemory::freeDualMappedMemory(void *p, void *exec, size_t size)
+{
+    munmap(p, size);
+
+    if (exec != p) {
+        munmap(exec, size);
+    }
+}
+
+
 void xmrig::VirtualMemory::freeLargePagesMemory(void *p, size_t size)
 {
     munmap(p, size);
@@ -230,6 +290,10 @@ void xmrig::VirtualMemory::osInit(size_t hugePageSize)
 bool xmrig::VirtualMemory::allocateLargePagesMemory()
 {
 #   ifdef XMRIG_OS_LINUX
+    if (!ResourceLimits::reserve(m_size, hugePageSize())) {
+        return false;
+    }
+
     LinuxMemory::reserve(m_size, m_node, hugePageSize());
 #   endif
 
@@ -246,6 +310,10 @@ bool xmrig::VirtualMemory::allocateLargePagesMemory()
         return true;
     }
 
+#   ifdef XMRIG_OS_LINUX
+    ResourceLimits::release(m_size, hugePageSize());
+#   endif
+
     return false;
 }
 
@@ -253,6 +321,10 @@ bool xmrig::VirtualMemory::allocateLargePagesMemory()
 bool xmrig::VirtualMemory::allocateOneGbPagesMemory()
 {
 #   ifdef XMRIG_OS_LINUX
+    if (!ResourceLimits::reserve(m_size, kOneGiB)) {
+        return false;
+    }
+
     LinuxMemory::reserve(m_size, m_node, kOneGiB);
 #   endif
 
@@ -269,7 +341,61 @@ bool xmrig::VirtualMemory::allocateOneGbPagesMemory()
         return true;
     }
 
+#   ifdef XMRIG_OS_LINUX
+    ResourceLimits::release(m_size, kOneGiB);
+#   endif
+
+    return false;
+}
+
+
+bool xmrig::VirtualMemory::allocateSharedMemory(bool hugePages)
+{
+#   if defined(XMRIG_OS_LINUX) && defined(SYS_memfd_create)
+    if (hugePages && !ResourceLimits::reserve(m_size, hugePageSize())) {
+        hugePages = false;
+    }
+
+    if (hugePages) {
+        LinuxMemory::reserve(m_size, m_node, hugePageSize());
+    }
+
+    const unsigned int flags = MFD_CLOEXEC | (hugePages ? (MFD_HUGETLB | static_cast<unsigned int>(hugePagesFlag(hugePageSize()))) : 0);
+    const int fd             = static_cast<int>(syscall(SYS_memfd_create, "xmrig-shared", flags));
+    void *mem                = MAP_FAILED;
+
+    if (fd >= 0 && ftruncate(fd, static_cast<off_t>(m_size)) == 0) {
+        mem = mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, 0);
+    }
+
+    if (mem == MAP_FAILED) {
+        if (fd >= 0) {
+            close(fd);
+        }
+
+        if (hugePages) {
+            ResourceLimits::release(m_size, hugePageSize());
+        }
+
+        return false;
+    }
+
+    m_fd         = fd;
+    m_scratchpad = static_cast<uint8_t*>(mem);
+
+    m_flags.set(FLAG_SHARED, true);
+    m_flags.set(FLAG_HUGEPAGES, hugePages);
+
+    madvise(m_scratchpad, m_size, MADV_RANDOM | MADV_WILLNEED);
+
+    if (hugePages && mlock(m_scratchpad, m_size) == 0) {
+        m_flags.set(FLAG_LOCK, true);
+    }
+
+    return true;
+#   else
     return false;
+#   endif
 }
 
 
@@ -279,5 +405,27 @@ void xmrig::VirtualMemory::freeLargePagesMemory()
         munlock(m_scratchpad, m_size);
     }
 
+#   ifdef XMRIG_OS_LINUX
+    ResourceLimits::release(m_size, isOneGbPages() ? kOneGiB : hugePageSize());
+#   endif
+
     freeLargePagesMemory(m_scratchpad, m_size);
 }
+
+
+void xmrig::VirtualMemory::freeSharedMemory()
+{
+    if (m_flags.test(FLAG_LOCK)) {
+        munlock(m_scratchpad, m_size);
+    }
+
+    munmap(m_scratchpad, m_size);
+
+#   ifdef XMRIG_OS_LINUX
+    if (isHugePages()) {
+        ResourceLimits::release(m_size, hugePageSize());
+    }
+
+    close(m_fd);
+#   endif
+}
@@ -186,6 +186,12 @@ bool xmrig::VirtualMemory::protectRX(void *p, size_t size)
 }
 
 
+void *xmrig::VirtualMemory::allocateDualMappedMemory(size_t, void **)
+{
+    return nullptr;
+}
+
+
 void *xmrig::VirtualMemory::allocateExecutableMemory(size_t size, bool hugePages)
 {
     void* result = nullptr;
@@ -227,6 +233,12 @@ void xmrig::VirtualMemory::flushInstructionCache(void *p, size_t size)
 }
 
 
+void xmrig::VirtualMemory::freeDualMappedMemory(void *p, void *, size_t)
+{
+    VirtualFree(p, 0, MEM_RELEASE);
+}
+
+
 void xmrig::VirtualMemory::freeLargePagesMemory(void *p, size_t)
 {
     VirtualFree(p, 0, MEM_RELEASE);
@@ -260,7 +272,18 @@ bool xmrig::VirtualMemory::allocateOneGbPagesMemory()
 }
 
 
+bool xmrig::VirtualMemory::allocateSharedMemory(bool)
+{
+    return false;
+}
+
+
 void xmrig::VirtualMemory::freeLargePagesMemory()
 {
     freeLargePagesMemory(m_scratchpad, m_size);
 }
+
+
+void xmrig::VirtualMemory::freeSharedMemory()
+{
+}
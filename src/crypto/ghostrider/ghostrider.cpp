@@ -40,6 +40,7 @@
 #include "crypto/cn/CnHash.h"
 #include "crypto/cn/CnCtx.h"
 #include "crypto/cn/CryptoNight.h"
+#include "crypto/common/JobAbort.h"
 #include "crypto/common/VirtualMemory.h"
 
 #include <thread>
@@ -556,7 +557,7 @@ void destroy_helper_thread(HelperThread* t)
 }
 
 template <size_t CORE_ALGO_LIMIT>
-void hash_octa(const uint8_t* data, size_t size, uint8_t* output, cryptonight_ctx** ctx, HelperThread* helper, bool verbose)
+bool hash_octa(const uint8_t* data, size_t size, uint8_t* output, cryptonight_ctx** ctx, HelperThread* helper, bool verbose)
 {
     enum { N = 8 };
 
@@ -692,6 +693,14 @@ void hash_octa(const uint8_t* data, size_t size, uint8_t* output, cryptonight_ct
     }
     else {
         for (size_t part = 0; part < 3; ++part) {
+            if (part && JobAbort::isRequested()) {
+                for (size_t i = 0; i < N; ++i) {
+                    ctx[i]->memory = ctx_memory[i];
+                }
+
+                return false;
+            }
+
             const AlgoTune& t = tune[cn_indices[part]];
 
             // Allocate scratchpads
@@ -790,6 +799,8 @@ void hash_octa(const uint8_t* data, size_t size, uint8_t* output, cryptonight_ct
     for (size_t i = 0; i < N; ++i) {
         ctx[i]->memory = ctx_memory[i];
     }
+
+    return true;
 }
 
 #else // XMRIG_FEATURE_HWLOC
@@ -800,7 +811,7 @@ HelperThread* create_helper_thread(int64_t, int, const std::vector<int64_t>&) {
 void destroy_helper_thread(HelperThread*) {}
 
 template <size_t CORE_ALGO_LIMIT>
-void hash_octa(const uint8_t* data, size_t size, uint8_t* output, cryptonight_ctx** ctx, HelperThread*, bool verbose)
+bool hash_octa(const uint8_t* data, size_t size, uint8_t* output, cryptonight_ctx** ctx, HelperThread*, bool verbose)
 {
     constexpr uint32_t N = 8;
 
@@ -839,6 +850,13 @@ void hash_octa(const uint8_t* data, size_t size, uint8_t* output, cryptonight_ct
     uint8_t tmp[64 * N];
 
     for (size_t part = 0; part < 3; ++part) {
+        if (part && JobAbort::isRequested()) {
+            for (size_t i = 0; i < N; ++i) {
+                ctx[i]->memory = ctx_memory[i];
+            }
+
+            return false;
+        }
 
         // Allocate scratchpads
         {
@@ -883,13 +901,15 @@ void hash_octa(const uint8_t* data, size_t size, uint8_t* output, cryptonight_ct
     for (size_t i = 0; i < N; ++i) {
         ctx[i]->memory = ctx_memory[i];
     }
+
+    return true;
 }
 
 
 #endif // XMRIG_FEATURE_HWLOC
 
-template void hash_octa<11>(const uint8_t* data, size_t size, uint8_t* output, cryptonight_ctx** ctx, HelperThread* helper, bool verbose);
-template void hash_octa<15>(const uint8_t* data, size_t size, uint8_t* output, cryptonight_ctx** ctx, HelperThread* helper, bool verbose);
+template bool hash_octa<11>(const uint8_t* data, size_t size, uint8_t* output, cryptonight_ctx** ctx, HelperThread* helper, bool verbose);
+template bool hash_octa<15>(const uint8_t* data, size_t size, uint8_t* output, cryptonight_ctx** ctx, HelperThread* helper, bool verbose);
 
 } // namespace ghostrider
 
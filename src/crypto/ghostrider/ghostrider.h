@@ -42,8 +42,9 @@ void benchmark();
 HelperThread* create_helper_thread(int64_t cpu_index, int priority, const std::vector<int64_t>& affinities);
 void destroy_helper_thread(HelperThread* t);
 
+// Returns false if the worker was asked to abort (JobAbort), output is incomplete in that case
 template<size_t CORE_ALGO_LIMIT>
-void hash_octa(const uint8_t* data, size_t size, uint8_t* output, cryptonight_ctx** ctx, HelperThread* helper, bool verbose = true);
+bool hash_octa(const uint8_t* data, size_t size, uint8_t* output, cryptonight_ctx** ctx, HelperThread* helper, bool verbose = true);
 
 } // namespace ghostrider
 
@@ -35,8 +35,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace randomx {
 
-	//register file in machine byte order
-	struct NativeRegisterFile {
+	//register file in machine byte order, every register group fills exactly one cache line
+	struct alignas(64) NativeRegisterFile {
 		int_reg_t r[RegistersCount] = { 0 };
 		rx_vec_f128 f[RegisterCountFlt];
 		rx_vec_f128 e[RegisterCountFlt];
@@ -64,6 +64,10 @@ namespace randomx {
 		uint32_t memMask;
 	};
 
+#if defined(__GNUC__) && !defined(RANDOMX_NO_THREADED_DISPATCH)
+#	define RANDOMX_THREADED_DISPATCH
+#endif
+
 #define RANDOMX_EXE_ARGS InstructionByteCode& ibc, int& pc, uint8_t* scratchpad, ProgramConfiguration& config
 #define RANDOMX_GEN_ARGS Instruction& instr, int i, InstructionByteCode& ibc
 
@@ -90,10 +94,65 @@ namespace randomx {
 		}
 
 		static void executeBytecode(InstructionByteCode* bytecode, uint8_t* scratchpad, ProgramConfiguration& config) {
+#ifdef RANDOMX_THREADED_DISPATCH
+			// Threaded code: every handler ends with its own indirect jump to the next one, instead of all
+			// instructions sharing the single indirect branch of a switch, which the CPU can't predict.
+			static void* const handlers[] = {
+				&&IADD_RS, &&IADD_M, &&ISUB_R, &&ISUB_M, &&IMUL_R, &&IMUL_M, &&IMULH_R, &&IMULH_M, &&ISMULH_R, &&ISMULH_M,
+				&&NOP /* IMUL_RCP is executed as IMUL_R */, &&INEG_R, &&IXOR_R, &&IXOR_M, &&IROR_R, &&IROL_R, &&ISWAP_R,
+				&&FSWAP_R, &&FADD_R, &&FADD_M, &&FSUB_R, &&FSUB_M, &&FSCAL_R, &&FMUL_R, &&FDIV_M, &&FSQRT_R,
+				&&CBRANCH, &&CFROUND, &&ISTORE, &&NOP
+			};
+
+			const int size = static_cast<int>(RandomX_CurrentConfig.ProgramSize);
+			InstructionByteCode* ibc = bytecode;
+			int pc = 0;
+
+#			define RANDOMX_DISPATCH() if (++pc >= size) { return; } ibc = bytecode + pc; goto *handlers[static_cast<uint16_t>(ibc->type)];
+#			define RANDOMX_HANDLER(x) x: exe_ ## x(*ibc, pc, scratchpad, config); RANDOMX_DISPATCH()
+
+			goto *handlers[static_cast<uint16_t>(ibc->type)];
+
+			RANDOMX_HANDLER(IADD_RS)
+			RANDOMX_HANDLER(IADD_M)
+			RANDOMX_HANDLER(ISUB_R)
+			RANDOMX_HANDLER(ISUB_M)
+			RANDOMX_HANDLER(IMUL_R)
+			RANDOMX_HANDLER(IMUL_M)
+			RANDOMX_HANDLER(IMULH_R)
+			RANDOMX_HANDLER(IMULH_M)
+			RANDOMX_HANDLER(ISMULH_R)
+			RANDOMX_HANDLER(ISMULH_M)
+			RANDOMX_HANDLER(INEG_R)
+			RANDOMX_HANDLER(IXOR_R)
+			RANDOMX_HANDLER(IXOR_M)
+			RANDOMX_HANDLER(IROR_R)
+			RANDOMX_HANDLER(IROL_R)
+			RANDOMX_HANDLER(ISWAP_R)
+			RANDOMX_HANDLER(FSWAP_R)
+			RANDOMX_HANDLER(FADD_R)
+			RANDOMX_HANDLER(FADD_M)
+			RANDOMX_HANDLER(FSUB_R)
+			RANDOMX_HANDLER(FSUB_M)
+			RANDOMX_HANDLER(FSCAL_R)
+			RANDOMX_HANDLER(FMUL_R)
+			RANDOMX_HANDLER(FDIV_M)
+			RANDOMX_HANDLER(FSQRT_R)
+			RANDOMX_HANDLER(CBRANCH)
+			RANDOMX_HANDLER(CFROUND)
+			RANDOMX_HANDLER(ISTORE)
+
+		NOP:
+			RANDOMX_DISPATCH()
+
+#			undef RANDOMX_HANDLER
+#			undef RANDOMX_DISPATCH
+#else
 			for (int pc = 0; pc < static_cast<int>(RandomX_CurrentConfig.ProgramSize); ++pc) {
 				auto& ibc = bytecode[pc];
 				executeInstruction(ibc, pc, scratchpad, config);
 			}
+#endif
 		}
 
 		void compileInstruction(RANDOMX_GEN_ARGS)
@@ -235,8 +294,12 @@ namespace randomx {
 		static rx_vec_f128 maskRegisterExponentMantissa(ProgramConfiguration& config, rx_vec_f128 x) {
 			const rx_vec_f128 xmantissaMask = rx_set_vec_f128(dynamicMantissaMask, dynamicMantissaMask);
 			const rx_vec_f128 xexponentMask = rx_load_vec_f128((const double*)&config.eMask);
-			x = rx_and_vec_f128(x, xmantissaMask);
-			x = rx_or_vec_f128(x, xexponentMask);
+			return maskRegisterExponentMantissa(x, xmantissaMask, xexponentMask);
+		}
+
+		static rx_vec_f128 maskRegisterExponentMantissa(rx_vec_f128 x, rx_vec_f128 mantissaMask, rx_vec_f128 exponentMask) {
+			x = rx_and_vec_f128(x, mantissaMask);
+			x = rx_or_vec_f128(x, exponentMask);
 			return x;
 		}
 
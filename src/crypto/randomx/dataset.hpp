@@ -38,6 +38,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 /* Global scope for C binding */
 struct randomx_dataset {
 	uint8_t* memory = nullptr;
+	const RandomX_ConfigurationBase* config = nullptr;
 };
 
 /* Global scope for C binding */
@@ -47,6 +48,7 @@ struct randomx_cache {
 	randomx::CacheInitializeFunc* initialize;
 	randomx::DatasetInitFunc* datasetInit;
 	randomx::SuperscalarProgram programs[RANDOMX_CACHE_MAX_ACCESSES];
+	const RandomX_ConfigurationBase* config = nullptr;
 
 	bool isInitialized() const {
 		return programs[0].getSize() != 0;
@@ -112,7 +112,7 @@ JitCompilerA64::JitCompilerA64(bool hugePagesEnable, bool) :
 
 JitCompilerA64::~JitCompilerA64()
 {
-	freePagedMemory(code, allocatedSize);
+	freeCodeMemory(code, code + execOffset, allocatedSize);
 }
 
 void JitCompilerA64::generateProgram(Program& program, ProgramConfiguration& config, uint32_t)
@@ -141,6 +141,8 @@ void JitCompilerA64::generateProgram(Program& program, ProgramConfiguration& con
 	for (uint32_t i = 0; i < RegistersCount; ++i)
 		reg_changed_offset[i] = codePos;
 
+	const InstructionGeneratorA64* engine = RandomX_CurrentConfig.JitEngine;
+
 	for (uint32_t i = 0; i < program.getSize(); ++i)
 	{
 		Instruction& instr = program(i);
@@ -169,7 +171,7 @@ void JitCompilerA64::generateProgram(Program& program, ProgramConfiguration& con
 	emit32(ARMV8A::EOR | 10 | (IntRegMap[config.readReg0] << 5) | (IntRegMap[config.readReg1] << 16), code, codePos);
 
 #	ifndef XMRIG_OS_APPLE
-	xmrig::VirtualMemory::flushInstructionCache(reinterpret_cast<char*>(code + MainLoopBegin), codePos - MainLoopBegin);
+	xmrig::VirtualMemory::flushInstructionCache(reinterpret_cast<char*>(code + execOffset + MainLoopBegin), codePos - MainLoopBegin);
 #	endif
 }
 
@@ -199,6 +201,8 @@ void JitCompilerA64::generateProgramLight(Program& program, ProgramConfiguration
 	for (uint32_t i = 0; i < RegistersCount; ++i)
 		reg_changed_offset[i] = codePos;
 
+	const InstructionGeneratorA64* engine = RandomX_CurrentConfig.JitEngine;
+
 	for (uint32_t i = 0; i < program.getSize(); ++i)
 	{
 		Instruction& instr = program(i);
@@ -233,7 +237,7 @@ void JitCompilerA64::generateProgramLight(Program& program, ProgramConfiguration
 	emit32(ARMV8A::ADD_IMM_HI | 2 | (2 << 5) | (imm_hi << 10), code, codePos);
 
 #	ifndef XMRIG_OS_APPLE
-	xmrig::VirtualMemory::flushInstructionCache(reinterpret_cast<char*>(code + MainLoopBegin), codePos - MainLoopBegin);
+	xmrig::VirtualMemory::flushInstructionCache(reinterpret_cast<char*>(code + execOffset + MainLoopBegin), codePos - MainLoopBegin);
 #	endif
 }
 
@@ -360,7 +364,7 @@ void JitCompilerA64::generateSuperscalarHash(SuperscalarProgram(&programs)[N])
 	codePos += p2 - p1;
 
 #	ifndef XMRIG_OS_APPLE
-	xmrig::VirtualMemory::flushInstructionCache(reinterpret_cast<char*>(code + CodeSize), codePos - MainLoopBegin);
+	xmrig::VirtualMemory::flushInstructionCache(reinterpret_cast<char*>(code + execOffset + CodeSize), codePos - MainLoopBegin);
 #	endif
 }
 
@@ -372,7 +376,7 @@ DatasetInitFunc* JitCompilerA64::getDatasetInitFunc() const
 	enableExecution();
 #	endif
 
-	return (DatasetInitFunc*)(code + (((uint8_t*)randomx_init_dataset_aarch64) - ((uint8_t*)randomx_program_aarch64)));
+	return (DatasetInitFunc*)(code + execOffset + (((uint8_t*)randomx_init_dataset_aarch64) - ((uint8_t*)randomx_program_aarch64)));
 }
 
 size_t JitCompilerA64::getCodeSize()
@@ -382,11 +386,19 @@ size_t JitCompilerA64::getCodeSize()
 
 void JitCompilerA64::enableWriting() const
 {
+	if (execOffset) {
+		return;
+	}
+
 	xmrig::VirtualMemory::protectRW(code, allocatedSize);
 }
 
 void JitCompilerA64::enableExecution() const
 {
+	if (execOffset) {
+		return;
+	}
+
 	xmrig::VirtualMemory::protectRX(code, allocatedSize);
 }
 
@@ -394,12 +406,14 @@ void JitCompilerA64::enableExecution() const
 void JitCompilerA64::allocate(size_t size)
 {
 	allocatedSize = size;
-	code = static_cast<uint8_t*>(allocExecutableMemory(allocatedSize, hugePages));
+	void* exec = nullptr;
+	code = static_cast<uint8_t*>(allocCodeMemory(allocatedSize, hugePages, &exec));
+	execOffset = static_cast<uint8_t*>(exec) - code;
 
 	memcpy(code, reinterpret_cast<const void *>(randomx_program_aarch64), CodeSize);
 
 #	ifndef XMRIG_OS_APPLE
-	xmrig::VirtualMemory::flushInstructionCache(reinterpret_cast<char*>(code), CodeSize);
+	xmrig::VirtualMemory::flushInstructionCache(reinterpret_cast<char*>(code + execOffset), CodeSize);
 #	endif
 }
 
@@ -1078,6 +1092,4 @@ void JitCompilerA64::h_NOP(Instruction& instr, uint32_t& codePos)
 {
 }
 
-InstructionGeneratorA64 JitCompilerA64::engine[256] = {};
-
 }
@@ -30,6 +30,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 #include <stdexcept>
@@ -41,9 +42,6 @@ namespace randomx {
 	class Program;
 	struct ProgramConfiguration;
 	class SuperscalarProgram;
-	class Instruction;
-
-	typedef void(JitCompilerA64::*InstructionGeneratorA64)(Instruction&, uint32_t&);
 
 	class JitCompilerA64 {
 	public:
@@ -64,7 +62,7 @@ namespace randomx {
 			enableExecution();
 #			endif
 
-			return reinterpret_cast<ProgramFunc*>(code);
+			return reinterpret_cast<ProgramFunc*>(code + execOffset);
 		}
 
 		DatasetInitFunc* getDatasetInitFunc() const;
@@ -74,12 +72,11 @@ namespace randomx {
 		void enableWriting() const;
 		void enableExecution() const;
 
-		static InstructionGeneratorA64 engine[256];
-
 	private:
 		const bool hugePages;
 		uint32_t reg_changed_offset[8]{};
 		uint8_t* code = nullptr;
+		ptrdiff_t execOffset = 0;
 		uint32_t literalPos;
 		uint32_t num32bitLiterals = 0;
 		size_t allocatedSize = 0;
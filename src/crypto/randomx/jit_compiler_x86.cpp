@@ -200,12 +200,20 @@ namespace randomx {
 	}
 
 	void JitCompilerX86::enableWriting() const {
+		if (execOffset) {
+			return;
+		}
+
 		uint8_t* p1 = alignToPage(code, 4096);
 		uint8_t* p2 = code + CodeSize;
 		xmrig::VirtualMemory::protectRW(p1, p2 - p1);
 	}
 
 	void JitCompilerX86::enableExecution() const {
+		if (execOffset) {
+			return;
+		}
+
 		uint8_t* p1 = alignToPage(code, 4096);
 		uint8_t* p2 = code + CodeSize;
 		xmrig::VirtualMemory::protectRX(p1, p2 - p1);
@@ -279,13 +287,16 @@ namespace randomx {
 		hasXOP = xmrig::Cpu::info()->hasXOP();
 
 		allocatedSize = initDatasetAVX2 ? (CodeSize * 4) : (CodeSize * 2);
-		allocatedCode = static_cast<uint8_t*>(allocExecutableMemory(allocatedSize,
+		void* exec = nullptr;
+		allocatedCode = static_cast<uint8_t*>(allocCodeMemory(allocatedSize,
 #			ifdef XMRIG_SECURE_JIT
-			false
+			false,
 #			else
-			hugePagesJIT && hugePagesEnable
+			hugePagesJIT && hugePagesEnable,
 #			endif
+			&exec
 		));
+		execOffset = static_cast<uint8_t*>(exec) - allocatedCode;
 
 		// Shift code base address to improve caching - all threads will use different L2/L3 cache sets
 		code = allocatedCode + (codeOffset.fetch_add(codeOffsetIncrement) % CodeSize);
@@ -302,14 +313,14 @@ namespace randomx {
 		codePosFirst = prologueSize + (hasXOP ? loopLoadXOPSize : loopLoadSize);
 
 #		ifdef XMRIG_FIX_RYZEN
-		mainLoopBounds.first = code + prologueSize;
-		mainLoopBounds.second = code + epilogueOffset;
+		mainLoopBounds.first = code + execOffset + prologueSize;
+		mainLoopBounds.second = code + execOffset + epilogueOffset;
 #		endif
 	}
 
 	JitCompilerX86::~JitCompilerX86() {
 		codeOffset.fetch_sub(codeOffsetIncrement);
-		freePagedMemory(allocatedCode, allocatedSize);
+		freeCodeMemory(allocatedCode, allocatedCode + execOffset, allocatedSize);
 	}
 
 	template<size_t N>
@@ -323,7 +334,6 @@ namespace randomx {
 	template<typename T> static FORCE_INLINE void prefetch_data(const T& data) { prefetch_data<(sizeof(T) + 63) / 64>(&data); }
 
 	void JitCompilerX86::prepare() {
-		prefetch_data(engine);
 		prefetch_data(RandomX_CurrentConfig);
 	}
 
@@ -447,7 +457,10 @@ namespace randomx {
 			r[j] = k;
 		}
 
-		for (int i = 0, n = static_cast<int>(RandomX_CurrentConfig.ProgramSize); i < n; i += 4) {
+		const RandomX_ConfigurationBase& cfg = RandomX_CurrentConfig;
+		const InstructionGeneratorX86* engine = cfg.JitEngine;
+
+		for (int i = 0, n = static_cast<int>(cfg.ProgramSize); i < n; i += 4) {
 			Instruction& instr1 = prog(i);
 			Instruction& instr2 = prog(i + 1);
 			Instruction& instr3 = prog(i + 2);
@@ -1443,6 +1456,5 @@ namespace randomx {
 		emitByte(0x90, code, codePos);
 	}
 
-	alignas(64) InstructionGeneratorX86 JitCompilerX86::engine[256] = {};
 
 }
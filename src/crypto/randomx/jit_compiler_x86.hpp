@@ -30,6 +30,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <vector>
@@ -40,11 +41,6 @@ namespace randomx {
 	class Program;
 	struct ProgramConfiguration;
 	class SuperscalarProgram;
-	class JitCompilerX86;
-	class Instruction;
-
-	typedef void(*InstructionGeneratorX86)(JitCompilerX86*, const Instruction&);
-
 	constexpr uint32_t CodeSize = 64 * 1024;
 
 	class JitCompilerX86 {
@@ -63,7 +59,7 @@ namespace randomx {
 			enableExecution();
 #			endif
 
-			return reinterpret_cast<ProgramFunc*>(code);
+			return reinterpret_cast<ProgramFunc*>(code + execOffset);
 		}
 
 		inline DatasetInitFunc *getDatasetInitFunc() const {
@@ -71,7 +67,7 @@ namespace randomx {
 			enableExecution();
 #			endif
 
-			return (DatasetInitFunc*)code;
+			return (DatasetInitFunc*)(code + execOffset);
 		}
 
 		uint8_t* getCode() {
@@ -81,8 +77,6 @@ namespace randomx {
 		void enableWriting() const;
 		void enableExecution() const;
 
-		alignas(64) static InstructionGeneratorX86 engine[256];
-
 	private:
 		int registerUsage[RegistersCount] = {};
 		uint8_t* code = nullptr;
@@ -105,6 +99,9 @@ namespace randomx {
 		uint8_t* allocatedCode = nullptr;
 		size_t allocatedSize = 0;
 
+		// Distance from the writable to the executable view of the code buffer, 0 if it isn't dual-mapped
+		ptrdiff_t execOffset = 0;
+
 		uint8_t* imul_rcp_storage = nullptr;
 		uint32_t imul_rcp_storage_used = 0;
 
@@ -42,7 +42,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #endif
 
 #include "backend/cpu/Cpu.h"
+#include "crypto/common/JobAbort.h"
 #include "crypto/common/VirtualMemory.h"
+#include <atomic>
 #include <mutex>
 
 #include <cassert>
@@ -210,11 +212,6 @@ static uint32_t Log2(size_t value) { return (value > 1) ? (Log2(value / 2) + 1)
 
 static int scratchpadPrefetchMode = 1;
 
-void randomx_set_scratchpad_prefetch_mode(int mode)
-{
-	scratchpadPrefetchMode = mode;
-}
-
 void RandomX_ConfigurationBase::Apply()
 {
 	const uint32_t ScratchpadL1Mask_Calculated = (ScratchpadL1_Size / sizeof(uint64_t) - 1) * 8;
@@ -275,7 +272,7 @@ typedef void(randomx::JitCompilerX86::* InstructionGeneratorX86_2)(const randomx
 
 #define JIT_HANDLE(x, prev) do { \
 		const InstructionGeneratorX86_2 p = &randomx::JitCompilerX86::h_##x; \
-		memcpy(randomx::JitCompilerX86::engine + k, &p, sizeof(randomx::JitCompilerX86::engine[k])); \
+		memcpy(JitEngine + k, &p, sizeof(JitEngine[k])); \
 	} while (0)
 
 #elif (XMRIG_ARM == 8)
@@ -286,7 +283,7 @@ typedef void(randomx::JitCompilerX86::* InstructionGeneratorX86_2)(const randomx
 	Log2_DatasetBaseSize = Log2(DatasetBaseSize);
 	Log2_CacheSize = Log2((ArgonMemory * randomx::ArgonBlockSize) / randomx::CacheLineSize);
 
-#define JIT_HANDLE(x, prev) randomx::JitCompilerA64::engine[k] = &randomx::JitCompilerA64::h_##x
+#define JIT_HANDLE(x, prev) JitEngine[k] = &randomx::JitCompilerA64::h_##x
 
 #else
 #define JIT_HANDLE(x, prev)
@@ -376,10 +373,137 @@ RandomX_ConfigurationKeva RandomX_KevaConfig;
 RandomX_ConfigurationYada RandomX_YadaConfig;
 RandomX_ConfigurationTuske RandomX_TuskeConfig;
 
-alignas(64) RandomX_ConfigurationBase RandomX_CurrentConfig;
+static const RandomX_ConfigurationBase *const variants[] = {
+	&RandomX_MoneroConfig,
+	&RandomX_WowneroConfig,
+	&RandomX_ArqmaConfig,
+	&RandomX_GraftConfig,
+	&RandomX_SafexConfig,
+	&RandomX_KevaConfig,
+	&RandomX_YadaConfig,
+	&RandomX_TuskeConfig,
+};
+
+static constexpr size_t kVariantCount       = sizeof(variants) / sizeof(variants[0]);
+static constexpr int kPrefetchModeCount     = 4;
+
+// Applied copies of every variant, one set per scratchpad prefetch mode. A set is filled once and never written again,
+// so caches, datasets and VMs can keep pointers into it while the prefetch mode is switched to another set.
+static RandomX_ConfigurationBase applied_variants[kPrefetchModeCount][kVariantCount];
+static bool applied_modes[kPrefetchModeCount] = {};
+
+static std::mutex config_mutex;
+static std::atomic<const RandomX_ConfigurationBase*> current_variants{ nullptr };
+static std::atomic<const RandomX_ConfigurationBase*> default_config{ &RandomX_MoneroConfig };
+
+thread_local const RandomX_ConfigurationBase *RandomX_ThreadConfig = nullptr;
 
 static std::mutex vm_pool_mutex;
 
+// Applies all variants for the prefetch mode into its own set and publishes it, switching sets is only a pointer change
+static void applyConfigs(int mode)
+{
+	if (mode < 0 && current_variants.load(std::memory_order_acquire)) {
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(config_mutex);
+
+	if (mode < 0) {
+		if (current_variants.load(std::memory_order_relaxed)) {
+			return;
+		}
+
+		mode = scratchpadPrefetchMode;
+	}
+
+	if (mode >= kPrefetchModeCount) {
+		mode = 1;
+	}
+
+	RandomX_ConfigurationBase *set = applied_variants[mode];
+
+	if (!applied_modes[mode]) {
+		scratchpadPrefetchMode = mode;
+
+		for (size_t i = 0; i < kVariantCount; ++i) {
+			set[i] = *variants[i];
+			set[i].Apply();
+		}
+
+		applied_modes[mode] = true;
+	}
+
+	scratchpadPrefetchMode = mode;
+	current_variants.store(set, std::memory_order_release);
+}
+
+// Maps a variant definition (RandomX_MoneroConfig and so on) to its applied copy for the current prefetch mode,
+// pointers that are already applied copies are returned unchanged
+static const RandomX_ConfigurationBase *appliedConfig(const RandomX_ConfigurationBase *config)
+{
+	applyConfigs(-1);
+
+	const RandomX_ConfigurationBase *set = current_variants.load(std::memory_order_acquire);
+	for (size_t i = 0; i < kVariantCount; ++i) {
+		if (config == variants[i]) {
+			return set + i;
+		}
+	}
+
+	return config;
+}
+
+
+// Binds the variant of the object the API call works on to the calling thread
+class ConfigScope
+{
+public:
+	explicit ConfigScope(const RandomX_ConfigurationBase *config) : prev(RandomX_ThreadConfig) { assert(config != nullptr); RandomX_ThreadConfig = config; }
+	~ConfigScope() { RandomX_ThreadConfig = prev; }
+
+	ConfigScope(const ConfigScope&) = delete;
+	ConfigScope& operator=(const ConfigScope&) = delete;
+
+private:
+	const RandomX_ConfigurationBase *prev;
+};
+
+void randomx_set_scratchpad_prefetch_mode(int mode)
+{
+	applyConfigs(mode < 0 ? 0 : mode);
+}
+
+void randomx_set_default_config(const RandomX_ConfigurationBase *config)
+{
+	default_config = config;
+	RandomX_ThreadConfig = appliedConfig(config);
+}
+
+void randomx_init_cache(randomx_cache *cache, const void *key, size_t keySize, const RandomX_ConfigurationBase *config)
+{
+	assert(cache != nullptr);
+	assert(config != nullptr);
+
+	cache->config = appliedConfig(config);
+	randomx_init_cache(cache, key, keySize);
+}
+
+void randomx_dataset_set_config(randomx_dataset *dataset, const randomx_cache *cache)
+{
+	assert(dataset != nullptr);
+	assert(cache != nullptr && cache->config != nullptr);
+
+	dataset->config = cache->config;
+}
+
+unsigned long randomx_dataset_item_count(const randomx_cache *cache)
+{
+	assert(cache != nullptr && cache->config != nullptr);
+
+	return (cache->config->DatasetBaseSize + cache->config->DatasetExtraSize) / RANDOMX_DATASET_ITEM_SIZE;
+}
+
 extern "C" {
 
 	randomx_cache *randomx_create_cache(randomx_flags flags, uint8_t *memory) {
@@ -391,6 +515,7 @@ extern "C" {
 
 		try {
 			cache = new randomx_cache();
+			cache->config = appliedConfig(default_config);
 			switch (flags & RANDOMX_FLAG_JIT) {
 				case RANDOMX_FLAG_DEFAULT:
 					cache->jit          = nullptr;
@@ -423,6 +548,8 @@ extern "C" {
 	void randomx_init_cache(randomx_cache *cache, const void *key, size_t keySize) {
 		assert(cache != nullptr);
 		assert(keySize == 0 || key != nullptr);
+
+		ConfigScope scope(cache->config);
 		cache->initialize(cache, key, keySize);
 	}
 
@@ -438,6 +565,7 @@ extern "C" {
 
 		auto dataset = new randomx_dataset();
 		dataset->memory = memory;
+		dataset->config = appliedConfig(default_config);
 
 		return dataset;
 	}
@@ -445,12 +573,17 @@ extern "C" {
 	#define DatasetItemCount ((RandomX_CurrentConfig.DatasetBaseSize + RandomX_CurrentConfig.DatasetExtraSize) / RANDOMX_DATASET_ITEM_SIZE)
 
 	unsigned long randomx_dataset_item_count() {
+		ConfigScope scope(appliedConfig(default_config));
 		return DatasetItemCount;
 	}
 
 	void randomx_init_dataset(randomx_dataset *dataset, randomx_cache *cache, unsigned long startItem, unsigned long itemCount) {
 		assert(dataset != nullptr);
 		assert(cache != nullptr);
+
+		assert(dataset->config == cache->config);
+
+		ConfigScope scope(cache->config);
 		assert(startItem < DatasetItemCount && itemCount <= DatasetItemCount);
 		assert(startItem + itemCount <= DatasetItemCount);
 		cache->datasetInit(cache, dataset->memory + startItem * randomx::CacheLineSize, startItem, startItem + itemCount);
@@ -472,6 +605,7 @@ extern "C" {
 
 		randomx_vm* vm = nullptr;
 
+		ConfigScope scope((flags & RANDOMX_FLAG_FULL_MEM) ? dataset->config : cache->config);
 		std::lock_guard<std::mutex> lock(vm_pool_mutex);
 
 		static uint8_t* vm_pool[64] = {};
@@ -568,12 +702,14 @@ extern "C" {
 	void randomx_vm_set_cache(randomx_vm *machine, randomx_cache* cache) {
 		assert(machine != nullptr);
 		assert(cache != nullptr && cache->isInitialized());
+		ConfigScope scope(cache->config);
 		machine->setCache(cache);
 	}
 
 	void randomx_vm_set_dataset(randomx_vm *machine, randomx_dataset *dataset) {
 		assert(machine != nullptr);
 		assert(dataset != nullptr);
+		ConfigScope scope(dataset->config);
 		machine->setDataset(dataset);
 	}
 
@@ -585,6 +721,7 @@ extern "C" {
 		assert(machine != nullptr);
 		assert(inputSize == 0 || input != nullptr);
 		assert(output != nullptr);
+		ConfigScope scope(machine->getConfig());
 		alignas(16) uint64_t tempHash[8];
 		rx_blake2b_wrapper::run(tempHash, sizeof(tempHash), input, inputSize);
 		machine->initScratchpad(&tempHash);
@@ -598,23 +735,32 @@ extern "C" {
 	}
 
 	void randomx_calculate_hash_first(randomx_vm* machine, uint64_t (&tempHash)[8], const void* input, size_t inputSize) {
+		ConfigScope scope(machine->getConfig());
 		rx_blake2b_wrapper::run(tempHash, sizeof(tempHash), input, inputSize);
 		machine->initScratchpad(tempHash);
 	}
 
-	void randomx_calculate_hash_next(randomx_vm* machine, uint64_t (&tempHash)[8], const void* nextInput, size_t nextInputSize, void* output) {
+	bool randomx_calculate_hash_next(randomx_vm* machine, uint64_t (&tempHash)[8], const void* nextInput, size_t nextInputSize, void* output) {
 		PROFILE_SCOPE(RandomX_hash);
 
+		ConfigScope scope(machine->getConfig());
+
 		machine->resetRoundingMode();
 		for (uint32_t chain = 0; chain < RandomX_CurrentConfig.ProgramCount - 1; ++chain) {
 			machine->run(&tempHash);
 			rx_blake2b_wrapper::run(tempHash, sizeof(tempHash), machine->getRegisterFile(), sizeof(randomx::RegisterFile));
+
+			if (xmrig::JobAbort::isRequested()) {
+				return false;
+			}
 		}
 		machine->run(&tempHash);
 
 		// Finish current hash and fill the scratchpad for the next hash at the same time
 		rx_blake2b_wrapper::run(tempHash, sizeof(tempHash), nextInput, nextInputSize);
 		machine->hashAndFill(output, tempHash);
+
+		return true;
 	}
 
 }
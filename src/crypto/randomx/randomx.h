@@ -57,6 +57,17 @@ struct randomx_dataset;
 struct randomx_cache;
 class randomx_vm;
 
+namespace randomx {
+
+	class Instruction;
+	class JitCompilerX86;
+	class JitCompilerA64;
+
+	typedef void(*InstructionGeneratorX86)(JitCompilerX86*, const Instruction&);
+	typedef void(JitCompilerA64::*InstructionGeneratorA64)(Instruction&, uint32_t&);
+
+}
+
 
 struct RandomX_ConfigurationBase
 {
@@ -139,6 +150,13 @@ struct RandomX_ConfigurationBase
 	uint32_t Log2_DatasetBaseSize;
 	uint32_t Log2_CacheSize;
 #	endif
+
+	// JIT instruction handlers, they depend on the instruction frequencies of this variant
+#	if defined(_M_X64) || defined(__x86_64__)
+	alignas(64) randomx::InstructionGeneratorX86 JitEngine[256];
+#	elif (XMRIG_ARM == 8)
+	randomx::InstructionGeneratorA64 JitEngine[256];
+#	endif
 };
 
 struct RandomX_ConfigurationMonero : public RandomX_ConfigurationBase {};
@@ -159,15 +177,22 @@ extern RandomX_ConfigurationKeva RandomX_KevaConfig;
 extern RandomX_ConfigurationYada RandomX_YadaConfig;
 extern RandomX_ConfigurationTuske RandomX_TuskeConfig;
 
-extern RandomX_ConfigurationBase RandomX_CurrentConfig;
+// The variants above are plain parameter sets, the API applies them into immutable copies (one set per scratchpad
+// prefetch mode), caches, datasets and VMs keep a pointer to the copy they were initialized with. The RandomX code reads the variant of the object it is working on through
+// RandomX_CurrentConfig, which the API entry points below bind for the calling thread.
+extern thread_local const RandomX_ConfigurationBase *RandomX_ThreadConfig;
+
+#define RandomX_CurrentConfig (*RandomX_ThreadConfig)
+
+// Sets the variant used by caches initialized without an explicit one.
+void randomx_set_default_config(const RandomX_ConfigurationBase *config);
 
 template<typename T>
 void randomx_apply_config(const T& config)
 {
 	static_assert(sizeof(T) == sizeof(RandomX_ConfigurationBase), "Invalid RandomX configuration struct size");
 	static_assert(std::is_base_of<RandomX_ConfigurationBase, T>::value, "Incompatible RandomX configuration struct");
-	RandomX_CurrentConfig = config;
-	RandomX_CurrentConfig.Apply();
+	randomx_set_default_config(&config);
 }
 
 void randomx_set_scratchpad_prefetch_mode(int mode);
@@ -319,10 +344,32 @@ RANDOMX_EXPORT void randomx_destroy_vm(randomx_vm *machine);
 RANDOMX_EXPORT void randomx_calculate_hash(randomx_vm *machine, const void *input, size_t inputSize, void *output);
 
 RANDOMX_EXPORT void randomx_calculate_hash_first(randomx_vm* machine, uint64_t (&tempHash)[8], const void* input, size_t inputSize);
-RANDOMX_EXPORT void randomx_calculate_hash_next(randomx_vm* machine, uint64_t (&tempHash)[8], const void* nextInput, size_t nextInputSize, void* output);
+/**
+ * Finishes the hash started by randomx_calculate_hash_first/next and starts the next one.
+ * Returns false if the calling worker was asked to abort (xmrig::JobAbort) between programs,
+ * output is not written and the chain must be restarted with randomx_calculate_hash_first.
+*/
+RANDOMX_EXPORT bool randomx_calculate_hash_next(randomx_vm* machine, uint64_t (&tempHash)[8], const void* nextInput, size_t nextInputSize, void* output);
 
 #if defined(__cplusplus)
 }
 #endif
 
+/**
+ * Initializes the cache memory for the given RandomX variant, datasets and VMs built from this cache use it too.
+ * randomx_init_cache() without a variant keeps the one the cache already has, or the default for a new cache.
+*/
+void randomx_init_cache(randomx_cache *cache, const void *key, size_t keySize, const RandomX_ConfigurationBase *config);
+
+/**
+ * Switches the dataset to the variant of the cache it is built or copied from. Must be called before
+ * randomx_init_dataset() and for datasets filled by other means, like a copy of another dataset.
+*/
+void randomx_dataset_set_config(randomx_dataset *dataset, const randomx_cache *cache);
+
+/**
+ * Gets the number of dataset items for the variant of an initialized cache.
+*/
+unsigned long randomx_dataset_item_count(const randomx_cache *cache);
+
 #endif
@@ -34,6 +34,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "crypto/randomx/allocator.hpp"
 #include "crypto/randomx/blake2/blake2.h"
 #include "crypto/randomx/common.hpp"
+#include "crypto/randomx/dataset.hpp"
 #include "crypto/randomx/intrin_portable.h"
 #include "crypto/randomx/soft_aes.h"
 #include "crypto/rx/Profiler.h"
@@ -42,6 +43,10 @@ randomx_vm::~randomx_vm() {
 
 }
 
+const RandomX_ConfigurationBase* randomx_vm::getConfig() const {
+	return (vm_flags & RANDOMX_FLAG_FULL_MEM) ? datasetPtr->config : cachePtr->config;
+}
+
 void randomx_vm::resetRoundingMode() {
 	rx_reset_float_state();
 }
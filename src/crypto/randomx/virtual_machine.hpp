@@ -49,6 +49,9 @@ public:
 	void setFlags(uint32_t flags) { vm_flags = flags; }
 	uint32_t getFlags() const { return vm_flags; }
 
+	// RandomX variant of the dataset (full memory mode) or the cache (light mode) this VM works on
+	const RandomX_ConfigurationBase* getConfig() const;
+
 	randomx::RegisterFile *getRegisterFile() {
 		return &reg;
 	}
@@ -43,6 +43,40 @@ void* allocExecutableMemory(std::size_t bytes, bool hugePages) {
 }
 
 
+// JIT code buffer: returns the writable view, the executable view is stored in exec.
+// Both are the same pointer unless the buffer could be dual-mapped.
+void* allocCodeMemory(std::size_t bytes, bool hugePages, void** exec) {
+    void *mem = nullptr;
+
+#   ifdef XMRIG_SECURE_JIT
+    mem = xmrig::VirtualMemory::allocateDualMappedMemory(bytes, exec);
+    if (mem) {
+        return mem;
+    }
+#   endif
+
+    mem = xmrig::VirtualMemory::allocateExecutableMemory(bytes, hugePages);
+
+#   ifndef XMRIG_SECURE_JIT
+    // RWX mappings can be forbidden by the host (SELinux execmem, PaX), separate views still work
+    if (mem == nullptr) {
+        mem = xmrig::VirtualMemory::allocateDualMappedMemory(bytes, exec);
+        if (mem) {
+            return mem;
+        }
+    }
+#   endif
+
+    if (mem == nullptr) {
+        throw std::runtime_error("Failed to allocate executable memory");
+    }
+
+    *exec = mem;
+
+    return mem;
+}
+
+
 void* allocLargePagesMemory(std::size_t bytes) {
     void *mem = xmrig::VirtualMemory::allocateLargePagesMemory(bytes);
     if (mem == nullptr) {
@@ -56,3 +90,8 @@ void* allocLargePagesMemory(std::size_t bytes) {
 void freePagedMemory(void* ptr, std::size_t bytes) {
     xmrig::VirtualMemory::freeLargePagesMemory(ptr, bytes);
 }
+
+
+void freeCodeMemory(void* ptr, void* exec, std::size_t bytes) {
+    xmrig::VirtualMemory::freeDualMappedMemory(ptr, exec, bytes);
+}
@@ -59,6 +59,9 @@ namespace randomx {
 		uint32_t spAddr0 = mem.mx;
 		uint32_t spAddr1 = mem.ma;
 
+		const rx_vec_f128 mantissaMask = rx_set_vec_f128(dynamicMantissaMask, dynamicMantissaMask);
+		const rx_vec_f128 exponentMask = rx_load_vec_f128((const double*)&config.eMask);
+
 		for(unsigned ic = 0; ic < RandomX_CurrentConfig.ProgramIterations; ++ic) {
 			uint64_t spMix = nreg.r[config.readReg0] ^ nreg.r[config.readReg1];
 			spAddr0 ^= spMix;
@@ -69,11 +72,11 @@ namespace randomx {
 			for (unsigned i = 0; i < RegistersCount; ++i)
 				nreg.r[i] ^= load64(scratchpad + spAddr0 + 8 * i);
 
-			for (unsigned i = 0; i < RegisterCountFlt; ++i)
+			// f and e groups come from the same 64 byte line, load them in one pass
+			for (unsigned i = 0; i < RegisterCountFlt; ++i) {
 				nreg.f[i] = rx_cvt_packed_int_vec_f128(scratchpad + spAddr1 + 8 * i);
-
-			for (unsigned i = 0; i < RegisterCountFlt; ++i)
-				nreg.e[i] = maskRegisterExponentMantissa(config, rx_cvt_packed_int_vec_f128(scratchpad + spAddr1 + 8 * (RegisterCountFlt + i)));
+				nreg.e[i] = maskRegisterExponentMantissa(rx_cvt_packed_int_vec_f128(scratchpad + spAddr1 + 8 * (RegisterCountFlt + i)), mantissaMask, exponentMask);
+			}
 
 			executeBytecode(bytecode, scratchpad, config);
 
@@ -86,11 +89,10 @@ namespace randomx {
 			for (unsigned i = 0; i < RegistersCount; ++i)
 				store64(scratchpad + spAddr1 + 8 * i, nreg.r[i]);
 
-			for (unsigned i = 0; i < RegisterCountFlt; ++i)
+			for (unsigned i = 0; i < RegisterCountFlt; ++i) {
 				nreg.f[i] = rx_xor_vec_f128(nreg.f[i], nreg.e[i]);
-
-			for (unsigned i = 0; i < RegisterCountFlt; ++i)
 				rx_store_vec_f128((double*)(scratchpad + spAddr0 + 16 * i), nreg.f[i]);
+			}
 
 			spAddr0 = 0;
 			spAddr1 = 0;
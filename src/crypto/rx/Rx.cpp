@@ -23,6 +23,7 @@
 #include "backend/cpu/CpuThreads.h"
 #include "crypto/rx/RxConfig.h"
 #include "crypto/rx/RxQueue.h"
+#include "crypto/rx/RxVmBench.h"
 #include "crypto/randomx/randomx.h"
 #include "crypto/randomx/aes_hash.hpp"
 
@@ -135,6 +136,7 @@ bool xmrig::Rx::init(const T &seed, const RxConfig &config, const CpuConfig &cpu
     randomx_set_scratchpad_prefetch_mode(config.scratchpadPrefetchMode());
     randomx_set_huge_pages_jit(cpu.isHugePagesJit());
     randomx_set_optimized_dataset_init(config.initDatasetAVX2());
+    RxVmBench::setEnabled(config.isVmBench());
 
     if (!osInitialized) {
 #       ifdef XMRIG_FIX_RYZEN
@@ -21,14 +21,6 @@
 #include "crypto/rx/RxAlgo.h"
 
 
-xmrig::Algorithm::Id xmrig::RxAlgo::apply(Algorithm::Id algorithm)
-{
-    randomx_apply_config(*base(algorithm));
-
-    return algorithm;
-}
-
-
 const RandomX_ConfigurationBase *xmrig::RxAlgo::base(Algorithm::Id algorithm)
 {
     switch (algorithm) {
@@ -23,7 +23,6 @@
 #include "base/io/log/Log.h"
 #include "base/io/log/Tags.h"
 #include "base/tools/Chrono.h"
-#include "crypto/rx/RxAlgo.h"
 #include "crypto/rx/RxCache.h"
 #include "crypto/rx/RxDataset.h"
 #include "crypto/rx/RxSeed.h"
@@ -51,11 +50,6 @@ public:
     inline void setSeed(const RxSeed &seed)
     {
         m_ready = false;
-
-        if (m_seed.algorithm() != seed.algorithm()) {
-            RxAlgo::apply(seed.algorithm());
-        }
-
         m_seed = seed;
     }
 
@@ -83,7 +77,7 @@ public:
     {
         const uint64_t ts = Chrono::steadyMSecs();
 
-        m_ready = m_dataset->init(m_seed.data(), threads, priority);
+        m_ready = m_dataset->init(m_seed, threads, priority);
 
         if (m_ready) {
             LOG_INFO("%s" GREEN_BOLD("dataset ready") BLACK_BOLD(" (%" PRIu64 " ms)"), Tags::randomx(), Chrono::steadyMSecs() - ts);
@@ -28,6 +28,7 @@
 #include "crypto/rx/RxCache.h"
 #include "crypto/common/VirtualMemory.h"
 #include "crypto/randomx/randomx.h"
+#include "crypto/rx/RxAlgo.h"
 
 
 static_assert(RANDOMX_FLAG_JIT == 8, "RANDOMX_FLAG_JIT flag mismatch");
@@ -55,7 +56,7 @@ xmrig::RxCache::~RxCache()
 }
 
 
-bool xmrig::RxCache::init(const Buffer &seed)
+bool xmrig::RxCache::init(const RxSeed &seed)
 {
     if (m_seed == seed) {
         return false;
@@ -64,7 +65,7 @@ bool xmrig::RxCache::init(const Buffer &seed)
     m_seed = seed;
 
     if (m_cache) {
-        randomx_init_cache(m_cache, m_seed.data(), m_seed.size());
+        randomx_init_cache(m_cache, m_seed.data().data(), m_seed.data().size(), RxAlgo::base(m_seed.algorithm()));
 
         return true;
     }
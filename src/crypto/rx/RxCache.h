@@ -31,10 +31,10 @@
 #include <cstdint>
 
 
-#include "base/tools/Buffer.h"
 #include "base/tools/Object.h"
 #include "crypto/common/HugePagesInfo.h"
 #include "crypto/randomx/configuration.h"
+#include "crypto/rx/RxSeed.h"
 
 
 struct randomx_cache;
@@ -54,11 +54,11 @@ public:
     ~RxCache();
 
     inline bool isJIT() const               { return m_jit; }
-    inline const Buffer &seed() const       { return m_seed; }
+    inline const RxSeed &seed() const       { return m_seed; }
     inline randomx_cache *get() const       { return m_cache; }
     inline size_t size() const              { return maxSize(); }
 
-    bool init(const Buffer &seed);
+    bool init(const RxSeed &seed);
     HugePagesInfo hugePages() const;
 
     static inline constexpr size_t maxSize() { return RANDOMX_CACHE_MAX_SIZE; }
@@ -67,7 +67,7 @@ private:
     void create(uint8_t *memory);
 
     bool m_jit              = true;
-    Buffer m_seed;
+    RxSeed m_seed;
     randomx_cache *m_cache  = nullptr;
     VirtualMemory *m_memory = nullptr;
 };
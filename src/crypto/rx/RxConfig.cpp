@@ -43,6 +43,7 @@ const char *RxConfig::kRdmsr                    = "rdmsr";
 const char *RxConfig::kWrmsr                    = "wrmsr";
 const char *RxConfig::kScratchpadPrefetchMode   = "scratchpad_prefetch_mode";
 const char *RxConfig::kCacheQoS                 = "cache_qos";
+const char *RxConfig::kVmBench                  = "vm-bench";
 
 #ifdef XMRIG_FEATURE_HWLOC
 const char *RxConfig::kNUMA                     = "numa";
@@ -80,6 +81,7 @@ bool xmrig::RxConfig::read(const rapidjson::Value &value)
         m_initDatasetAVX2 = Json::getInt(value, kInitAVX2, m_initDatasetAVX2);
         m_mode            = readMode(Json::getValue(value, kMode));
         m_rdmsr           = Json::getBool(value, kRdmsr, m_rdmsr);
+        m_vmBench         = Json::getBool(value, kVmBench, m_vmBench);
 
 #       ifdef XMRIG_FEATURE_MSR
         readMSR(Json::getValue(value, kWrmsr));
@@ -173,6 +175,7 @@ rapidjson::Value xmrig::RxConfig::toJSON(rapidjson::Document &doc) const
 #   endif
 
     obj.AddMember(StringRef(kScratchpadPrefetchMode), static_cast<int>(m_scratchpadPrefetchMode), allocator);
+    obj.AddMember(StringRef(kVmBench),                m_vmBench, allocator);
 
     return obj;
 }
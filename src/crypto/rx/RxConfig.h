@@ -60,6 +60,7 @@ public:
     static const char *kOneGbPages;
     static const char *kRdmsr;
     static const char *kScratchpadPrefetchMode;
+    static const char *kVmBench;
     static const char *kWrmsr;
 
 #   ifdef XMRIG_FEATURE_HWLOC
@@ -83,6 +84,7 @@ public:
     inline bool rdmsr() const           { return m_rdmsr; }
     inline bool wrmsr() const           { return m_wrmsr; }
     inline bool cacheQoS() const        { return m_cacheQoS; }
+    inline bool isVmBench() const       { return m_vmBench; }
     inline Mode mode() const            { return m_mode; }
 
     inline ScratchpadPrefetchMode scratchpadPrefetchMode() const { return m_scratchpadPrefetchMode; }
@@ -109,6 +111,7 @@ private:
 
     bool m_oneGbPages     = false;
     bool m_rdmsr          = true;
+    bool m_vmBench        = false;
     int m_threads         = -1;
     int m_initDatasetAVX2 = -1;
     Mode m_mode           = AutoMode;
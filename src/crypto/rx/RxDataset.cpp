@@ -22,12 +22,18 @@
 #include "base/io/log/Log.h"
 #include "base/io/log/Tags.h"
 #include "base/kernel/Platform.h"
+#include "base/kernel/ResourceLimits.h"
 #include "crypto/common/VirtualMemory.h"
 #include "crypto/randomx/randomx.h"
 #include "crypto/rx/RxAlgo.h"
 #include "crypto/rx/RxCache.h"
 
 
+#ifdef XMRIG_FEATURE_HANDOFF
+#   include "core/Handoff.h"
+#endif
+
+
 #include <thread>
 #include <uv.h>
 
@@ -49,6 +55,21 @@ static void init_dataset_wrapper(randomx_dataset *dataset, randomx_cache *cache,
 }
 
 
+// Fast mode needs the dataset, the cache and a scratchpad for every thread the CPU quota lets run. A dataset which
+// fits into an explicit hugetlb budget is not charged to the memory limit.
+static uint64_t requiredMemory(bool hugePages)
+{
+    uint64_t required       = RxCache::maxSize() + ResourceLimits::threads(Cpu::info()->threads()) * RANDOMX_SCRATCHPAD_L3_MAX_SIZE;
+    const uint64_t budget   = ResourceLimits::hugePages(VirtualMemory::hugePageSize());
+
+    if (!hugePages || budget == ResourceLimits::kUnlimited || budget < RxDataset::maxSize()) {
+        required += RxDataset::maxSize();
+    }
+
+    return required;
+}
+
+
 } // namespace xmrig
 
 
@@ -86,7 +107,7 @@ xmrig::RxDataset::~RxDataset()
 }
 
 
-bool xmrig::RxDataset::init(const Buffer &seed, uint32_t numThreads, int priority)
+bool xmrig::RxDataset::init(const RxSeed &seed, uint32_t numThreads, int priority)
 {
     if (!m_cache || !m_cache->get()) {
         return false;
@@ -94,11 +115,22 @@ bool xmrig::RxDataset::init(const Buffer &seed, uint32_t numThreads, int priorit
 
     m_cache->init(seed);
 
+    if (get()) {
+        randomx_dataset_set_config(m_dataset, m_cache->get());
+    }
+
+#   ifdef XMRIG_FEATURE_HANDOFF
+    // Called in light mode too, so a waiting successor is released as soon as the handed over dataset is settled.
+    if (Handoff::importDataset(seed, raw(), maxSize())) {
+        return true;
+    }
+#   endif
+
     if (!get()) {
         return true;
     }
 
-    const uint64_t datasetItemCount = randomx_dataset_item_count();
+    const uint64_t datasetItemCount = randomx_dataset_item_count(m_cache->get());
 
     if (numThreads > 1) {
         std::vector<std::thread> threads;
@@ -134,6 +166,12 @@ bool xmrig::RxDataset::isOneGbPages() const
 }
 
 
+int xmrig::RxDataset::fd() const
+{
+    return m_memory ? m_memory->fd() : -1;
+}
+
+
 xmrig::HugePagesInfo xmrig::RxDataset::hugePages(bool cache) const
 {
     auto pages = m_memory ? m_memory->hugePages() : HugePagesInfo();
@@ -184,12 +222,14 @@ void *xmrig::RxDataset::raw() const
 }
 
 
-void xmrig::RxDataset::setRaw(const void *raw)
+void xmrig::RxDataset::setRaw(const void *raw, const RxCache *cache)
 {
     if (!m_dataset) {
         return;
     }
 
+    randomx_dataset_set_config(m_dataset, cache->get());
+
     volatile size_t N = maxSize();
     memcpy(randomx_get_dataset_memory(m_dataset), raw, N);
 }
@@ -203,13 +243,20 @@ void xmrig::RxDataset::allocate(bool hugePages, bool oneGbPages)
         return;
     }
 
-    if (m_mode == RxConfig::AutoMode && uv_get_total_memory() < (maxSize() + RxCache::maxSize())) {
-        LOG_ERR(CLEAR "%s" RED_BOLD_S "not enough memory for RandomX dataset", Tags::randomx());
+    if (m_mode == RxConfig::AutoMode && ResourceLimits::memory() < requiredMemory(hugePages)) {
+        LOG_ERR(CLEAR "%s" RED_BOLD_S "not enough memory for RandomX dataset%s", Tags::randomx(), ResourceLimits::memory() < uv_get_total_memory() ? " (cgroup limit)" : "");
 
         return;
     }
 
-    m_memory  = new VirtualMemory(maxSize(), hugePages, oneGbPages, false, m_node);
+#   ifdef XMRIG_FEATURE_HANDOFF
+    // a miner started by the daemon keeps the dataset in an anonymous file, so a successor can read it directly
+    const bool shared = Handoff::isAvailable();
+#   else
+    const bool shared = false;
+#   endif
+
+    m_memory  = new VirtualMemory(maxSize(), hugePages, oneGbPages, false, m_node, 64, shared);
 
     if (m_memory->isOneGbPages()) {
         m_scratchpadOffset = maxSize() + RANDOMX_CACHE_MAX_SIZE;
@@ -38,6 +38,7 @@ namespace xmrig
 
 
 class RxCache;
+class RxSeed;
 class VirtualMemory;
 
 
@@ -54,14 +55,15 @@ public:
     inline RxCache *cache() const           { return m_cache; }
     inline void setCache(RxCache *cache)    { m_cache = cache; }
 
-    bool init(const Buffer &seed, uint32_t numThreads, int priority);
+    bool init(const RxSeed &seed, uint32_t numThreads, int priority);
     bool isHugePages() const;
     bool isOneGbPages() const;
+    int fd() const;
     HugePagesInfo hugePages(bool cache = true) const;
     size_t size(bool cache = true) const;
     uint8_t *tryAllocateScrathpad();
     void *raw() const;
-    void setRaw(const void *raw);
+    void setRaw(const void *raw, const RxCache *cache);
 
     static inline constexpr size_t maxSize() { return RANDOMX_DATASET_MAX_SIZE; }
 
@@ -23,7 +23,6 @@
 #include "base/io/log/Tags.h"
 #include "base/kernel/Platform.h"
 #include "base/tools/Chrono.h"
-#include "crypto/rx/RxAlgo.h"
 #include "crypto/rx/RxCache.h"
 #include "crypto/rx/RxDataset.h"
 #include "crypto/rx/RxSeed.h"
@@ -100,11 +99,6 @@ public:
     inline void setSeed(const RxSeed &seed)
     {
         m_ready = false;
-
-        if (m_seed.algorithm() != seed.algorithm()) {
-            RxAlgo::apply(seed.algorithm());
-        }
-
         m_seed = seed;
     }
 
@@ -175,7 +169,7 @@ public:
         }
 
         auto primary = dataset(id);
-        primary->init(m_seed.data(), threads, priority);
+        primary->init(m_seed, threads, priority);
 
         printDatasetReady(id, ts);
 
@@ -185,7 +179,7 @@ public:
                     continue;
                 }
 
-                m_threads.emplace_back(copyDataset, item.second, item.first, primary->raw());
+                m_threads.emplace_back(copyDataset, item.second, item.first, primary);
             }
 
             join();
@@ -252,11 +246,11 @@ private:
     }
 
 
-    static void copyDataset(RxDataset *dst, uint32_t nodeId, const void *raw)
+    static void copyDataset(RxDataset *dst, uint32_t nodeId, const RxDataset *src)
     {
         const uint64_t ts = Chrono::steadyMSecs();
 
-        dst->setRaw(raw);
+        dst->setRaw(src->raw(), src->cache());
 
         printDatasetReady(nodeId, ts);
     }
@@ -25,6 +25,7 @@
 #include "base/io/log/Tags.h"
 #include "base/tools/Cvt.h"
 #include "crypto/rx/RxBasicStorage.h"
+#include "crypto/rx/RxVmBench.h"
 
 
 #ifdef XMRIG_FEATURE_HWLOC
@@ -158,6 +159,16 @@ void xmrig::RxQueue::backgroundInit()
         m_seed = item.seed;
         m_state = STATE_IDLE;
         m_async->send();
+
+        // mining starts first, the dataset can't be replaced while the benchmark runs on this thread
+        if (RxVmBench::isEnabled()) {
+            lock.unlock();
+
+            Job job(false, item.seed.algorithm(), String());
+            job.setSeedHash(Cvt::toHex(item.seed.data()).data());
+
+            RxVmBench::run(item.seed.algorithm(), m_storage->dataset(job, 0));
+        }
     }
 }
 
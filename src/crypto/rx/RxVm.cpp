@@ -25,7 +25,7 @@
 #include "crypto/rx/RxVm.h"
 
 
-randomx_vm *xmrig::RxVm::create(RxDataset *dataset, uint8_t *scratchpad, bool softAes, const Assembly &assembly, uint32_t node)
+randomx_vm *xmrig::RxVm::create(RxDataset *dataset, uint8_t *scratchpad, bool softAes, const Assembly &assembly, uint32_t node, bool jit)
 {
     int flags = 0;
 
@@ -37,11 +37,11 @@ randomx_vm *xmrig::RxVm::create(RxDataset *dataset, uint8_t *scratchpad, bool so
         flags |= RANDOMX_FLAG_FULL_MEM;
     }
 
-    if (!dataset->cache() || dataset->cache()->isJIT()) {
+    if (jit && (!dataset->cache() || dataset->cache()->isJIT())) {
         flags |= RANDOMX_FLAG_JIT;
     }
 
-    const auto asmId = assembly == Assembly::AUTO ? Cpu::info()->assembly() : assembly.id();
+    const auto asmId = Cpu::assembly(assembly.id());
     if ((asmId == Assembly::RYZEN) || (asmId == Assembly::BULLDOZER)) {
         flags |= RANDOMX_FLAG_AMD;
     }
@@ -0,0 +1,148 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "crypto/rx/RxVmBench.h"
+#include "backend/cpu/Cpu.h"
+#include "base/io/log/Log.h"
+#include "base/io/log/Tags.h"
+#include "base/tools/Chrono.h"
+#include "base/crypto/Algorithm.h"
+#include "crypto/common/Assembly.h"
+#include "crypto/common/VirtualMemory.h"
+#include "crypto/randomx/randomx.h"
+#include "crypto/rx/RxCache.h"
+#include "crypto/rx/RxDataset.h"
+#include "crypto/rx/RxVm.h"
+
+
+#include <atomic>
+#include <cstring>
+
+
+namespace xmrig {
+
+
+static std::atomic<bool> enabled{ false };
+static std::atomic<bool> done{ false };
+
+constexpr uint64_t kDuration    = 2000;
+constexpr uint32_t kMinHashes   = 16;
+
+
+struct VmBenchResult
+{
+    double hashrate = 0.0;
+    uint8_t hash[32]{};
+    bool valid      = false;
+};
+
+
+static VmBenchResult measure(RxDataset *dataset, uint8_t *scratchpad, bool jit)
+{
+    VmBenchResult result;
+
+    randomx_vm *vm = RxVm::create(dataset, scratchpad, !Cpu::info()->hasAES(), Assembly::AUTO, 0, jit);
+    if (!vm) {
+        return result;
+    }
+
+    alignas(16) uint8_t blob[76]{};
+    uint8_t hash[32];
+    uint32_t nonce  = 0;
+    uint32_t count  = 0;
+
+    const uint64_t start = Chrono::highResolutionMicroSecs();
+    uint64_t elapsed     = 0;
+
+    do {
+        memcpy(blob + 39, &nonce, sizeof(nonce));
+        randomx_calculate_hash(vm, blob, sizeof(blob), hash);
+
+        if (nonce++ == 0) {
+            memcpy(result.hash, hash, sizeof(hash));
+        }
+
+        ++count;
+        elapsed = Chrono::highResolutionMicroSecs() - start;
+    } while (count < kMinHashes || elapsed < kDuration * 1000);
+
+    RxVm::destroy(vm);
+
+    result.hashrate = count * 1e6 / static_cast<double>(elapsed);
+    result.valid    = true;
+
+    return result;
+}
+
+
+} // namespace xmrig
+
+
+bool xmrig::RxVmBench::isEnabled()
+{
+    return enabled && !done;
+}
+
+
+void xmrig::RxVmBench::run(const Algorithm &algorithm, RxDataset *dataset)
+{
+    if (!dataset || done.exchange(true)) {
+        return;
+    }
+
+    VirtualMemory scratchpad(algorithm.l3(), false, false, false);
+
+    const auto interpreter = measure(dataset, scratchpad.scratchpad(), false);
+
+    // RxVm::create() silently falls back to the interpreter when the cache was not JIT compiled
+    if (dataset->cache() && !dataset->cache()->isJIT()) {
+        if (interpreter.valid) {
+            LOG_INFO("%s" MAGENTA_BOLD("vm-bench") " interpreter " CYAN_BOLD("%.1f H/s") YELLOW(" JIT unavailable"), Tags::randomx(), interpreter.hashrate);
+        }
+        else {
+            LOG_ERR("%s" RED("vm-bench failed to create VM"), Tags::randomx());
+        }
+
+        return;
+    }
+
+    const auto jit = measure(dataset, scratchpad.scratchpad(), true);
+
+    if (!interpreter.valid || !jit.valid) {
+        LOG_ERR("%s" RED("vm-bench failed to create VM"), Tags::randomx());
+
+        return;
+    }
+
+    if (memcmp(interpreter.hash, jit.hash, sizeof(jit.hash)) != 0) {
+        LOG_ERR("%s" RED_BOLD("vm-bench interpreter and JIT hashes differ"), Tags::randomx());
+    }
+
+    LOG_INFO("%s" MAGENTA_BOLD("vm-bench") " interpreter " CYAN_BOLD("%.1f H/s") " JIT " CYAN_BOLD("%.1f H/s") BLACK_BOLD(" (interpreter at %.1f%%)"),
+             Tags::randomx(),
+             interpreter.hashrate,
+             jit.hashrate,
+             jit.hashrate > 0.0 ? interpreter.hashrate * 100.0 / jit.hashrate : 0.0
+             );
+}
+
+
+void xmrig::RxVmBench::setEnabled(bool value)
+{
+    enabled = value;
+}
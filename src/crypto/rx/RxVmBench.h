@@ -0,0 +1,48 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_RX_VMBENCH_H
+#define XMRIG_RX_VMBENCH_H
+
+
+namespace xmrig
+{
+
+
+class Algorithm;
+class RxDataset;
+
+
+/**
+ * One-shot comparison of the RandomX bytecode interpreter and the JIT compiler on the current dataset,
+ * enabled by the "vm-bench" option. Runs on the dataset init thread once the first dataset is ready and the miner
+ * was notified, so it never delays mining.
+ */
+class RxVmBench
+{
+public:
+    static bool isEnabled();
+    static void run(const Algorithm &algorithm, RxDataset *dataset);
+    static void setEnabled(bool enabled);
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_RX_VMBENCH_H */
@@ -0,0 +1,210 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "hw/energy/EnergyMeter.h"
+#include "base/io/log/Log.h"
+#include "base/tools/Chrono.h"
+
+
+#include <cstdio>
+#include <cstring>
+#include <dirent.h>
+#include <fstream>
+#include <string>
+
+
+namespace xmrig {
+
+
+static const char *kHwmonPath       = "/sys/class/hwmon";
+static const char *kPowercapPath    = "/sys/class/powercap";
+
+
+static bool readValue(const std::string &path, uint64_t &value)
+{
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    return static_cast<bool>(file >> value);
+}
+
+
+static std::string readLine(const std::string &path)
+{
+    std::ifstream file(path);
+    std::string line;
+
+    if (file.is_open()) {
+        std::getline(file, line);
+    }
+
+    return line;
+}
+
+
+template<typename Callback>
+static void listDir(const char *path, Callback callback)
+{
+    DIR *dir = opendir(path);
+    if (!dir) {
+        return;
+    }
+
+    while (dirent *entry = readdir(dir)) {
+        if (entry->d_name[0] != '.') {
+            callback(std::string(entry->d_name));
+        }
+    }
+
+    closedir(dir);
+}
+
+
+} // namespace xmrig
+
+
+xmrig::EnergyMeter::EnergyMeter()
+{
+    scanPowercap();
+
+    if (m_domains.empty()) {
+        scanHwmon();
+    }
+}
+
+
+const char *xmrig::EnergyMeter::tag()
+{
+    static const char *tag = GREEN_BG_BOLD(WHITE_BOLD_S " energy ");
+
+    return tag;
+}
+
+
+xmrig::EnergyMeter::Sample xmrig::EnergyMeter::read()
+{
+    Sample sample;
+    sample.ts = Chrono::steadyMSecs();
+
+    for (Domain &domain : m_domains) {
+        uint64_t value = 0;
+        if (readValue(domain.path.data(), value)) {
+            uint64_t delta = value - domain.last;
+            if (value < domain.last) {
+                delta = domain.maxRange ? (domain.maxRange - domain.last + value) : 0;
+            }
+
+            domain.total += static_cast<double>(delta) * domain.scale;
+            domain.last   = value;
+        }
+
+        (domain.core ? sample.core : sample.package) += domain.total;
+    }
+
+    return sample;
+}
+
+
+bool xmrig::EnergyMeter::addDomain(const String &path, bool core, double scale, uint64_t maxRange)
+{
+    Domain domain;
+    domain.path     = path;
+    domain.core     = core;
+    domain.scale    = scale;
+    domain.maxRange = maxRange;
+
+    // not readable without root on kernels with the CVE-2020-8694 fix
+    if (!readValue(path.data(), domain.last)) {
+        return false;
+    }
+
+    m_domains.push_back(std::move(domain));
+
+    if (!core) {
+        m_packages++;
+    }
+
+    return true;
+}
+
+
+void xmrig::EnergyMeter::scanHwmon()
+{
+    listDir(kHwmonPath, [this](const std::string &name) {
+        const std::string base = std::string(kHwmonPath) + "/" + name + "/";
+        if (readLine(base + "name") != "amd_energy") {
+            return;
+        }
+
+        for (uint32_t i = 1; i < 1024; ++i) {
+            const std::string label = readLine(base + "energy" + std::to_string(i) + "_label");
+            if (label.empty()) {
+                break;
+            }
+
+            const bool socket = label.compare(0, 7, "Esocket") == 0;
+            if (socket || label.compare(0, 5, "Ecore") == 0) {
+                addDomain((base + "energy" + std::to_string(i) + "_input").c_str(), !socket, 1e-6, 0);
+            }
+        }
+    });
+
+    if (!m_domains.empty()) {
+        m_source = "amd_energy";
+    }
+}
+
+
+void xmrig::EnergyMeter::scanPowercap()
+{
+    listDir(kPowercapPath, [this](const std::string &zone) {
+        // top level zones only, "intel-rapl:0" but not "intel-rapl:0:0"
+        if (zone.compare(0, 11, "intel-rapl:") != 0 || zone.find(':', 11) != std::string::npos) {
+            return;
+        }
+
+        const std::string base = std::string(kPowercapPath) + "/" + zone + "/";
+        if (readLine(base + "name").compare(0, 7, "package") != 0) {
+            return;
+        }
+
+        uint64_t range = 0;
+        readValue(base + "max_energy_range_uj", range);
+
+        if (!addDomain((base + "energy_uj").c_str(), false, 1e-6, range)) {
+            return;
+        }
+
+        listDir(base.c_str(), [this, &base](const std::string &sub) {
+            if (sub.compare(0, 11, "intel-rapl:") != 0 || readLine(base + sub + "/name") != "core") {
+                return;
+            }
+
+            uint64_t range = 0;
+            readValue(base + sub + "/max_energy_range_uj", range);
+
+            addDomain((base + sub + "/energy_uj").c_str(), true, 1e-6, range);
+        });
+    });
+
+    if (!m_domains.empty()) {
+        m_source = "rapl";
+    }
+}
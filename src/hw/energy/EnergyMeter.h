@@ -0,0 +1,86 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_ENERGYMETER_H
+#define XMRIG_ENERGYMETER_H
+
+
+#include "base/tools/Object.h"
+#include "base/tools/String.h"
+
+
+#include <vector>
+
+
+namespace xmrig {
+
+
+/**
+ * Reads cumulative CPU energy counters on Linux.
+ *
+ * RAPL domains are taken from the powercap framework (/sys/class/powercap/intel-rapl:*, also used by AMD Zen since
+ * Linux 5.8), the amd_energy hwmon driver is used as a fallback. Counter wraparound is handled on every read.
+ */
+class EnergyMeter
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE(EnergyMeter)
+
+    struct Sample
+    {
+        double package  = 0.0;  // joules, sum of all packages
+        double core     = 0.0;  // joules, sum of all core domains, 0 if not available
+        uint64_t ts     = 0;    // steady clock ms
+    };
+
+    EnergyMeter();
+    ~EnergyMeter() = default;
+
+    static const char *tag();
+
+    inline bool isAvailable() const    { return !m_domains.empty(); }
+    inline size_t packages() const     { return m_packages; }
+    inline const char *source() const  { return m_source; }
+
+    Sample read();
+
+private:
+    struct Domain
+    {
+        String path;
+        bool core           = false;
+        double scale        = 1e-6;
+        uint64_t maxRange   = 0;
+        uint64_t last       = 0;
+        double total        = 0.0;
+    };
+
+    bool addDomain(const String &path, bool core, double scale, uint64_t maxRange);
+    void scanHwmon();
+    void scanPowercap();
+
+    const char *m_source = "none";
+    size_t m_packages    = 0;
+    std::vector<Domain> m_domains;
+};
+
+
+} // namespace xmrig
+
+
+#endif /* XMRIG_ENERGYMETER_H */
@@ -0,0 +1,19 @@
+if (WITH_ENERGY AND XMRIG_OS_LINUX)
+    set(WITH_ENERGY ON)
+else()
+    set(WITH_ENERGY OFF)
+endif()
+
+if (WITH_ENERGY)
+    add_definitions(/DXMRIG_FEATURE_ENERGY)
+
+    list(APPEND HEADERS
+        src/hw/energy/EnergyMeter.h
+        )
+
+    list(APPEND SOURCES
+        src/hw/energy/EnergyMeter.cpp
+        )
+else()
+    remove_definitions(/DXMRIG_FEATURE_ENERGY)
+endif()
@@ -0,0 +1,252 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "hw/thermal/ThermalMeter.h"
+#include "base/io/log/Log.h"
+
+
+#include <algorithm>
+#include <cstring>
+#include <dirent.h>
+#include <fstream>
+#include <string>
+
+
+namespace xmrig {
+
+
+static const char *kHwmonPath       = "/class/hwmon";
+static const char *kThermalPath     = "/class/thermal";
+
+
+static bool readValue(const std::string &path, int64_t &value)
+{
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    return static_cast<bool>(file >> value);
+}
+
+
+static std::string readLine(const std::string &path)
+{
+    std::ifstream file(path);
+    std::string line;
+
+    if (file.is_open()) {
+        std::getline(file, line);
+    }
+
+    return line;
+}
+
+
+// entries sorted in natural order, so hwmon2 comes before hwmon10
+static std::vector<std::string> listDir(const std::string &path, const char *prefix)
+{
+    std::vector<std::string> out;
+
+    DIR *dir = opendir(path.c_str());
+    if (!dir) {
+        return out;
+    }
+
+    const size_t size = strlen(prefix);
+
+    while (dirent *entry = readdir(dir)) {
+        if (strncmp(entry->d_name, prefix, size) == 0) {
+            out.emplace_back(entry->d_name);
+        }
+    }
+
+    closedir(dir);
+
+    std::sort(out.begin(), out.end(), [](const std::string &a, const std::string &b) {
+        return a.size() != b.size() ? a.size() < b.size() : a < b;
+    });
+
+    return out;
+}
+
+
+static int labelNumber(const std::string &label, const char *prefix)
+{
+    const size_t size = strlen(prefix);
+    if (label.compare(0, size, prefix) != 0 || label.size() == size) {
+        return -1;
+    }
+
+    return static_cast<int>(strtol(label.c_str() + size, nullptr, 10));
+}
+
+
+} // namespace xmrig
+
+
+xmrig::ThermalMeter::ThermalMeter(const String &root) :
+    m_root(root.isEmpty() ? "/sys" : root.data())
+{
+    if (m_root.size() > 1 && m_root.back() == '/') {
+        m_root.pop_back();
+    }
+
+    scanHwmon();
+
+    if (m_sensors.empty()) {
+        scanThermal();
+    }
+}
+
+
+const char *xmrig::ThermalMeter::tag()
+{
+    static const char *tag = RED_BG_BOLD(WHITE_BOLD_S " thermal ");
+
+    return tag;
+}
+
+
+void xmrig::ThermalMeter::read()
+{
+    for (Sensor &sensor : m_sensors) {
+        int64_t value = 0;
+        sensor.temperature = readValue(sensor.path.data(), value) ? static_cast<double>(value) / 1000.0 : 0.0;
+    }
+}
+
+
+bool xmrig::ThermalMeter::addSensor(const std::string &path, const std::string &name, Kind kind, int package, int index)
+{
+    int64_t value = 0;
+    if (!readValue(path, value)) {
+        return false;
+    }
+
+    Sensor sensor;
+    sensor.path         = path.c_str();
+    sensor.name         = name.c_str();
+    sensor.kind         = kind;
+    sensor.package      = package;
+    sensor.index        = index;
+    sensor.temperature  = static_cast<double>(value) / 1000.0;
+
+    m_sensors.push_back(std::move(sensor));
+
+    return true;
+}
+
+
+void xmrig::ThermalMeter::scanHwmon()
+{
+    const std::string path = m_root + kHwmonPath;
+    int intel = 0;
+    int amd   = 0;
+
+    for (const auto &dir : listDir(path, "hwmon")) {
+        const std::string base   = path + "/" + dir + "/";
+        const std::string driver = readLine(base + "name");
+
+        if (driver == "coretemp") {
+            // one hwmon device per package, inputs are sparse: temp1 is the package, cores follow with gaps
+            int package = intel++;
+
+            for (uint32_t i = 1; i < 512; ++i) {
+                const int id = labelNumber(readLine(base + "temp" + std::to_string(i) + "_label"), "Package id ");
+                if (id >= 0) {
+                    package = id;
+                    break;
+                }
+            }
+
+            for (uint32_t i = 1; i < 512; ++i) {
+                const std::string input = base + "temp" + std::to_string(i) + "_input";
+                const std::string label = readLine(base + "temp" + std::to_string(i) + "_label");
+                const int core          = labelNumber(label, "Core ");
+
+                if (core >= 0) {
+                    addSensor(input, label, Core, package, core);
+                }
+                else if (labelNumber(label, "Package id ") >= 0) {
+                    addSensor(input, label, Package, package, -1);
+                }
+            }
+
+            m_source = "coretemp";
+        }
+        else if (driver == "k10temp" || driver == "zenpower") {
+            const int package = amd++;
+            std::string tctl;
+            bool die = false;
+
+            for (uint32_t i = 1; i < 32; ++i) {
+                const std::string input = base + "temp" + std::to_string(i) + "_input";
+                const std::string label = readLine(base + "temp" + std::to_string(i) + "_label");
+                const int ccd           = labelNumber(label, "Tccd");
+
+                if (ccd > 0) {
+                    addSensor(input, label, Ccd, package, ccd - 1);
+                }
+                else if (label == "Tdie") {
+                    die = addSensor(input, label, Package, package, -1) || die;
+                }
+                else if (label == "Tctl") {
+                    tctl = input;
+                }
+            }
+
+            // Tctl may include a fan control offset on older parts, only used when Tdie is missing
+            if (!die && !tctl.empty()) {
+                addSensor(tctl, "Tctl", Package, package, -1);
+            }
+
+            m_source = driver == "k10temp" ? "k10temp" : "zenpower";
+        }
+    }
+}
+
+
+void xmrig::ThermalMeter::scanThermal()
+{
+    const std::string path = m_root + kThermalPath;
+    std::vector<std::string> fallback;
+    int package = 0;
+
+    for (const auto &zone : listDir(path, "thermal_zone")) {
+        const std::string base = path + "/" + zone + "/";
+        const std::string type = readLine(base + "type");
+
+        if (type == "x86_pkg_temp") {
+            addSensor(base + "temp", type, Package, package++, -1);
+        }
+        else if (type == "acpitz" || type.find("cpu") != std::string::npos || type.find("soc") != std::string::npos) {
+            fallback.push_back(base);
+        }
+    }
+
+    if (m_sensors.empty()) {
+        for (const auto &base : fallback) {
+            addSensor(base + "temp", readLine(base + "type"), Package, -1, -1);
+        }
+    }
+
+    if (!m_sensors.empty()) {
+        m_source = "thermal_zone";
+    }
+}
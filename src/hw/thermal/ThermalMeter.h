@@ -0,0 +1,86 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_THERMALMETER_H
+#define XMRIG_THERMALMETER_H
+
+
+#include "base/tools/Object.h"
+#include "base/tools/String.h"
+
+
+#include <string>
+#include <vector>
+
+
+namespace xmrig {
+
+
+/**
+ * Reads CPU temperatures on Linux.
+ *
+ * Per core sensors come from the coretemp hwmon driver, per CCD and package sensors from k10temp/zenpower. Thermal
+ * zones (x86_pkg_temp, acpitz, SoC zones on ARM) are used as a package level fallback. The sysfs root is configurable,
+ * so the meter can be pointed at a copy of the tree.
+ */
+class ThermalMeter
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(ThermalMeter)
+
+    enum Kind {
+        Core,
+        Ccd,
+        Package
+    };
+
+    struct Sensor
+    {
+        String path;
+        String name;
+        Kind kind           = Package;
+        int package         = -1;   // physical package id, -1 if the sensor covers all packages
+        int index           = -1;   // core id for Core, zero based CCD number for Ccd
+        double temperature  = 0.0;  // degrees Celsius, 0 if the last read failed
+    };
+
+    explicit ThermalMeter(const String &root);
+
+    static const char *tag();
+
+    inline bool isAvailable() const                     { return !m_sensors.empty(); }
+    inline const char *source() const                   { return m_source; }
+    inline const std::vector<Sensor> &sensors() const   { return m_sensors; }
+
+    void read();
+
+private:
+    bool addSensor(const std::string &path, const std::string &name, Kind kind, int package, int index);
+    void scanHwmon();
+    void scanThermal();
+
+    const char *m_source = "none";
+    std::string m_root;
+    std::vector<Sensor> m_sensors;
+};
+
+
+} // namespace xmrig
+
+
+#endif /* XMRIG_THERMALMETER_H */
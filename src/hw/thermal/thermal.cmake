@@ -0,0 +1,19 @@
+if (WITH_THERMAL AND XMRIG_OS_LINUX)
+    set(WITH_THERMAL ON)
+else()
+    set(WITH_THERMAL OFF)
+endif()
+
+if (WITH_THERMAL)
+    add_definitions(/DXMRIG_FEATURE_THERMAL)
+
+    list(APPEND HEADERS
+        src/hw/thermal/ThermalMeter.h
+        )
+
+    list(APPEND SOURCES
+        src/hw/thermal/ThermalMeter.cpp
+        )
+else()
+    remove_definitions(/DXMRIG_FEATURE_THERMAL)
+endif()
@@ -79,6 +79,22 @@ public:
     {
     }
 
+    inline JobResult(const JobResult &result, const String &clientId) :
+        algorithm(result.algorithm),
+        index(result.index),
+        clientId(clientId),
+        jobId(result.jobId),
+        backend(result.backend),
+        nonce(result.nonce),
+        diff(result.diff),
+        m_hasMinerSignature(result.m_hasMinerSignature)
+    {
+        memcpy(m_result, result.m_result, sizeof(m_result));
+        memcpy(m_headerHash, result.m_headerHash, sizeof(m_headerHash));
+        memcpy(m_mixHash, result.m_mixHash, sizeof(m_mixHash));
+        memcpy(m_minerSignature, result.m_minerSignature, sizeof(m_minerSignature));
+    }
+
     inline const uint8_t *result() const     { return m_result; }
     inline uint64_t actualDiff() const       { return Job::toDiff(reinterpret_cast<const uint64_t*>(m_result)[3]); }
     inline uint8_t *result()                 { return m_result; }
@@ -29,6 +29,7 @@
 #include "base/io/log/Log.h"
 #include "base/kernel/interfaces/IAsyncListener.h"
 #include "base/tools/Object.h"
+#include "crypto/common/portable/mm_malloc.h"
 #include "net/interfaces/IJobResultListener.h"
 #include "net/JobResult.h"
 
@@ -55,10 +56,14 @@
 #endif
 
 
+#include <atomic>
 #include <cassert>
+#include <cinttypes>
 #include <list>
+#include <map>
 #include <memory>
 #include <mutex>
+#include <new>
 #include <uv.h>
 
 
@@ -100,15 +105,53 @@ public:
 };
 
 
-static inline void checkHash(const JobBundle &bundle, std::vector<JobResult> &results, uint32_t nonce, uint8_t hash[32], uint32_t &errors)
+struct DeviceErrors
 {
-    if (*reinterpret_cast<uint64_t*>(hash + 24) < bundle.job.target()) {
-        results.emplace_back(bundle.job, nonce, hash);
+    uint64_t total  = 0;
+    uint64_t errors = 0;
+};
+
+
+static std::map<std::pair<uint32_t, uint32_t>, DeviceErrors> deviceErrors;
+static std::mutex deviceErrorsMutex;
+
+
+// Every nonce reported by a GPU is re-hashed on the CPU, keep a per device error rate to tell
+// a single glitch from an unstable overclock.
+static bool verifyHash(const JobBundle &bundle, const uint8_t *hash, uint32_t &errors)
+{
+    const bool valid = *reinterpret_cast<const uint64_t*>(hash + 24) < bundle.job.submitTarget();
+    DeviceErrors stats;
+
+    {
+        std::lock_guard<std::mutex> lock(deviceErrorsMutex);
+
+        auto &device = deviceErrors[{ bundle.job.backend(), bundle.device_index }];
+        device.total++;
+
+        if (!valid) {
+            device.errors++;
+        }
+
+        stats = device;
     }
-    else {
-        LOG_ERR("%s " RED_S "GPU #%u COMPUTE ERROR", backend_tag(bundle.job.backend()), bundle.device_index);
+
+    if (!valid) {
+        LOG_ERR("%s " RED_S "GPU #%u COMPUTE ERROR" RED(" (%" PRIu64 "/%" PRIu64 ", %.2f%%)"),
+                backend_tag(bundle.job.backend()), bundle.device_index, stats.errors, stats.total, static_cast<double>(stats.errors) / stats.total * 100.0);
+
         errors++;
     }
+
+    return valid;
+}
+
+
+static inline void checkHash(const JobBundle &bundle, std::vector<JobResult> &results, uint32_t nonce, uint8_t hash[32], uint32_t &errors)
+{
+    if (verifyHash(bundle, hash, errors)) {
+        results.emplace_back(bundle.job, nonce, hash);
+    }
 }
 
 
@@ -167,13 +210,9 @@ static void getResults(JobBundle &bundle, std::vector<JobResult> &results, uint3
                 hash[i] = ((uint8_t*)output)[sizeof(hash) - 1 - i];
             }
 
-            if (*reinterpret_cast<uint64_t*>(hash + 24) < bundle.job.target()) {
+            if (verifyHash(bundle, hash, errors)) {
                 results.emplace_back(bundle.job, full_nonce, (uint8_t*)output, bundle.job.blob(), (uint8_t*)mix_hash);
             }
-            else {
-                LOG_ERR("%s " RED_S "GPU #%u COMPUTE ERROR", backend_tag(bundle.job.backend()), bundle.device_index);
-                ++errors;
-            }
         }
 #       endif
     }
@@ -208,7 +247,16 @@ public:
     }
 
 
-    ~JobResultsPrivate() override = default;
+    ~JobResultsPrivate() override
+    {
+        for (auto &shard : m_shards) {
+            Shard *queue = shard.load();
+            if (queue) {
+                queue->~Shard();
+                _mm_free(queue);
+            }
+        }
+    }
 
 
     inline void submit(const JobResult &result)
@@ -220,6 +268,17 @@ public:
     }
 
 
+    inline void submit(const JobResult &result, uint32_t shard)
+    {
+        Shard &queue = this->shard(shard % kMaxShards);
+
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.results.push_back(result);
+
+        m_async->send();
+    }
+
+
 #   if defined(XMRIG_FEATURE_OPENCL) || defined(XMRIG_FEATURE_CUDA)
     inline void submit(const Job &job, uint32_t *results, size_t count, uint32_t device_index)
     {
@@ -236,6 +295,53 @@ protected:
 
 
 private:
+    constexpr static size_t kMaxShards = 8;
+
+
+    // Per NUMA node queues, so threads of different nodes don't contend on the same lock.
+    struct alignas(64) Shard
+    {
+        std::list<JobResult> results;
+        std::mutex mutex;
+    };
+
+
+    // Created by the first thread submitting to it, CPU workers are bound to their node at that point,
+    // so the queue lives in the memory of the node that uses it.
+    inline Shard &shard(size_t index)
+    {
+        Shard *queue = m_shards[index].load(std::memory_order_acquire);
+        if (queue) {
+            return *queue;
+        }
+
+        // plain operator new ignores the cache line alignment in C++11
+        Shard *created = new (_mm_malloc(sizeof(Shard), alignof(Shard))) Shard();
+        if (m_shards[index].compare_exchange_strong(queue, created, std::memory_order_acq_rel)) {
+            return *created;
+        }
+
+        created->~Shard();
+        _mm_free(created);
+
+        return *queue;
+    }
+
+
+    inline void takeShards(std::list<JobResult> &results)
+    {
+        for (auto &shard : m_shards) {
+            Shard *queue = shard.load(std::memory_order_acquire);
+            if (!queue) {
+                continue;
+            }
+
+            std::lock_guard<std::mutex> lock(queue->mutex);
+            results.splice(results.end(), queue->results);
+        }
+    }
+
+
 #   if defined(XMRIG_FEATURE_OPENCL) || defined(XMRIG_FEATURE_CUDA)
     inline void submit()
     {
@@ -247,6 +353,8 @@ private:
         m_results.swap(results);
         m_mutex.unlock();
 
+        takeShards(results);
+
         for (const auto &result : results) {
             m_listener->onJobResult(result);
         }
@@ -285,6 +393,8 @@ private:
         m_results.swap(results);
         m_mutex.unlock();
 
+        takeShards(results);
+
         for (const auto &result : results) {
             m_listener->onJobResult(result);
         }
@@ -296,6 +406,7 @@ private:
     std::list<JobResult> m_results;
     std::mutex m_mutex;
     std::shared_ptr<Async> m_async;
+    std::atomic<Shard *> m_shards[kMaxShards]{};
 
 #   if defined(XMRIG_FEATURE_OPENCL) || defined(XMRIG_FEATURE_CUDA)
     std::list<JobBundle> m_bundles;
@@ -355,6 +466,16 @@ void xmrig::JobResults::submit(const JobResult &result)
 }
 
 
+void xmrig::JobResults::submit(const JobResult &result, uint32_t shard)
+{
+    assert(handler != nullptr);
+
+    if (handler) {
+        handler->submit(result, shard);
+    }
+}
+
+
 #if defined(XMRIG_FEATURE_OPENCL) || defined(XMRIG_FEATURE_CUDA)
 void xmrig::JobResults::submit(const Job &job, uint32_t *results, size_t count, uint32_t device_index)
 {
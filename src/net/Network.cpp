@@ -36,6 +36,7 @@
 #include "core/Miner.h"
 #include "net/JobResult.h"
 #include "net/JobResults.h"
+#include "net/ShareBuffer.h"
 #include "net/strategies/DonateStrategy.h"
 
 
@@ -69,7 +70,8 @@ xmrig::Network::Network(Controller *controller) :
     controller->ccClient()->addClientStatusListener(this);
 #   endif
 
-    m_state = new NetworkState(this);
+    m_state  = new NetworkState(this);
+    m_shares = new ShareBuffer();
 
     const Pools &pools = controller->config()->pools();
     m_strategy = pools.createStrategy(m_state);
@@ -90,6 +92,7 @@ xmrig::Network::~Network()
     delete m_donate;
     delete m_strategy;
     delete m_state;
+    delete m_shares;
 }
 
 
@@ -176,7 +179,10 @@ void xmrig::Network::onJobResult(const JobResult &result)
         return;
     }
 
-    m_strategy->submit(result);
+    // results of a lost connection are kept for pools with "share-buffer"
+    if (m_strategy->submit(result) < 0 && m_shares->add(result) && m_strategy->isActive()) {
+        m_shares->flush(m_strategy);
+    }
 }
 
 
@@ -217,6 +223,12 @@ void xmrig::Network::onPause(IStrategy *strategy)
     }
 
     if (!m_strategy->isActive()) {
+        if (m_donate != strategy && m_shares->start(Chrono::steadyMSecs())) {
+            LOG_WARN("%s " YELLOW("no active pools, keep mining the last job and buffer up to %zu shares"), Tags::network(), m_shares->limit());
+
+            return;
+        }
+
         LOG_ERR("%s " RED("no active pools, stop mining"), Tags::network());
 
         return m_controller->miner()->pause();
@@ -293,6 +305,22 @@ void xmrig::Network::setJob(IClient *client, const Job &job, bool donate)
         static_cast<DonateStrategy *>(m_donate)->update(client, job);
     }
 
+    if (!donate) {
+        m_shares->setJob(client, job);
+        m_shares->flush(m_strategy);
+    }
+
+    // a local submit difficulty above the pool one drops low difficulty shares already on the device,
+    // they are never re-hashed by the CPU or sent to the pool
+    if (client->pool().submitDiff() > job.diff()) {
+        Job copy(job);
+        copy.setSubmitDiff(client->pool().submitDiff());
+
+        m_controller->miner()->setJob(copy, donate);
+
+        return;
+    }
+
     m_controller->miner()->setJob(job, donate);
 }
 
@@ -303,6 +331,13 @@ void xmrig::Network::tick()
 
     m_strategy->tick(now);
 
+    if (m_shares->isExpired(now)) {
+        m_shares->stop();
+
+        LOG_ERR("%s " RED("no active pools, stop mining"), Tags::network());
+        m_controller->miner()->pause();
+    }
+
     if (m_donate) {
         m_donate->tick(now);
     }
@@ -329,7 +364,10 @@ void xmrig::Network::getResults(rapidjson::Value &reply, rapidjson::Document &do
     using namespace rapidjson;
     auto &allocator = doc.GetAllocator();
 
-    reply.AddMember("results", m_state->getResults(doc, version), allocator);
+    Value results = m_state->getResults(doc, version);
+    results.AddMember("share_buffer", m_shares->toJSON(doc), allocator);
+
+    reply.AddMember("results", results, allocator);
 }
 #endif
 
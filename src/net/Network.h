@@ -40,6 +40,7 @@ namespace xmrig {
 class Controller;
 class IStrategy;
 class NetworkState;
+class ShareBuffer;
 
 
 class Network : public IJobResultListener, public IStrategyListener, public IBaseListener, public ITimerListener, public IApiListener, public IClientStatusListener
@@ -90,6 +91,7 @@ private:
     IStrategy *m_donate     = nullptr;
     IStrategy *m_strategy   = nullptr;
     NetworkState *m_state   = nullptr;
+    ShareBuffer *m_shares   = nullptr;
     Timer *m_timer          = nullptr;
 };
 
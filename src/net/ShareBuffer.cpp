@@ -0,0 +1,193 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "net/ShareBuffer.h"
+#include "3rdparty/rapidjson/document.h"
+#include "base/io/log/Log.h"
+#include "base/io/log/Tags.h"
+#include "base/kernel/interfaces/IClient.h"
+#include "base/kernel/interfaces/IStrategy.h"
+#include "base/net/stratum/Pool.h"
+
+
+#include <algorithm>
+
+
+bool xmrig::ShareBuffer::add(const JobResult &result)
+{
+    if (result.diff == 0) {
+        return false;
+    }
+
+    Queue *queue = find(result);
+    if (!queue || queue->limit == 0) {
+        return false;
+    }
+
+    if (queue->shares.size() >= queue->limit) {
+        m_dropped++;
+
+        return false;
+    }
+
+    queue->shares.emplace_back(result);
+    m_buffered++;
+
+    return true;
+}
+
+
+bool xmrig::ShareBuffer::isExpired(uint64_t now) const
+{
+    if (!m_outage) {
+        return false;
+    }
+
+    const Queue *queue = current();
+
+    return now - m_outage >= kMaxOutage || !queue || queue->shares.size() >= queue->limit;
+}
+
+
+bool xmrig::ShareBuffer::start(uint64_t now)
+{
+    const Queue *queue = current();
+    if (!queue || queue->limit == 0 || queue->jobs.empty()) {
+        return false;
+    }
+
+    if (!m_outage) {
+        m_outage = now;
+    }
+
+    return true;
+}
+
+
+rapidjson::Value xmrig::ShareBuffer::toJSON(rapidjson::Document &doc) const
+{
+    using namespace rapidjson;
+    auto &allocator = doc.GetAllocator();
+
+    Value out(kObjectType);
+    out.AddMember("limit",          static_cast<uint64_t>(limit()), allocator);
+    out.AddMember("pending",        static_cast<uint64_t>(size()), allocator);
+    out.AddMember("buffered",       m_buffered, allocator);
+    out.AddMember("resubmitted",    m_resubmitted, allocator);
+    out.AddMember("dropped",        m_dropped, allocator);
+
+    return out;
+}
+
+
+size_t xmrig::ShareBuffer::limit() const
+{
+    const Queue *queue = current();
+
+    return queue ? queue->limit : 0;
+}
+
+
+size_t xmrig::ShareBuffer::size() const
+{
+    size_t size = 0;
+
+    for (const auto &kv : m_pools) {
+        size += kv.second.shares.size();
+    }
+
+    return size;
+}
+
+
+void xmrig::ShareBuffer::flush(IStrategy *strategy)
+{
+    auto it = m_pools.find(m_pool);
+    if (it == m_pools.end() || it->second.shares.empty() || it->second.jobs.empty()) {
+        return;
+    }
+
+    Queue &queue          = it->second;
+    const String clientId = queue.jobs.back().clientId;
+    size_t resubmitted    = 0;
+
+    // job ids are only valid within the session which issued them, so a share can only be resubmitted if the new
+    // session sent the same job again
+    for (const auto &share : queue.shares) {
+        const bool valid = std::any_of(queue.jobs.begin(), queue.jobs.end(), [&share, &clientId](const JobInfo &job) {
+            return job.clientId == clientId && job.id == share.jobId;
+        });
+
+        if (valid && strategy->submit(JobResult(share, clientId)) >= 0) {
+            ++resubmitted;
+        }
+    }
+
+    const size_t dropped = queue.shares.size() - resubmitted;
+
+    m_resubmitted += resubmitted;
+    m_dropped     += dropped;
+    queue.shares.clear();
+
+    LOG_INFO("%s " WHITE_BOLD("buffered shares: ") GREEN_BOLD("%zu resubmitted") ", %s%zu dropped" CLEAR, Tags::network(), resubmitted, dropped ? RED_BOLD_S : "", dropped);
+}
+
+
+void xmrig::ShareBuffer::setJob(const IClient *client, const Job &job)
+{
+    const auto &pool = client->pool();
+    Queue &queue     = m_pools[pool.url()];
+
+    m_pool       = pool.url();
+    m_outage     = 0;
+    queue.limit  = pool.shareBuffer();
+
+    queue.jobs.emplace_back(job);
+
+    if (queue.jobs.size() > kMaxJobs) {
+        queue.jobs.pop_front();
+    }
+}
+
+
+void xmrig::ShareBuffer::stop()
+{
+    m_outage = 0;
+}
+
+
+xmrig::ShareBuffer::Queue *xmrig::ShareBuffer::find(const JobResult &result)
+{
+    for (auto &kv : m_pools) {
+        for (const auto &job : kv.second.jobs) {
+            if (job.clientId == result.clientId && job.id == result.jobId) {
+                return &kv.second;
+            }
+        }
+    }
+
+    return nullptr;
+}
+
+
+const xmrig::ShareBuffer::Queue *xmrig::ShareBuffer::current() const
+{
+    const auto it = m_pools.find(m_pool);
+
+    return it != m_pools.end() ? &it->second : nullptr;
+}
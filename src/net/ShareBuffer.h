@@ -0,0 +1,101 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_SHAREBUFFER_H
+#define XMRIG_SHAREBUFFER_H
+
+
+#include "3rdparty/rapidjson/fwd.h"
+#include "base/tools/Object.h"
+#include "base/tools/String.h"
+#include "net/JobResult.h"
+
+
+#include <deque>
+#include <map>
+#include <vector>
+
+
+namespace xmrig {
+
+
+class IClient;
+class IStrategy;
+
+
+/**
+ * Keeps shares which could not be submitted because the pool connection was lost, for pools with "share-buffer".
+ *
+ * Mining continues on the last job during the outage. After the reconnect a buffered share is submitted again with
+ * the new session id only if the new session issued a job with the same job id; other shares are dropped and
+ * counted. Jobs and shares are kept per pool, so switching between pools does not discard them.
+ */
+class ShareBuffer
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE(ShareBuffer)
+
+    constexpr static uint64_t kMaxOutage    = 60 * 1000;
+    constexpr static size_t kMaxJobs        = 4;
+
+    ShareBuffer() = default;
+
+    inline bool isOutage() const            { return m_outage > 0; }
+
+    bool add(const JobResult &result);
+    bool isExpired(uint64_t now) const;
+    bool start(uint64_t now);
+    rapidjson::Value toJSON(rapidjson::Document &doc) const;
+    size_t limit() const;
+    size_t size() const;
+    void flush(IStrategy *strategy);
+    void setJob(const IClient *client, const Job &job);
+    void stop();
+
+private:
+    struct JobInfo
+    {
+        inline JobInfo(const Job &job) : clientId(job.clientId()), id(job.id()) {}
+
+        String clientId;
+        String id;
+    };
+
+    struct Queue
+    {
+        size_t limit = 0;
+        std::deque<JobInfo> jobs;
+        std::vector<JobResult> shares;
+    };
+
+    Queue *find(const JobResult &result);
+    const Queue *current() const;
+
+    std::map<String, Queue> m_pools;
+    String m_pool;
+    uint64_t m_buffered     = 0;
+    uint64_t m_dropped      = 0;
+    uint64_t m_outage       = 0;
+    uint64_t m_resubmitted  = 0;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_SHAREBUFFER_H */
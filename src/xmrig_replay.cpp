@@ -0,0 +1,74 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "base/io/log/backends/ConsoleLog.h"
+#include "base/io/log/Log.h"
+#include "base/net/stratum/ReplayServer.h"
+#include "version.h"
+
+
+#include <cxxopts/cxxopts.hpp>
+#include <iostream>
+#include <uv.h>
+
+
+int main(int argc, char **argv)
+{
+    using namespace xmrig;
+
+    cxxopts::Options options(argv[0], APP_NAME " stratum replay " APP_VERSION);
+    options.positional_help("FILE");
+
+    options.add_options()
+        ("f, file", "Session recorded with the \"stratum-record\" option", cxxopts::value<std::string>())
+        ("H, host", "Address to listen on", cxxopts::value<std::string>()->default_value("127.0.0.1"))
+        ("p, port", "Port to listen on", cxxopts::value<int>()->default_value("3333"), "N")
+        ("c, client", "Id of the recorded pool connection, 0 is the first pool", cxxopts::value<int>()->default_value("0"), "N")
+        ("s, speed", "Playback speed multiplier", cxxopts::value<double>()->default_value("1.0"), "X")
+        ("h, help", "Print this help");
+
+    options.parse_positional({ "file" });
+
+    try {
+        auto result = options.parse(argc, argv);
+        if (result.count("help") || !result.count("file")) {
+            std::cout << options.help({ "" }) << std::endl;
+
+            return result.count("help") ? 0 : 1;
+        }
+
+        Log::init();
+        Log::add(new ConsoleLog());
+
+        ReplayServer server(result["client"].as<int>(), result["speed"].as<double>());
+        if (!server.load(result["file"].as<std::string>().c_str()) || server.bind(result["host"].as<std::string>().c_str(), static_cast<uint16_t>(result["port"].as<int>())) < 0) {
+            return 1;
+        }
+
+        uv_run(uv_default_loop(), UV_RUN_DEFAULT);
+    }
+    catch (const cxxopts::OptionException &e) {
+        std::cout << "error parsing options: " << e.what() << std::endl;
+
+        return 1;
+    }
+
+    Log::destroy();
+
+    return 0;
+}